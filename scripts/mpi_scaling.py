@@ -0,0 +1,39 @@
+#!/usr/bin/env python3
+
+"""
+PINK scaling table of the data-parallel MPI training
+"""
+
+__author__ = "Bernd Doser"
+__email__ = "bernd.doser@h-its.org"
+__license__ = "GPLv3"
+
+import argparse
+import re
+import subprocess
+
+def main():
+
+    parser = argparse.ArgumentParser(description='PINK scaling table of the data-parallel MPI training')
+    parser.add_argument('images', help='Binary data file for the training')
+    parser.add_argument('--pink', default='Pink', help='Pink executable compiled with USE_MPI (default = Pink)')
+    parser.add_argument('--mpirun', default='mpirun', help='MPI launcher (default = mpirun)')
+    parser.add_argument('--processes', type=int, nargs='+', default=[1, 2, 4], help='Numbers of processes (default = 1 2 4)')
+    parser.add_argument('--pink-args', default='--cuda-off', help='Additional Pink arguments (default = --cuda-off)')
+    args = parser.parse_args()
+
+    print('{:>10} {:>16} {:>10} {:>12}'.format('processes', 'images/s', 'speed-up', 'efficiency'))
+
+    reference = None
+    for np in args.processes:
+        command = [args.mpirun, '-np', str(np), args.pink] + args.pink_args.split() + \
+                  ['--verbose', '--train', args.images, 'mpi_scaling_som.bin']
+        output = subprocess.run(command, check=True, stdout=subprocess.PIPE, universal_newlines=True).stdout
+        throughput = float(re.search(r'Training throughput = ([0-9.eE+-]+)', output).group(1))
+        if reference is None:
+            reference = throughput / args.processes[0]
+        speedup = throughput / reference
+        print('{:>10} {:>16.1f} {:>10.2f} {:>12.2f}'.format(np, throughput, speedup, speedup / np))
+
+if __name__ == "__main__":
+    main()
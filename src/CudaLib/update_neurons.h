@@ -30,16 +30,19 @@ void find_best_matching_neuron_kernel(T const *euclidean_distance_matrix,
     }
 }
 
-/// CUDA Kernel Device code updating quadratic self organizing map using gaussian function.
+/// CUDA Kernel Device code updating the self organizing map.
+/// The update factors are read from the offset table of NeighborhoodTable,
+/// the best match is read from device memory.
 template <unsigned int block_size, typename T>
 __global__
 void update_neurons_kernel(T *som, T const *rotated_images, uint32_t const *best_rotation_matrix,
-    uint32_t best_match, float const *update_factors, uint32_t som_size, uint32_t neuron_size)
+    uint32_t const *best_match, float const *update_factors, uint32_t const *table_positions,
+    uint32_t table_center, uint32_t neuron_size)
 {
     int i = blockDim.x * blockIdx.x + threadIdx.x;
     if (i >= neuron_size) return;
 
-    float factor = update_factors[best_match * som_size + blockIdx.y];
+    float factor = update_factors[table_center + table_positions[blockIdx.y] - table_positions[*best_match]];
     int pos = blockIdx.y * neuron_size + i;
 
     if (factor != 0.0)
@@ -50,6 +53,7 @@ void update_neurons_kernel(T *som, T const *rotated_images, uint32_t const *best
 
 /**
  * Host function that prepares data array and passes it to the CUDA kernel.
+ * The update factors and table positions are the ones of NeighborhoodTable.
  */
 template <typename T>
 void update_neurons(thrust::device_vector<T>& d_som, thrust::device_vector<T> const& d_rotated_images,
@@ -57,6 +61,7 @@ void update_neurons(thrust::device_vector<T>& d_som, thrust::device_vector<T> co
     thrust::device_vector<T> const& d_euclidean_distance_matrix,
     thrust::device_vector<uint32_t>& d_best_match,
     thrust::device_vector<float> const& d_update_factors,
+    thrust::device_vector<uint32_t> const& d_table_positions, uint32_t table_center,
     uint32_t som_size, uint32_t neuron_size)
 {
     {
@@ -77,7 +82,8 @@ void update_neurons(thrust::device_vector<T>& d_som, thrust::device_vector<T> co
         // Start kernel
         update_neurons_kernel<block_size><<<dim_grid, dim_block>>>(thrust::raw_pointer_cast(&d_som[0]),
             thrust::raw_pointer_cast(&d_rotated_images[0]), thrust::raw_pointer_cast(&d_best_rotation_matrix[0]),
-            d_best_match[0], thrust::raw_pointer_cast(&d_update_factors[0]), som_size, neuron_size);
+            thrust::raw_pointer_cast(&d_best_match[0]), thrust::raw_pointer_cast(&d_update_factors[0]),
+            thrust::raw_pointer_cast(&d_table_positions[0]), table_center, neuron_size);
 
         gpuErrchk(cudaPeekAtLastError());
         gpuErrchk(cudaDeviceSynchronize());
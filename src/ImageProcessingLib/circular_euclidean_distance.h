@@ -70,6 +70,7 @@ struct CircularEuclideanDistanceFunctor<CartesianLayout<3>>
         T ed = 0;
 
         auto depth = data_layout.get_dimension(0);
+        auto stride = data_layout.get_stride(0);
         auto dim = data_layout.get_dimension(1);
         auto center = dim / 2;
         auto radius = euclidean_distance_dim / 2;
@@ -79,7 +80,7 @@ struct CircularEuclideanDistanceFunctor<CartesianLayout<3>>
                 auto delta = std::sqrt(2 * radius * (i + 0.5) - std::pow((i + 0.5), 2));
                 uint32_t global_i = i + (dim - euclidean_distance_dim) / 2;
                 for (uint32_t j = std::round(center - delta); j < std::round(center + delta); ++j) {
-                    ed += std::pow(a[global_i * dim + j] - b[global_i * dim + j], 2);
+                    ed += std::pow(a[d * stride + global_i * dim + j] - b[d * stride + global_i * dim + j], 2);
                 }
             }
         }
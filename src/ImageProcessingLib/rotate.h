@@ -66,6 +66,77 @@ void rotate_bilinear(T const* src, T *dst, uint32_t src_height, uint32_t src_wid
     }
 }
 
+/// Rotate an image with channels interleaved in the source ([pixel][channel]) and
+/// stored channel after channel in the destination ([channel][pixel]).
+/// The source position, bounds check and the bilinear weights are calculated only once
+/// for each destination pixel and one gather of the neighboring pixels serves all channels.
+template <typename T>
+void rotate_bilinear_channels(T const* src, T *dst, uint32_t src_height, uint32_t src_width,
+    uint32_t dst_height, uint32_t dst_width, float alpha, uint32_t number_of_channels)
+{
+    const float cos_alpha = std::cos(alpha);
+    const float sin_alpha = std::sin(alpha);
+
+    // Center of src image
+    const float src_center_x = (src_width - 1) * 0.5f;
+    const float src_center_y = (src_height - 1) * 0.5f;
+
+    // Center of dst image
+    const float dst_center_x = (dst_width - 1) * 0.5f;
+    const float dst_center_y = (dst_height - 1) * 0.5f;
+
+    const uint32_t dst_size = dst_height * dst_width;
+
+    for (uint32_t dst_x = 0; dst_x < dst_width; ++dst_x) {
+        for (uint32_t dst_y = 0; dst_y < dst_height; ++dst_y) {
+
+            T *current_dst = dst + dst_x * dst_height + dst_y;
+
+            float dst_position_x = static_cast<float>(dst_x) - dst_center_x;
+            float dst_position_y = static_cast<float>(dst_y) - dst_center_y;
+
+            float src_position_x = dst_position_x * cos_alpha - dst_position_y * sin_alpha + src_center_x;
+            float src_position_y = dst_position_x * sin_alpha + dst_position_y * cos_alpha + src_center_y;
+
+            if (src_position_x < 0.0f or src_position_x > src_width - 1 or
+                src_position_y < 0.0f or src_position_y > src_height - 1)
+            {
+                for (uint32_t c = 0; c < number_of_channels; ++c) current_dst[c * dst_size] = 0.0;
+            }
+            else
+            {
+                uint32_t src_x = static_cast<uint32_t>(src_position_x);
+                uint32_t src_y = static_cast<uint32_t>(src_position_y);
+
+                uint32_t src_x_plus_1 = src_x + 1;
+                uint32_t src_y_plus_1 = src_y + 1;
+
+                float rx = src_position_x - src_x;
+                float ry = src_position_y - src_y;
+
+                float cx = 1.0f - rx;
+                float cy = 1.0f - ry;
+
+                // Same operation order as rotate_bilinear to get identical results
+                float w00 = cx * cy;
+                float w01 = cx * ry;
+                float w10 = rx * cy;
+                float w11 = rx * ry;
+
+                T const *src00 = src + (src_x * src_height + src_y) * number_of_channels;
+                T const *src01 = src + (src_x * src_height + src_y_plus_1) * number_of_channels;
+                T const *src10 = src + (src_x_plus_1 * src_height + src_y) * number_of_channels;
+                T const *src11 = src + (src_x_plus_1 * src_height + src_y_plus_1) * number_of_channels;
+
+                for (uint32_t c = 0; c < number_of_channels; ++c) {
+                    current_dst[c * dst_size] = static_cast<T>(
+                        w00 * src00[c] + w01 * src01[c] + w10 * src10[c] + w11 * src11[c]);
+                }
+            }
+        }
+    }
+}
+
 template <typename T>
 void rotate(T const* src, T *dst, uint32_t src_height, uint32_t src_width,
     uint32_t dst_height, uint32_t dst_width, float alpha, Interpolation interpolation)
@@ -82,4 +153,24 @@ void rotate(T const* src, T *dst, uint32_t src_height, uint32_t src_width,
     }
 }
 
+/// Rotate multi-channel image, see rotate_bilinear_channels for the memory layout
+template <typename T>
+void rotate_channels(T const* src, T *dst, uint32_t src_height, uint32_t src_width,
+    uint32_t dst_height, uint32_t dst_width, float alpha, uint32_t number_of_channels,
+    Interpolation interpolation)
+{
+    assert(src_height > 0);
+    assert(src_width > 0);
+    assert(dst_height > 0);
+    assert(dst_width > 0);
+    assert(number_of_channels > 0);
+
+    if (interpolation == Interpolation::BILINEAR)
+        rotate_bilinear_channels(src, dst, src_height, src_width, dst_height, dst_width, alpha,
+            number_of_channels);
+    else {
+        throw pink::exception("rotate_channels: unknown interpolation\n");
+    }
+}
+
 } // namespace pink
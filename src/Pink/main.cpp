@@ -23,11 +23,46 @@
     #include "CudaLib/main_gpu.h"
 #endif
 
+#ifdef PINK_USE_MPI
+    #include <mpi.h>
+#endif
+
 using myclock = std::chrono::steady_clock;
 using namespace pink;
 
+namespace {
+
+/// Output buffer of std::cout, which is switched off for all MPI processes except the first one
+std::streambuf *cout_buffer = std::cout.rdbuf();
+
+/// Print error message of an aborted program
+std::ostream& error_output()
+{
+    std::cout.rdbuf(cout_buffer);
+    return std::cout;
+}
+
+/// Return value of an aborted program
+int exit_with_error()
+{
+#ifdef PINK_USE_MPI
+    // The other processes would wait forever for the aborted one
+    MPI_Abort(MPI_COMM_WORLD, 1);
+#endif
+    return 1;
+}
+
+} // namespace
+
 int main(int argc, char **argv)
 {
+#ifdef PINK_USE_MPI
+    MPI_Init(&argc, &argv);
+    int rank = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    if (rank != 0) std::cout.rdbuf(nullptr);
+#endif
+
     try {
         #ifndef NDEBUG
             feenableexcept(FE_INVALID | FE_OVERFLOW);
@@ -62,19 +97,23 @@ int main(int argc, char **argv)
              << "     (" << std::chrono::duration_cast<std::chrono::seconds>(duration).count() << " s)" << std::endl;
 
     } catch ( pink::exception const& e ) {
-        std::cout << "PINK exception: " << e.what() << std::endl;
-        std::cout << "Program was aborted." << std::endl;
-        return 1;
+        error_output() << "PINK exception: " << e.what() << std::endl;
+        error_output() << "Program was aborted." << std::endl;
+        return exit_with_error();
     } catch ( std::exception const& e ) {
-        std::cout << "Standard exception: " << e.what() << std::endl;
-        std::cout << "Program was aborted." << std::endl;
-        return 1;
+        error_output() << "Standard exception: " << e.what() << std::endl;
+        error_output() << "Program was aborted." << std::endl;
+        return exit_with_error();
     } catch ( ... ) {
-        std::cout << "Unknown exception." << std::endl;
-        std::cout << "Program was aborted." << std::endl;
-        return 1;
+        error_output() << "Unknown exception." << std::endl;
+        error_output() << "Program was aborted." << std::endl;
+        return exit_with_error();
     }
 
     std::cout << "\n  Successfully finished. Have a nice day.\n" << std::endl;
+
+#ifdef PINK_USE_MPI
+    MPI_Finalize();
+#endif
     return 0;
 }
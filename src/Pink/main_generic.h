@@ -5,24 +5,355 @@
  * @author Bernd Doser, HITS gGmbH
  */
 
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <omp.h>
+#include <optional>
+#include <vector>
 
+#include "SelfOrganizingMapLib/Checkpoint.h"
+#include "SelfOrganizingMapLib/ConvergenceStatistics.h"
 #include "SelfOrganizingMapLib/Data.h"
 #include "SelfOrganizingMapLib/DataIO.h"
 #include "SelfOrganizingMapLib/DataIterator.h"
 #include "SelfOrganizingMapLib/DataIteratorShuffled.h"
+#include "SelfOrganizingMapLib/DataParallelSynchronizer.h"
 #include "SelfOrganizingMapLib/FileIO.h"
 #include "SelfOrganizingMapLib/Mapper.h"
+#include "SelfOrganizingMapLib/MappingWriter.h"
+#include "SelfOrganizingMapLib/ModelParallelTrainer.h"
+#include "SelfOrganizingMapLib/SnapshotWriter.h"
 #include "SelfOrganizingMapLib/SOM.h"
+#include "SelfOrganizingMapLib/SweepTrainer.h"
 #include "SelfOrganizingMapLib/Trainer.h"
 #include "UtilitiesLib/DistributionFunction.h"
 #include "UtilitiesLib/DistributionFunctor.h"
+#include "UtilitiesLib/get_static_array.h"
 #include "UtilitiesLib/InputData.h"
 #include "UtilitiesLib/pink_exception.h"
 #include "UtilitiesLib/ProgressBar.h"
 
 namespace pink {
 
+/// Neighborhood of the given iteration for the decay schedule (--decay)
+template <typename TrainerType>
+void set_decayed_neighborhood(TrainerType& trainer, InputData const& input_data, uint32_t iteration)
+{
+    if (input_data.m_decay_type == DecayType::OFF) return;
+
+    auto sigma = get_decayed_value(input_data.m_decay_type, input_data.m_sigma,
+        input_data.m_final_sigma, iteration, input_data.m_number_of_iterations);
+    auto damping = get_decayed_value(input_data.m_decay_type, input_data.m_damping,
+        input_data.m_final_damping, iteration, input_data.m_number_of_iterations);
+
+    auto max_update_distance = get_decayed_max_update_distance(input_data.m_decay_type,
+        input_data.m_max_update_distance, input_data.m_final_max_update_distance, trainer.get_max_distance(),
+        iteration, input_data.m_number_of_iterations);
+
+    trainer.set_neighborhood(input_data.get_distribution_function(sigma, damping), max_update_distance);
+
+    if (input_data.m_verbose) {
+        std::cout << "  Iteration " << iteration << ": sigma = " << sigma << ", damping factor = " << damping
+                  << ", maximum update distance = " << max_update_distance << std::endl;
+    }
+}
+
+/// Convergence statistics are collected for printing, logging and early stopping
+inline bool needs_convergence_statistics(InputData const& input_data)
+{
+    return input_data.m_verbose or !input_data.m_statistics_filename.empty() or
+           input_data.m_early_stopping_churn >= 0.0f or input_data.m_early_stopping_quantization_error_change >= 0.0f;
+}
+
+inline void open_statistics_file(std::ofstream& os, InputData const& input_data)
+{
+    os.open(input_data.m_statistics_filename);
+    if (!os) throw pink::exception("Error opening " + input_data.m_statistics_filename);
+    os << "# iteration mean_quantization_error best_match_churn update_entropy" << std::endl;
+}
+
+/// Print and log the statistics of an iteration, returns true if the training has converged
+inline bool report_convergence(IterationStatistics const& previous, IterationStatistics const& current,
+    uint32_t iteration, InputData const& input_data, std::ofstream& statistics_file)
+{
+    if (input_data.m_verbose) std::cout << "  Iteration " << iteration << ": " << current << std::endl;
+    if (statistics_file.is_open()) {
+        statistics_file << iteration << " " << current.mean_quantization_error << " "
+                        << current.best_match_churn << " " << current.update_entropy << std::endl;
+    }
+
+    bool converged = is_converged(previous, current, input_data.m_early_stopping_churn,
+        input_data.m_early_stopping_quantization_error_change);
+    if (converged) std::cout << "  Training converged after iteration " << iteration << std::endl;
+    return converged;
+}
+
+/// Input data of a multi-resolution training stage (--stages), the final stage is the SOM given by input_data.
+/// Each stage but the first is initialized by the upsampled SOM of the previous stage.
+inline InputData get_stage_input_data(InputData const& input_data, size_t index)
+{
+    InputData stage_input_data = input_data;
+    stage_input_data.m_stages.clear();
+
+    if (index < input_data.m_stages.size()) {
+        auto&& stage = input_data.m_stages[index];
+        stage_input_data.m_som_width = stage.m_som_width;
+        stage_input_data.m_som_height = stage.m_som_height;
+        stage_input_data.m_som_depth = stage.m_som_depth;
+        stage_input_data.m_number_of_iterations = stage.m_number_of_iterations;
+        stage_input_data.m_som_size = input_data.m_layout == Layout::HEXAGONAL ?
+            static_cast<uint32_t>(HexagonalLayout({stage.m_som_width, stage.m_som_height}).size()) :
+            stage.m_som_width * stage.m_som_height * stage.m_som_depth;
+        stage_input_data.m_som_total_size = stage_input_data.m_som_size * input_data.m_neuron_size;
+        stage_input_data.m_result_filename = get_stage_filename(input_data.m_result_filename, index);
+        stage_input_data.m_intermediate_storage = IntermediateStorageType::OFF;
+        stage_input_data.m_statistics_filename.clear();
+    }
+
+    // Only the final SOM is mapped
+    if (index < input_data.m_stages.size()) stage_input_data.m_last_iteration_mapping_filename.clear();
+
+    if (index != 0) {
+        stage_input_data.m_init = SOMInitialization::FILEINIT;
+        stage_input_data.m_som_filename = get_stage_filename(input_data.m_result_filename, index - 1);
+    }
+
+    return stage_input_data;
+}
+
+/// Training with the neurons distributed across the MPI processes (--model-parallel)
+template <typename SOMLayout, typename DataLayout, typename T>
+void train_model_parallel(InputData const& input_data)
+{
+    ModelParallelTrainer<SOMLayout, DataLayout, T> trainer(
+        SOMLayout{extract_layout<SOMLayout::dimensionality>(input_data.m_som_width,
+            input_data.m_som_height, input_data.m_som_depth)}
+        ,DataLayout{get_static_array<DataLayout::dimensionality>(input_data.m_neuron_dimension)}
+        ,input_data.get_distribution_function()
+        ,input_data.m_verbose
+        ,input_data.m_number_of_rotations
+        ,input_data.m_use_flip
+        ,input_data.m_max_update_distance
+        ,input_data.m_interpolation
+        ,input_data.m_euclidean_distance_dim
+        ,input_data.m_euclidean_distance_shape
+        ,input_data.m_transformation_layout
+    );
+    trainer.initialize(input_data);
+
+    if (input_data.m_verbose) {
+        std::cout << "  Neurons of process 0 = [" << trainer.get_begin() << ", " << trainer.get_end() << ")"
+                  << " of " << trainer.get_number_of_ranks() << " processes" << std::endl;
+    }
+
+    // Only rank 0 reads the data, all other processes receive the images by the trainer
+    std::ifstream ifs;
+    if (trainer.get_rank() == 0) {
+        ifs.open(input_data.m_data_filename);
+        if (!ifs) throw std::runtime_error("Error opening " + input_data.m_data_filename);
+    }
+    Data<DataLayout, T> data(DataLayout{get_static_array<DataLayout::dimensionality>(input_data.m_data_dimension)});
+
+    ProgressBar progress_bar(static_cast<int>(input_data.m_number_of_data_entries * input_data.m_number_of_iterations),
+        70, input_data.m_max_number_of_progress_prints);
+
+    // All processes know the best matches, only rank 0 writes the log file
+    std::ofstream statistics_file;
+    IterationStatistics previous_statistics;
+    if (needs_convergence_statistics(input_data)) {
+        trainer.enable_statistics(input_data.m_number_of_data_entries);
+        if (trainer.get_rank() == 0 and !input_data.m_statistics_filename.empty()) {
+            open_statistics_file(statistics_file, input_data);
+        }
+    }
+
+    uint32_t count = 0;
+    uint32_t number_of_trained_iterations = 0;
+    auto&& start_time = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < input_data.m_number_of_iterations; ++i)
+    {
+        std::unique_ptr<DataIteratorShuffled<DataLayout, T>> iter_data;
+        if (trainer.get_rank() == 0) {
+            iter_data = std::make_unique<DataIteratorShuffled<DataLayout, T>>(ifs,
+                static_cast<uint64_t>(input_data.m_seed) + i, input_data.m_shuffle_data_input);
+        }
+
+        set_decayed_neighborhood(trainer, input_data, i);
+        ++number_of_trained_iterations;
+
+        for (uint32_t position = 0; position < input_data.m_number_of_data_entries; ++position, ++progress_bar)
+        {
+            uint32_t index = 0;
+            if (iter_data) {
+                data = **iter_data;
+                index = iter_data->get_index();
+                ++*iter_data;
+            }
+            trainer(data, index);
+
+            if (progress_bar.valid() and input_data.m_intermediate_storage != IntermediateStorageType::OFF) {
+                std::string interStore_filename = input_data.m_result_filename;
+                if (input_data.m_intermediate_storage == IntermediateStorageType::KEEP) {
+                    interStore_filename.insert(interStore_filename.find_last_of("."),
+                        "_" + std::to_string(count++));
+                }
+                if (input_data.m_verbose) std::cout << "  Write intermediate SOM to " << interStore_filename << std::endl;
+                trainer.write(interStore_filename);
+            }
+        }
+
+        if (trainer.has_statistics()) {
+            auto&& iteration_statistics = trainer.get_statistics().finish_iteration();
+            bool converged = report_convergence(previous_statistics, iteration_statistics, i, input_data, statistics_file);
+            previous_statistics = iteration_statistics;
+            if (converged) break;
+        }
+    }
+
+    if (input_data.m_verbose) {
+        std::chrono::duration<double> training_time = std::chrono::steady_clock::now() - start_time;
+        std::cout << "  Training throughput = "
+                  << input_data.m_number_of_data_entries * number_of_trained_iterations / training_time.count()
+                  << " images/s with " << input_data.m_number_of_threads << " threads and "
+                  << trainer.get_number_of_ranks() << " processes" << std::endl;
+    }
+
+    std::cout << "  Write final SOM to " << input_data.m_result_filename << " ... " << std::flush;
+    trainer.write(input_data.m_result_filename);
+    std::cout << "done." << std::endl;
+
+    if (input_data.m_verbose) {
+        std::cout << "\n  Number of updates of each neuron:\n\n"
+                  << trainer.get_update_info()
+                  << std::endl;
+    }
+}
+
+/// Input data of a SOM of the hyper-parameter sweep (--sweep)
+inline InputData get_sweep_input_data(InputData const& input_data, size_t index)
+{
+    InputData sweep_input_data = input_data;
+    sweep_input_data.m_sweep.clear();
+
+    auto&& variant = input_data.m_sweep[index];
+    sweep_input_data.m_sigma = variant.m_sigma.value_or(input_data.m_sigma);
+    sweep_input_data.m_damping = variant.m_damping.value_or(input_data.m_damping);
+    sweep_input_data.m_seed = variant.m_seed.value_or(input_data.m_seed);
+    sweep_input_data.m_som_width = variant.m_som_width.value_or(input_data.m_som_width);
+    sweep_input_data.m_som_height = variant.m_som_height.value_or(input_data.m_som_height);
+    sweep_input_data.m_som_depth = variant.m_som_depth.value_or(input_data.m_som_depth);
+    sweep_input_data.m_som_size = input_data.m_layout == Layout::HEXAGONAL ?
+        static_cast<uint32_t>(HexagonalLayout({sweep_input_data.m_som_width, sweep_input_data.m_som_height}).size()) :
+        sweep_input_data.m_som_width * sweep_input_data.m_som_height * sweep_input_data.m_som_depth;
+    sweep_input_data.m_som_total_size = sweep_input_data.m_som_size * input_data.m_neuron_size;
+    sweep_input_data.m_result_filename = get_sweep_filename(input_data.m_result_filename, index);
+
+    return sweep_input_data;
+}
+
+/// Hyper-parameter sweep (--sweep): the spatial transformations of each image are generated once
+/// and train all SOMs of the sweep in parallel. The image order is the same for all SOMs.
+template <typename SOMLayout, typename DataLayout, typename T>
+void train_sweep(InputData const& input_data)
+{
+    typedef SOM<SOMLayout, DataLayout, T> SOMType;
+    typedef Trainer<SOMLayout, DataLayout, T, false> TrainerType;
+
+#ifdef PINK_USE_MPI
+    int number_of_ranks = 1;
+    MPI_Comm_size(MPI_COMM_WORLD, &number_of_ranks);
+    if (number_of_ranks > 1) throw pink::exception("Sweep can not be combined with data-parallel training.");
+#endif
+
+    // The trainers keep references to the SOMs, which must not be moved
+    std::vector<InputData> sweep_input_data;
+    std::deque<SOMType> soms;
+    std::deque<TrainerType> trainers;
+    std::vector<TrainerType*> trainer_pointers;
+
+    for (size_t n = 0; n < input_data.m_sweep.size(); ++n)
+    {
+        sweep_input_data.push_back(get_sweep_input_data(input_data, n));
+        auto&& som_input_data = sweep_input_data.back();
+
+        soms.emplace_back(som_input_data);
+        trainers.emplace_back(
+            soms.back()
+            ,som_input_data.get_distribution_function()
+            ,som_input_data.m_verbose
+            ,som_input_data.m_number_of_rotations
+            ,som_input_data.m_use_flip
+            ,som_input_data.m_max_update_distance
+            ,som_input_data.m_interpolation
+            ,som_input_data.m_euclidean_distance_dim
+            ,som_input_data.m_euclidean_distance_shape
+            ,som_input_data.m_transformation_layout
+        );
+
+        auto&& trainer = trainers.back();
+        if (input_data.m_best_match_cache_radius > 0.0f) {
+            trainer.enable_best_match_cache(input_data.m_number_of_data_entries,
+                input_data.m_best_match_cache_radius, input_data.m_best_match_cache_max_distance_increase);
+        }
+        if (input_data.m_two_phase_search) trainer.enable_two_phase_search();
+        if (input_data.m_verbose) trainer.enable_statistics(input_data.m_number_of_data_entries);
+        trainer_pointers.push_back(&trainer);
+    }
+
+    SweepTrainer<SOMLayout, DataLayout, T> sweep_trainer(trainer_pointers);
+
+    std::ifstream ifs(input_data.m_data_filename);
+    if (!ifs) throw std::runtime_error("Error opening " + input_data.m_data_filename);
+
+    ProgressBar progress_bar(static_cast<int>(input_data.m_number_of_data_entries * input_data.m_number_of_iterations),
+        70, input_data.m_max_number_of_progress_prints);
+
+    auto&& start_time = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < input_data.m_number_of_iterations; ++i)
+    {
+        auto&& iter_data_cur = DataIteratorShuffled<DataLayout, T>(ifs,
+            static_cast<uint64_t>(input_data.m_seed) + i, input_data.m_shuffle_data_input);
+        auto&& iter_data_end = DataIteratorShuffled<DataLayout, T>(ifs, true);
+
+        for (size_t n = 0; n < trainers.size(); ++n) set_decayed_neighborhood(trainers[n], sweep_input_data[n], i);
+
+        for (; iter_data_cur != iter_data_end; ++iter_data_cur, ++progress_bar) {
+            sweep_trainer(*iter_data_cur, iter_data_cur.get_index());
+        }
+
+        for (size_t n = 0; n < trainers.size(); ++n) {
+            if (trainers[n].has_best_match_cache()) {
+                auto&& cache = trainers[n].get_best_match_cache();
+                std::cout << "  SOM " << n << ", iteration " << i << ": best match cache hit rate = "
+                          << cache.get_hit_rate() << std::endl;
+                cache.reset_counters();
+            }
+            if (trainers[n].has_statistics()) {
+                std::cout << "  SOM " << n << ", iteration " << i << ": "
+                          << trainers[n].get_statistics().finish_iteration() << std::endl;
+            }
+        }
+    }
+
+    if (input_data.m_verbose) {
+        std::chrono::duration<double> training_time = std::chrono::steady_clock::now() - start_time;
+        std::cout << "  Training throughput = "
+                  << input_data.m_number_of_data_entries * input_data.m_number_of_iterations / training_time.count()
+                  << " images/s for " << trainers.size() << " SOMs with " << input_data.m_number_of_threads
+                  << " threads" << std::endl;
+    }
+
+    for (size_t n = 0; n < soms.size(); ++n) {
+        std::cout << "  Write final SOM to " << sweep_input_data[n].m_result_filename << " ... " << std::flush;
+        write(soms[n], sweep_input_data[n].m_result_filename);
+        std::cout << "done." << std::endl;
+    }
+}
+
 template <typename SOMLayout, typename T, bool UseGPU>
 void main_generic(InputData const& input_data)
 {
@@ -49,6 +380,34 @@ void main_generic(InputData const& input_data)
                   << "<" << static_cast<int>(DataLayout::dimensionality) << ">" << "\n"
                   << std::endl;
 
+    // Multi-resolution training: train the coarse SOMs of the stages one after another
+    if (input_data.m_executionPath == ExecutionPath::TRAIN and !input_data.m_stages.empty()) {
+        for (size_t i = 0; i <= input_data.m_stages.size(); ++i) {
+            auto&& stage_input_data = get_stage_input_data(input_data, i);
+            std::cout << "  Training stage " << i << ": SOM dimension = " << stage_input_data.m_som_width << "x"
+                      << stage_input_data.m_som_height << "x" << stage_input_data.m_som_depth
+                      << ", number of iterations = " << stage_input_data.m_number_of_iterations << "\n" << std::endl;
+            main_generic<SOMLayout, DataLayout, T, UseGPU>(stage_input_data);
+#ifdef PINK_USE_MPI
+            // The SOM of the stage must be written before all processes read it
+            MPI_Barrier(MPI_COMM_WORLD);
+#endif
+        }
+        return;
+    }
+
+    // The SOM is not allocated as a whole, InputData ensures a CPU training
+    if constexpr (!UseGPU) {
+        if (input_data.m_executionPath == ExecutionPath::TRAIN and !input_data.m_sweep.empty()) {
+            train_sweep<SOMLayout, DataLayout, T>(input_data);
+            return;
+        }
+        if (input_data.m_model_parallel and input_data.m_executionPath == ExecutionPath::TRAIN) {
+            train_model_parallel<SOMLayout, DataLayout, T>(input_data);
+            return;
+        }
+    }
+
     SOM<SOMLayout, DataLayout, T> som(input_data);
 
     std::ifstream ifs(input_data.m_data_filename);
@@ -56,6 +415,46 @@ void main_generic(InputData const& input_data)
 
     if (input_data.m_executionPath == ExecutionPath::TRAIN)
     {
+        // The SOM must be restored before the trainer is created, which copies it to the GPU
+        Checkpoint checkpoint(input_data);
+        Data<SOMLayout, uint32_t> update_info(som.get_som_layout(), 0);
+        if (input_data.m_resume) {
+            auto&& stored_checkpoint = read_checkpoint(input_data.m_checkpoint_filename, som, update_info);
+            if (!stored_checkpoint.has_same_parameters(checkpoint)) {
+                throw pink::exception("Training parameters differ from checkpoint " + input_data.m_checkpoint_filename);
+            }
+            checkpoint = stored_checkpoint;
+            std::cout << "  Resume training at iteration " << checkpoint.iteration
+                      << " and position " << checkpoint.position << std::endl;
+        }
+
+        // Data-parallel training with MPI: each process trains its replica with its own shard of the data
+        DataParallelSynchronizer<SOMLayout, DataLayout, T> synchronizer(som);
+        auto rank = static_cast<uint32_t>(synchronizer.get_rank());
+        auto number_of_ranks = static_cast<uint32_t>(synchronizer.get_number_of_ranks());
+        if (number_of_ranks > 1) {
+            if (UseGPU) throw pink::exception("Data-parallel training is only supported on the CPU, please use --cuda-off.");
+            if (input_data.m_asynchronous) {
+                throw pink::exception("Asynchronous training can not be combined with data-parallel training.");
+            }
+            if (input_data.m_pipelined) {
+                throw pink::exception("Pipelined training can not be combined with data-parallel training.");
+            }
+            if (checkpoint.position != 0) {
+                throw pink::exception("Data-parallel training can only be resumed at the end of an iteration.");
+            }
+            if (!input_data.m_last_iteration_mapping_filename.empty()) {
+                throw pink::exception("Mapping of the last iteration can not be combined with data-parallel training.");
+            }
+        }
+
+        auto shard_size = (input_data.m_number_of_data_entries + number_of_ranks - 1 - rank) / number_of_ranks;
+        if (shard_size == 0) throw pink::exception("Number of data entries is smaller than number of processes.");
+
+        // All processes must synchronize equally often, also if their shard is one entry smaller
+        auto max_shard_size = (input_data.m_number_of_data_entries + number_of_ranks - 1) / number_of_ranks;
+        auto number_of_synchronizations = (max_shard_size + input_data.m_sync_interval - 1) / input_data.m_sync_interval;
+
         Trainer<SOMLayout, DataLayout, T, UseGPU> trainer(
             som
             ,input_data.get_distribution_function()
@@ -69,97 +468,276 @@ void main_generic(InputData const& input_data)
 #ifdef __CUDACC__
             ,input_data.m_block_size_1
             ,input_data.m_euclidean_distance_type
+#else
+            ,input_data.m_transformation_layout
 #endif
         );
 
+        // The update counters of the checkpoint are the sum of all processes
+        if (input_data.m_resume and rank == 0) trainer.set_update_info(update_info);
+
+        if (input_data.m_best_match_cache_radius > 0.0f) {
+            trainer.enable_best_match_cache(input_data.m_number_of_data_entries,
+                input_data.m_best_match_cache_radius, input_data.m_best_match_cache_max_distance_increase);
+        }
+        if (input_data.m_best_rotation_cache_window > 0) {
+            trainer.enable_best_rotation_cache(input_data.m_number_of_data_entries, input_data.m_best_rotation_cache_window);
+        }
+        if constexpr (!UseGPU) {
+            if (input_data.m_two_phase_search) trainer.enable_two_phase_search();
+            if (input_data.m_transform_cache_size > 0) {
+                trainer.enable_transform_cache(input_data.m_number_of_data_entries,
+                    static_cast<size_t>(input_data.m_transform_cache_size) << 20);
+            }
+        }
 
-        ProgressBar progress_bar(static_cast<int>(
-            input_data.m_number_of_data_entries * input_data.m_number_of_iterations),
+        ProgressBar progress_bar(static_cast<int>(shard_size * input_data.m_number_of_iterations),
             70, input_data.m_max_number_of_progress_prints);
-        uint32_t count = 0;
-        for (uint32_t i = 0; i < input_data.m_number_of_iterations; ++i)
+        for (uint64_t k = 0; k < static_cast<uint64_t>(checkpoint.iteration) * shard_size
+            + checkpoint.position; ++k) ++progress_bar;
+
+        uint32_t count = checkpoint.intermediate_count;
+        SnapshotWriter<SOMLayout, DataLayout, T> snapshot_writer;
+        auto&& write_intermediate_som = [&]()
+        {
+            if (rank == 0 and progress_bar.valid() and input_data.m_intermediate_storage != IntermediateStorageType::OFF) {
+                std::string interStore_filename = input_data.m_result_filename;
+                if (input_data.m_intermediate_storage == IntermediateStorageType::KEEP) {
+                    interStore_filename.insert(interStore_filename.find_last_of("."),
+                        "_" + std::to_string(count++));
+                }
+                if (input_data.m_verbose) {
+                    std::cout << "  Write intermediate SOM to " << interStore_filename << " in background" << std::endl;
+                }
+                #ifdef __CUDACC__
+                    trainer.update_som();
+                #endif
+                snapshot_writer(som, interStore_filename);
+            }
+        };
+
+        // Training state at the beginning of the given iteration and position
+        auto&& write_checkpoint_file = [&](uint32_t iteration, uint32_t position)
+        {
+            if (input_data.m_checkpoint_filename.empty()) return;
+            #ifdef __CUDACC__
+                trainer.update_som();
+            #endif
+            checkpoint.iteration = iteration;
+            checkpoint.position = position;
+            checkpoint.intermediate_count = count;
+            auto&& update_info = trainer.get_update_info();
+            synchronizer.reduce(update_info);
+            if (rank == 0) write_checkpoint(input_data.m_checkpoint_filename, checkpoint, som, update_info);
+        };
+
+        auto resume_iteration = checkpoint.iteration;
+        auto resume_position = checkpoint.position;
+
+        // Mapping of the data points by the search of the last iteration (optional)
+        std::optional<MappingWriter<SOMLayout>> mapping_writer;
+        if (!input_data.m_last_iteration_mapping_filename.empty()) {
+            mapping_writer.emplace(input_data.m_last_iteration_mapping_filename,
+                input_data.m_write_rot_flip ? input_data.m_rot_flip_filename : "", som.get_som_layout(),
+                input_data.m_number_of_data_entries, input_data.m_number_of_rotations);
+        }
+        bool write_mapping = false;
+
+        // The mapping file contains the euclidean distances, the trainer compares the squared ones
+        std::vector<float> mapping_distances;
+        auto&& write_mapping_of = [&](uint32_t index, [[maybe_unused]] uint32_t b)
+        {
+            if constexpr (!UseGPU) {
+                auto&& euclidean_distance_matrix = trainer.get_euclidean_distance_matrix(b);
+                mapping_distances.resize(euclidean_distance_matrix.size());
+                for (size_t k = 0; k < euclidean_distance_matrix.size(); ++k) {
+                    mapping_distances[k] = std::sqrt(euclidean_distance_matrix[k]);
+                }
+                (*mapping_writer)(index, mapping_distances.data(), trainer.get_best_rotation_matrix(b).data());
+            }
+        };
+
+        std::vector<Data<DataLayout, T>> batch;
+        std::vector<uint32_t> batch_indices;
+        auto&& train_batch = [&]()
+        {
+            if (batch.empty()) return;
+            if constexpr (!UseGPU) {
+                trainer(batch, batch_indices);
+                if (write_mapping) {
+                    for (uint32_t b = 0; b < batch.size(); ++b) write_mapping_of(batch_indices[b], b);
+                }
+            }
+            batch.clear();
+            batch_indices.clear();
+        };
+
+        // Convergence statistics of the iterations, only rank 0 writes the log file
+        std::ofstream statistics_file;
+        IterationStatistics previous_statistics;
+        if (needs_convergence_statistics(input_data)) {
+            trainer.enable_statistics(input_data.m_number_of_data_entries);
+            if (rank == 0 and !input_data.m_statistics_filename.empty()) {
+                open_statistics_file(statistics_file, input_data);
+            }
+        }
+
+        uint32_t number_of_trained_iterations = 0;
+        auto&& start_time = std::chrono::steady_clock::now();
+        for (uint32_t i = resume_iteration; i < input_data.m_number_of_iterations; ++i)
         {
             // Change the seed for DataIteratorShuffled for every iteration by adding
             // the loop index number, so that the image order is different in every iteration.
             auto&& iter_data_cur = DataIteratorShuffled<DataLayout, T>(ifs,
-                static_cast<uint64_t>(input_data.m_seed) + i, input_data.m_shuffle_data_input);
+                static_cast<uint64_t>(input_data.m_seed) + i, input_data.m_shuffle_data_input, rank, number_of_ranks);
             auto&& iter_data_end = DataIteratorShuffled<DataLayout, T>(ifs, true);
-            for (; iter_data_cur != iter_data_end; ++iter_data_cur, ++progress_bar)
-            {
-                trainer(*iter_data_cur);
 
-                if (progress_bar.valid() and input_data.m_intermediate_storage != IntermediateStorageType::OFF) {
-                    std::string interStore_filename = input_data.m_result_filename;
-                    if (input_data.m_intermediate_storage == IntermediateStorageType::KEEP) {
-                        interStore_filename.insert(interStore_filename.find_last_of("."),
-                            "_" + std::to_string(count++));
+            // Skip the data points already trained before the checkpoint
+            uint32_t position = 0;
+            if (i == resume_iteration and resume_position != 0) {
+                position = resume_position;
+                iter_data_cur += static_cast<int>(position);
+            }
+
+            set_decayed_neighborhood(trainer, input_data, i);
+            write_mapping = mapping_writer.has_value() and i + 1 == input_data.m_number_of_iterations;
+
+            ++number_of_trained_iterations;
+            if (input_data.m_asynchronous) {
+                if constexpr (!UseGPU) {
+                    trainer.train_asynchronous(iter_data_cur, iter_data_end, [&]()
+                    {
+                        write_intermediate_som();
+                        ++progress_bar;
+                    });
+                }
+            } else if (input_data.m_pipelined) {
+                if constexpr (!UseGPU) {
+                    trainer.train_pipelined(iter_data_cur, iter_data_end, [&]()
+                    {
+                        write_intermediate_som();
+                        ++progress_bar;
+                    });
+                }
+            } else {
+                uint32_t synchronizations = 0;
+                bool checkpoint_pending = false;
+                for (; iter_data_cur != iter_data_end; ++iter_data_cur, ++progress_bar)
+                {
+                    if constexpr (UseGPU) {
+                        trainer(*iter_data_cur, iter_data_cur.get_index());
+                    } else {
+                        if (input_data.m_batch_size == 1) {
+                            trainer(*iter_data_cur, iter_data_cur.get_index());
+                            if (write_mapping) write_mapping_of(iter_data_cur.get_index(), 0);
+                        } else {
+                            batch.push_back(*iter_data_cur);
+                            batch_indices.push_back(iter_data_cur.get_index());
+                            if (batch.size() == input_data.m_batch_size) train_batch();
+                        }
                     }
-                    if (input_data.m_verbose) {
-                        std::cout << "  Write intermediate SOM to " << interStore_filename << " ... " << std::flush;
+
+                    ++position;
+                    if (number_of_ranks > 1 and position % input_data.m_sync_interval == 0) {
+                        train_batch();
+                        synchronizer();
+                        ++synchronizations;
+                    }
+
+                    write_intermediate_som();
+
+                    // Within a mini-batch the checkpoint is written after the batch is trained
+                    if (number_of_ranks == 1 and progress_bar.valid()) checkpoint_pending = true;
+                    if (checkpoint_pending and batch.empty()) {
+                        write_checkpoint_file(i, position);
+                        checkpoint_pending = false;
                     }
-                    #ifdef __CUDACC__
-                        trainer.update_som();
-                    #endif
-                    write(som, interStore_filename);
-                    if (input_data.m_verbose) std::cout << "done." << std::endl;
                 }
+
+                // The last incomplete batch of the iteration
+                train_batch();
+
+                if (number_of_ranks > 1) {
+                    for (; synchronizations < number_of_synchronizations; ++synchronizations) synchronizer();
+                }
+            }
+
+            if (trainer.has_best_match_cache()) {
+                auto&& cache = trainer.get_best_match_cache();
+                std::cout << "  Iteration " << i << ": best match cache hit rate = " << cache.get_hit_rate() << std::endl;
+                cache.reset_counters();
+            }
+            if (trainer.has_best_rotation_cache()) {
+                auto&& cache = trainer.get_best_rotation_cache();
+                std::cout << "  Iteration " << i << ": best rotation cache hit rate = " << cache.get_hit_rate() << std::endl;
+                cache.reset_counters();
+            }
+            if constexpr (!UseGPU) {
+                if (trainer.has_transform_cache()) {
+                    auto&& cache = trainer.get_transform_cache();
+                    std::cout << "  Iteration " << i << ": transform cache hit rate = " << cache.get_hit_rate()
+                              << ", cached images = " << cache.get_number_of_cached_data_points() << " of "
+                              << cache.get_number_of_data_entries() << " (" << (cache.get_memory_size() >> 20)
+                              << " MB)" << std::endl;
+                    cache.reset_counters();
+                }
+            }
+
+            bool converged = false;
+            if (trainer.has_statistics()) {
+                auto&& statistics = trainer.get_statistics();
+                synchronizer.reduce(statistics);
+                auto&& iteration_statistics = statistics.finish_iteration();
+                converged = report_convergence(previous_statistics, iteration_statistics, i, input_data, statistics_file);
+                previous_statistics = iteration_statistics;
             }
+
+            write_checkpoint_file(i + 1, 0);
+            if (converged) break;
+        }
+
+        if (input_data.m_verbose or input_data.m_asynchronous or input_data.m_pipelined) {
+            std::chrono::duration<double> training_time = std::chrono::steady_clock::now() - start_time;
+            std::cout << "  Training throughput = "
+                      << input_data.m_number_of_data_entries * number_of_trained_iterations / training_time.count()
+                      << " images/s with " << input_data.m_number_of_threads << " threads";
+            if (number_of_ranks > 1) std::cout << " and " << number_of_ranks << " processes";
+            std::cout << std::endl;
+        }
+
+        if (mapping_writer) {
+            std::cout << "  Mapping of the last iteration written to " << input_data.m_last_iteration_mapping_filename
+                      << std::endl;
+        }
+
+        snapshot_writer.wait();
+        if (input_data.m_verbose and input_data.m_intermediate_storage != IntermediateStorageType::OFF) {
+            std::cout << "  Training stalled by intermediate SOMs = " << snapshot_writer.get_stall_time() << " s" << std::endl;
         }
 
         std::cout << "  Write final SOM to " << input_data.m_result_filename << " ... " << std::flush;
 #ifdef __CUDACC__
         trainer.update_som();
 #endif
-        write(som, input_data.m_result_filename);
+        if (rank == 0) write(som, input_data.m_result_filename);
         std::cout << "done." << std::endl;
 
+        auto&& final_update_info = trainer.get_update_info();
+        synchronizer.reduce(final_update_info);
         if (input_data.m_verbose) {
             std::cout << "\n  Number of updates of each neuron:\n\n"
-                      << trainer.get_update_info()
+                      << final_update_info
                       << std::endl;
         }
     }
     else if (input_data.m_executionPath == ExecutionPath::MAP)
     {
-        // File for euclidean distances
-        std::ofstream result_file(input_data.m_result_filename);
-        if (!result_file) throw pink::exception("Error opening " + input_data.m_result_filename);
-
         auto&& iter_data_cur = DataIterator<DataLayout, T>(ifs);
         auto&& iter_data_end = DataIterator<DataLayout, T>(ifs, true);
 
-        // <file format version> 2 <data-type> <number of entries> <som layout> <data>
-        int version = 2;
-        int file_type = 2;
-        int data_type_idx = 0;
-        int som_layout_idx = 0;
-        int som_dimensionality = static_cast<int>(som.get_som_layout().dimensionality);
-        int number_of_data_entries = static_cast<int>(input_data.m_number_of_data_entries);
-
-        result_file.write(reinterpret_cast<char*>(&version), sizeof(int));
-        result_file.write(reinterpret_cast<char*>(&file_type), sizeof(int));
-        result_file.write(reinterpret_cast<char*>(&data_type_idx), sizeof(int));
-        result_file.write(reinterpret_cast<char*>(&number_of_data_entries), sizeof(int));
-        result_file.write(reinterpret_cast<char*>(&som_layout_idx), sizeof(int));
-        result_file.write(reinterpret_cast<char*>(&som_dimensionality), sizeof(int));
-        for (auto d : som.get_som_layout().m_dimension) result_file.write(reinterpret_cast<char*>(&d), sizeof(int));
-
-        // File for spatial_transformations (optional)
-        std::ofstream spatial_transformation_file;
-        if (input_data.m_write_rot_flip) {
-            spatial_transformation_file.open(input_data.m_rot_flip_filename);
-            if (!spatial_transformation_file) throw pink::exception("Error opening " + input_data.m_rot_flip_filename);
-
-            // <file format version> 3 <number of entries> <som layout> <data>
-            file_type = 3;
-
-            spatial_transformation_file.write(reinterpret_cast<char*>(&version), sizeof(int));
-            spatial_transformation_file.write(reinterpret_cast<char*>(&file_type), sizeof(int));
-            spatial_transformation_file.write(reinterpret_cast<char*>(&number_of_data_entries), sizeof(int));
-            spatial_transformation_file.write(reinterpret_cast<char*>(&som_layout_idx), sizeof(int));
-            spatial_transformation_file.write(reinterpret_cast<char*>(&som_dimensionality), sizeof(int));
-            for (auto d : som.get_som_layout().m_dimension) spatial_transformation_file.write(reinterpret_cast<char*>(&d), sizeof(int));
-        }
+        MappingWriter<SOMLayout> mapping_writer(input_data.m_result_filename,
+            input_data.m_write_rot_flip ? input_data.m_rot_flip_filename : "", som.get_som_layout(),
+            input_data.m_number_of_data_entries, input_data.m_number_of_rotations);
 
         Mapper<SOMLayout, DataLayout, T, UseGPU> mapper(
             som
@@ -172,27 +750,50 @@ void main_generic(InputData const& input_data)
 #ifdef __CUDACC__
             ,input_data.m_block_size_1
             ,input_data.m_euclidean_distance_type
+#else
+            ,input_data.m_transformation_layout
 #endif
         );
 
-        ProgressBar progress_bar(number_of_data_entries, 70, input_data.m_max_number_of_progress_prints);
-        for (; iter_data_cur != iter_data_end; ++iter_data_cur, ++progress_bar)
-        {
-            auto result = mapper(*iter_data_cur);
-            // corresponds to structured binding with C++17:
-            //auto& [euclidean_distance_matrix, best_rotation_matrix] = mapper(data);
-
-            result_file.write(reinterpret_cast<char*>(&std::get<0>(result)[0]),
-                static_cast<std::streamsize>(som.get_number_of_neurons() * sizeof(float)));
-
-            if (input_data.m_write_rot_flip) {
-                float angle_step_radians = static_cast<float>(2.0 * M_PI) / input_data.m_number_of_rotations;
-                for (uint32_t i = 0; i != som.get_number_of_neurons(); ++i) {
-                    char flip = static_cast<char>(std::get<1>(result)[i] / input_data.m_number_of_rotations);
-                    float angle = (std::get<1>(result)[i] % input_data.m_number_of_rotations) * angle_step_radians;
-                    spatial_transformation_file.write(&flip, sizeof(char));
-                    spatial_transformation_file.write(reinterpret_cast<char*>(&angle), sizeof(float));
+        ProgressBar progress_bar(static_cast<int>(input_data.m_number_of_data_entries), 70,
+            input_data.m_max_number_of_progress_prints);
+
+        if constexpr (!UseGPU) {
+            // The data points of a batch are mapped concurrently, some more than threads for load balancing
+            auto batch_size = static_cast<uint32_t>(4 * omp_get_max_threads());
+            auto som_size = static_cast<size_t>(som.get_number_of_neurons());
+
+            // Results of the mapper, reused for all batches
+            std::vector<Data<DataLayout, T>> batch;
+            std::vector<float> euclidean_distance_matrix(batch_size * som_size);
+            std::vector<uint32_t> best_rotation_matrix(batch_size * som_size);
+
+            uint32_t number_of_mapped_data_points = 0;
+            auto map_batch = [&]()
+            {
+                mapper(batch, euclidean_distance_matrix.data(), best_rotation_matrix.data());
+                for (uint32_t b = 0; b < batch.size(); ++b, ++progress_bar) {
+                    mapping_writer(number_of_mapped_data_points++, &euclidean_distance_matrix[b * som_size],
+                        &best_rotation_matrix[b * som_size]);
                 }
+                batch.clear();
+            };
+
+            for (; iter_data_cur != iter_data_end; ++iter_data_cur)
+            {
+                batch.push_back(*iter_data_cur);
+                if (batch.size() == batch_size) map_batch();
+            }
+            if (!batch.empty()) map_batch();
+        } else {
+            // Results of the mapper, reused for all data points
+            std::vector<float> euclidean_distance_matrix(som.get_number_of_neurons());
+            std::vector<uint32_t> best_rotation_matrix(som.get_number_of_neurons());
+
+            for (uint32_t i = 0; iter_data_cur != iter_data_end; ++iter_data_cur, ++progress_bar, ++i)
+            {
+                mapper(*iter_data_cur, euclidean_distance_matrix.data(), best_rotation_matrix.data());
+                mapping_writer(i, euclidean_distance_matrix.data(), best_rotation_matrix.data());
             }
         }
     }
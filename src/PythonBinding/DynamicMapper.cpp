@@ -35,6 +35,8 @@ DynamicMapper::DynamicMapper(DynamicSOM const& dynamic_som, int verbosity, uint3
 auto DynamicMapper::operator () (DynamicData const& data) const
     -> std::tuple<std::vector<float>, std::vector<uint32_t>>
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
     if (m_som_layout == "cartesian-2d") {
         return map<CartesianLayout<2>>(data);
     } else if (m_som_layout == "hexagonal-2d") {
@@ -44,4 +46,29 @@ auto DynamicMapper::operator () (DynamicData const& data) const
     }
 }
 
+auto DynamicMapper::map_batch(float const* ptr, std::vector<uint32_t> const& shape) const
+    -> std::tuple<std::vector<float>, std::vector<uint32_t>>
+{
+    if (shape.size() != 3) throw pink::exception("batch of images must have the shape (number, height, width)");
+
+    CartesianLayout<2> layout{shape[1], shape[2]};
+    auto image_size = layout.size();
+
+    std::vector<Data<CartesianLayout<2>, float>> batch;
+    batch.reserve(shape[0]);
+    for (uint32_t i = 0; i < shape[0]; ++i) {
+        batch.emplace_back(layout, std::vector<float>(ptr + i * image_size, ptr + (i + 1) * image_size));
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_som_layout == "cartesian-2d") {
+        return map_batch<CartesianLayout<2>>(batch);
+    } else if (m_som_layout == "hexagonal-2d") {
+        return map_batch<HexagonalLayout>(batch);
+    } else {
+        throw pink::exception("som layout " + m_som_layout + " is not supported");
+    }
+}
+
 } // namespace pink
@@ -7,6 +7,8 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "DynamicData.h"
 #include "DynamicSOM.h"
@@ -30,6 +32,11 @@ struct DynamicMapper
     auto operator () (DynamicData const& data) const
         -> std::tuple<std::vector<float>, std::vector<uint32_t>>;
 
+    /// Mapping of a batch of images with the shape (number of images, height, width),
+    /// the results are of the size number of images x number of neurons
+    auto map_batch(float const* ptr, std::vector<uint32_t> const& shape) const
+        -> std::tuple<std::vector<float>, std::vector<uint32_t>>;
+
 private:
 
     template <typename SOM_Layout>
@@ -96,8 +103,47 @@ private:
 #endif
     }
 
+    template <typename SOM_Layout>
+    auto map_batch(std::vector<Data<CartesianLayout<2>, float>> const& batch) const
+        -> std::tuple<std::vector<float>, std::vector<uint32_t>>
+    {
+        if (m_neuron_layout == "cartesian-2d") {
+            return map_batch<SOM_Layout, CartesianLayout<2>>(batch);
+        } else {
+            throw pink::exception("neuron layout " + m_neuron_layout + " is not supported");
+        }
+    }
+
+    template <typename SOM_Layout, typename Neuron_Layout>
+    auto map_batch(std::vector<Data<CartesianLayout<2>, float>> const& batch) const
+        -> std::tuple<std::vector<float>, std::vector<uint32_t>>
+    {
+#ifdef __CUDACC__
+        if (m_use_gpu == true) {
+            // The GPU mapper parallelizes within a single image
+            auto&& mapper = *std::dynamic_pointer_cast<Mapper<SOM_Layout, Neuron_Layout, float, true>>(m_mapper);
+            std::vector<float> euclidean_distance_matrix;
+            std::vector<uint32_t> best_rotation_matrix;
+            for (auto&& data : batch) {
+                auto&& [e, r] = mapper(data);
+                euclidean_distance_matrix.insert(euclidean_distance_matrix.end(), e.begin(), e.end());
+                best_rotation_matrix.insert(best_rotation_matrix.end(), r.begin(), r.end());
+            }
+            return std::make_tuple(euclidean_distance_matrix, best_rotation_matrix);
+        } else {
+#endif
+            return std::dynamic_pointer_cast<Mapper<SOM_Layout, Neuron_Layout, float, false>>(m_mapper)->operator()(
+                batch);
+#ifdef __CUDACC__
+        }
+#endif
+    }
+
     std::shared_ptr<MapperBase> m_mapper;
 
+    /// The mapper reuses its workspaces, calls from several Python threads are serialized
+    mutable std::mutex m_mutex;
+
     std::string m_data_type;
 
     std::string m_som_layout;
@@ -37,19 +37,19 @@ struct DynamicSOM
             return std::make_shared<SOM<SOM_Layout, CartesianLayout<1U>, float>>(
                 som_layout,
                 CartesianLayout<1U>{{neuron_shape[0]}},
-                std::vector<float>(p, p + size));
+                typename SOM<SOM_Layout, CartesianLayout<1U>, float>::StorageType(p, p + size));
         } else if (m_neuron_layout == "cartesian-2d") {
             assert(neuron_shape.size() == 2);
             return std::make_shared<SOM<SOM_Layout, CartesianLayout<2U>, float>>(
                 som_layout,
                 CartesianLayout<2U>{{neuron_shape[0], neuron_shape[1]}},
-                std::vector<float>(p, p + size));
+                typename SOM<SOM_Layout, CartesianLayout<2U>, float>::StorageType(p, p + size));
         } else if (m_neuron_layout == "cartesian-3d") {
             assert(neuron_shape.size() == 3);
             return std::make_shared<SOM<SOM_Layout, CartesianLayout<3U>, float>>(
                 som_layout,
                 CartesianLayout<3U>{{neuron_shape[0], neuron_shape[1], neuron_shape[2]}},
-                std::vector<float>(p, p + size));
+                typename SOM<SOM_Layout, CartesianLayout<3U>, float>::StorageType(p, p + size));
         } else {
             throw pink::exception("neuron layout " + m_neuron_layout + " is not supported");
         }
@@ -0,0 +1,46 @@
+/**
+ * @file   PythonBinding/DynamicSweepTrainer.cpp
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#include "DynamicSweepTrainer.h"
+
+namespace pink {
+
+DynamicSweepTrainer::DynamicSweepTrainer(std::vector<DynamicTrainer*> const& trainers)
+{
+    if (trainers.empty()) throw pink::exception("sweep trainer needs at least one trainer");
+
+    m_som_layout = trainers[0]->m_som_layout;
+    m_neuron_layout = trainers[0]->m_neuron_layout;
+
+    for (auto&& trainer : trainers) {
+        if (trainer->m_som_layout != m_som_layout or trainer->m_neuron_layout != m_neuron_layout) {
+            throw pink::exception("all trainers of a sweep must have the same som and neuron layout");
+        }
+        if (trainer->m_use_gpu) throw pink::exception("sweep is only supported with use_gpu=False");
+        if (trainer->m_batch_size != 1) throw pink::exception("sweep is only supported with batch_size=1");
+    }
+
+    if (m_som_layout == "cartesian-2d") {
+        m_sweep_trainer = get_sweep_trainer<CartesianLayout<2>>(trainers);
+    } else if (m_som_layout == "hexagonal-2d") {
+        m_sweep_trainer = get_sweep_trainer<HexagonalLayout>(trainers);
+    } else {
+        throw pink::exception("som layout " + m_som_layout + " is not supported");
+    }
+}
+
+void DynamicSweepTrainer::operator () (DynamicData const& data)
+{
+    if (m_som_layout == "cartesian-2d") {
+        train<CartesianLayout<2>>(data);
+    } else if (m_som_layout == "hexagonal-2d") {
+        train<HexagonalLayout>(data);
+    } else {
+        throw pink::exception("som layout " + m_som_layout + " is not supported");
+    }
+}
+
+} // namespace pink
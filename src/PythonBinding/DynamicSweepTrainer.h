@@ -0,0 +1,87 @@
+/**
+ * @file   PythonBinding/DynamicSweepTrainer.h
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "DynamicData.h"
+#include "DynamicTrainer.h"
+#include "SelfOrganizingMapLib/CartesianLayout.h"
+#include "SelfOrganizingMapLib/HexagonalLayout.h"
+#include "SelfOrganizingMapLib/SweepTrainer.h"
+#include "UtilitiesLib/pink_exception.h"
+
+namespace pink {
+
+/// Hyper-parameter sweep: all trainers are trained by a single pass of spatial transformations.
+/// The trainers are not owned and must outlive the sweep trainer.
+struct DynamicSweepTrainer
+{
+    DynamicSweepTrainer(std::vector<DynamicTrainer*> const& trainers);
+
+    DynamicSweepTrainer(DynamicSweepTrainer const&) = delete;
+
+    void operator () (DynamicData const& data);
+
+private:
+
+    template <typename SOM_Layout>
+    auto get_sweep_trainer(std::vector<DynamicTrainer*> const& trainers) -> std::shared_ptr<TrainerBase>
+    {
+        if (m_neuron_layout == "cartesian-1d") {
+            return get_sweep_trainer<SOM_Layout, CartesianLayout<1U>>(trainers);
+        } else if (m_neuron_layout == "cartesian-2d") {
+            return get_sweep_trainer<SOM_Layout, CartesianLayout<2U>>(trainers);
+        } else if (m_neuron_layout == "cartesian-3d") {
+            return get_sweep_trainer<SOM_Layout, CartesianLayout<3U>>(trainers);
+        } else {
+            throw pink::exception("neuron layout " + m_neuron_layout + " is not supported");
+        }
+    }
+
+    template <typename SOM_Layout, typename Neuron_Layout>
+    auto get_sweep_trainer(std::vector<DynamicTrainer*> const& trainers) -> std::shared_ptr<TrainerBase>
+    {
+        typedef Trainer<SOM_Layout, Neuron_Layout, float, false> TrainerType;
+
+        std::vector<TrainerType*> trainer_pointers;
+        for (auto&& trainer : trainers) {
+            trainer_pointers.push_back(std::dynamic_pointer_cast<TrainerType>(trainer->m_trainer).get());
+        }
+        return std::make_shared<SweepTrainer<SOM_Layout, Neuron_Layout, float>>(trainer_pointers);
+    }
+
+    template <typename SOM_Layout>
+    void train(DynamicData const& data)
+    {
+        if (m_neuron_layout == "cartesian-1d") {
+            train<SOM_Layout, CartesianLayout<1U>>(data);
+        } else if (m_neuron_layout == "cartesian-2d") {
+            train<SOM_Layout, CartesianLayout<2U>>(data);
+        } else if (m_neuron_layout == "cartesian-3d") {
+            train<SOM_Layout, CartesianLayout<3U>>(data);
+        } else {
+            throw pink::exception("neuron layout " + m_neuron_layout + " is not supported");
+        }
+    }
+
+    template <typename SOM_Layout, typename Neuron_Layout>
+    void train(DynamicData const& data)
+    {
+        std::dynamic_pointer_cast<SweepTrainer<SOM_Layout, Neuron_Layout, float>>(m_sweep_trainer)->operator()(
+            *(std::dynamic_pointer_cast<Data<Neuron_Layout, float>>(data.m_data)));
+    }
+
+    std::shared_ptr<TrainerBase> m_sweep_trainer;
+
+    std::string m_som_layout;
+
+    std::string m_neuron_layout;
+};
+
+} // namespace pink
@@ -13,14 +13,20 @@ namespace pink {
 DynamicTrainer::DynamicTrainer(DynamicSOM& dynamic_som, std::function<float(float)> const& distribution_function,
     int verbosity, uint32_t number_of_rotations, bool use_flip, float max_update_distance,
     Interpolation interpolation, bool use_gpu, uint32_t euclidean_distance_dim,
-    EuclideanDistanceShape euclidean_distance_shape, DataType euclidean_distance_type)
+    EuclideanDistanceShape euclidean_distance_shape, DataType euclidean_distance_type,
+    uint32_t batch_size)
  : m_data_type(dynamic_som.m_data_type),
    m_som_layout(dynamic_som.m_som_layout),
    m_neuron_layout(dynamic_som.m_neuron_layout),
-   m_use_gpu(use_gpu)
+   m_use_gpu(use_gpu),
+   m_batch_size(batch_size)
 {
     if (m_data_type != "float32") throw pink::exception("data-type not supported");
     if (euclidean_distance_dim == 0) throw pink::exception("euclidean_distance_dim not defined");
+    if (m_batch_size == 0) throw pink::exception("batch_size must be > 0");
+#ifdef __CUDACC__
+    if (m_use_gpu and m_batch_size > 1) throw pink::exception("batch_size > 1 is only supported with use_gpu=False");
+#endif
 
     if (m_som_layout == "cartesian-2d") {
         m_trainer = get_trainer<CartesianLayout<2>>(dynamic_som, distribution_function,
@@ -48,6 +54,15 @@ void DynamicTrainer::operator () (DynamicData const& data)
 
 void DynamicTrainer::update_som()
 {
+    if (!m_batch.empty()) {
+        if (m_som_layout == "cartesian-2d") {
+            train_batch<CartesianLayout<2>>();
+        } else if (m_som_layout == "hexagonal-2d") {
+            train_batch<HexagonalLayout>();
+        } else {
+            throw pink::exception("som layout " + m_som_layout + " is not supported");
+        }
+    }
     m_trainer->update_som();
 }
 
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "DynamicData.h"
 #include "DynamicSOM.h"
@@ -24,7 +25,8 @@ struct DynamicTrainer
     DynamicTrainer(DynamicSOM& som, std::function<float(float)> const& distribution_function,
         int verbosity, uint32_t number_of_rotations, bool use_flip, float max_update_distance,
         Interpolation interpolation, bool use_gpu, uint32_t euclidean_distance_dim,
-        EuclideanDistanceShape euclidean_distance_shape, DataType euclidean_distance_type);
+        EuclideanDistanceShape euclidean_distance_shape, DataType euclidean_distance_type,
+        uint32_t batch_size = 1);
 
     DynamicTrainer(DynamicTrainer const&) = delete;
 
@@ -34,6 +36,8 @@ struct DynamicTrainer
 
 private:
 
+    friend struct DynamicSweepTrainer;
+
     template <typename SOM_Layout>
     auto get_trainer(DynamicSOM& dynamic_som, std::function<float(float)> const& distribution_function,
         int verbosity, uint32_t number_of_rotations, bool use_flip, float max_update_distance,
@@ -112,14 +116,44 @@ private:
                 *(std::dynamic_pointer_cast<Data<Neuron_Layout, float>>(data.m_data)));
         } else {
 #endif
-            std::dynamic_pointer_cast<Trainer<SOM_Layout, Neuron_Layout, float, false>>(m_trainer)->operator()(
-                *(std::dynamic_pointer_cast<Data<Neuron_Layout, float>>(data.m_data)));
-           
-#ifdef __CUDACC__     
+            if (m_batch_size == 1) {
+                std::dynamic_pointer_cast<Trainer<SOM_Layout, Neuron_Layout, float, false>>(m_trainer)->operator()(
+                    *(std::dynamic_pointer_cast<Data<Neuron_Layout, float>>(data.m_data)));
+            } else {
+                m_batch.push_back(data.m_data);
+                if (m_batch.size() == m_batch_size) train_batch<SOM_Layout, Neuron_Layout>();
+            }
+#ifdef __CUDACC__
         }
 #endif
     }
 
+    template <typename SOM_Layout>
+    void train_batch()
+    {
+        if (m_neuron_layout == "cartesian-1d") {
+            train_batch<SOM_Layout, CartesianLayout<1U>>();
+        } else if (m_neuron_layout == "cartesian-2d") {
+            train_batch<SOM_Layout, CartesianLayout<2U>>();
+        } else if (m_neuron_layout == "cartesian-3d") {
+            train_batch<SOM_Layout, CartesianLayout<3U>>();
+        } else {
+            throw pink::exception("neuron layout " + m_neuron_layout + " is not supported");
+        }
+    }
+
+    /// Train the SOM with the collected data and clear the batch
+    template <typename SOM_Layout, typename Neuron_Layout>
+    void train_batch()
+    {
+        std::vector<Data<Neuron_Layout, float>> batch;
+        batch.reserve(m_batch.size());
+        for (auto&& data : m_batch) batch.push_back(*(std::dynamic_pointer_cast<Data<Neuron_Layout, float>>(data)));
+
+        std::dynamic_pointer_cast<Trainer<SOM_Layout, Neuron_Layout, float, false>>(m_trainer)->operator()(batch);
+        m_batch.clear();
+    }
+
     std::shared_ptr<TrainerBase> m_trainer;
 
     std::string m_data_type;
@@ -129,6 +163,12 @@ private:
     std::string m_neuron_layout;
 
     bool m_use_gpu;
+
+    /// Number of data points per SOM update (only CPU)
+    uint32_t m_batch_size;
+
+    /// Data points collected for the next SOM update
+    std::vector<std::shared_ptr<DataBase>> m_batch;
 };
 
 } // namespace pink
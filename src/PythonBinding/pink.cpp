@@ -4,6 +4,7 @@
  * @author Bernd Doser, HITS gGmbH
  */
 
+#include <algorithm>
 #include <pybind11/functional.h>
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
@@ -12,6 +13,7 @@
 #include "DynamicData.h"
 #include "DynamicMapper.h"
 #include "DynamicSOM.h"
+#include "DynamicSweepTrainer.h"
 #include "DynamicTrainer.h"
 #include "UtilitiesLib/DataType.h"
 #include "UtilitiesLib/DistributionFunctor.h"
@@ -112,7 +114,7 @@ PYBIND11_MODULE(pink, m)
 
     py::class_<DynamicTrainer>(m, "Trainer")
         .def(py::init<DynamicSOM&, std::function<float(float)> const&, int,
-            uint32_t, bool, float, Interpolation, bool, uint32_t, EuclideanDistanceShape, DataType>(),
+            uint32_t, bool, float, Interpolation, bool, uint32_t, EuclideanDistanceShape, DataType, uint32_t>(),
             py::arg("som"),
             py::arg("distribution_function") = GaussianFunctor(1.1f, 0.2f),
             py::arg("verbosity") = 0,
@@ -123,7 +125,8 @@ PYBIND11_MODULE(pink, m)
             py::arg("use_gpu") = true,
             py::arg("euclidean_distance_dim"),
             py::arg("euclidean_distance_shape") = EuclideanDistanceShape::QUADRATIC,
-            py::arg("euclidean_distance_type") = DataType::UINT8
+            py::arg("euclidean_distance_type") = DataType::UINT8,
+            py::arg("batch_size") = 1
         )
         .def("__call__", [](DynamicTrainer& trainer, DynamicData const& data)
         {
@@ -134,6 +137,16 @@ PYBIND11_MODULE(pink, m)
             return trainer.update_som();
         });
 
+    py::class_<DynamicSweepTrainer>(m, "SweepTrainer")
+        .def(py::init<std::vector<DynamicTrainer*> const&>(),
+            py::arg("trainers"),
+            py::keep_alive<1, 2>()
+        )
+        .def("__call__", [](DynamicSweepTrainer& sweep_trainer, DynamicData const& data)
+        {
+            return sweep_trainer(data);
+        });
+
     py::class_<DynamicMapper>(m, "Mapper")
         .def(py::init<DynamicSOM const&, int, uint32_t, bool, Interpolation, bool, uint32_t, EuclideanDistanceShape, DataType>(),
             py::arg("som"),
@@ -149,5 +162,26 @@ PYBIND11_MODULE(pink, m)
         .def("__call__", [](DynamicMapper& mapper, DynamicData const& data)
         {
             return mapper(data);
-        });
+        })
+        .def("map_batch", [](DynamicMapper& mapper, py::array_t<float, py::array::c_style | py::array::forcecast> images)
+        {
+            // The images of the batch are mapped concurrently, the mapper itself is locked during the mapping
+            py::buffer_info info = images.request();
+            std::vector<uint32_t> shape(info.shape.begin(), info.shape.end());
+
+            std::tuple<std::vector<float>, std::vector<uint32_t>> result;
+            {
+                py::gil_scoped_release release;
+                result = mapper.map_batch(static_cast<float const*>(info.ptr), shape);
+            }
+
+            auto&& [euclidean_distance_matrix, best_rotation_matrix] = result;
+            std::vector<ssize_t> result_shape{static_cast<ssize_t>(shape[0]),
+                static_cast<ssize_t>(euclidean_distance_matrix.size() / std::max(shape[0], 1U))};
+            return py::make_tuple(
+                py::array_t<float>(result_shape, euclidean_distance_matrix.data()),
+                py::array_t<uint32_t>(result_shape, best_rotation_matrix.data()));
+        },
+            py::arg("images")
+        );
 }
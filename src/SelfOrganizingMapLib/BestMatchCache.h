@@ -0,0 +1,109 @@
+/**
+ * @file   SelfOrganizingMapLib/BestMatchCache.h
+ * @brief  Best matching neuron of each data point of the previous iteration
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "UtilitiesLib/pink_exception.h"
+
+namespace pink {
+
+/// Once the SOM is organized, the best matching neuron of a data point moves only by a few
+/// neurons between two iterations. The trainer searches first in a window around the cached
+/// best match and falls back to the search over all neurons, if the best neuron of the window
+/// lies at the window border or its euclidean distance increased by more than the given factor.
+///
+/// Each data point is identified by its index in the data file. Different data points
+/// can be accessed concurrently.
+class BestMatchCache
+{
+public:
+
+    /// Marks data points without a cached best match
+    static constexpr uint32_t no_best_match = 0;
+
+    BestMatchCache(uint32_t number_of_data_entries, float window_radius, float max_distance_increase)
+     : m_window_radius(window_radius),
+       m_max_distance_increase(max_distance_increase),
+       m_best_matches(number_of_data_entries, no_best_match),
+       m_distances(number_of_data_entries, 0.0f)
+    {
+        if (window_radius < 1.0f) throw pink::exception("Window radius of best match cache must be >= 1");
+    }
+
+    /// Returns false if there is no cached best match of the data point
+    bool get(uint32_t index, uint32_t& best_match, float& distance) const
+    {
+        if (index >= m_best_matches.size()) throw pink::exception("Data index of best match cache out of range");
+        if (m_best_matches[index] == no_best_match) return false;
+        best_match = m_best_matches[index] - 1;
+        distance = m_distances[index];
+        return true;
+    }
+
+    void set(uint32_t index, uint32_t best_match, float distance)
+    {
+        if (index >= m_best_matches.size()) throw pink::exception("Data index of best match cache out of range");
+        m_best_matches[index] = best_match + 1;
+        m_distances[index] = distance;
+    }
+
+    /// A local search is only accepted if the euclidean distance has not increased by more than this limit
+    bool is_accepted(float distance, float cached_distance) const
+    {
+        return distance <= cached_distance * (1.0f + m_max_distance_increase);
+    }
+
+    /// Count a search, thread-safe
+    void count(bool hit)
+    {
+        #pragma omp atomic
+        ++m_number_of_searches;
+        if (hit) {
+            #pragma omp atomic
+            ++m_number_of_hits;
+        }
+    }
+
+    /// Fraction of the searches since the last reset which were resolved in the window
+    double get_hit_rate() const
+    {
+        return m_number_of_searches == 0 ? 0.0 : static_cast<double>(m_number_of_hits) / m_number_of_searches;
+    }
+
+    uint64_t get_number_of_searches() const { return m_number_of_searches; }
+
+    void reset_counters()
+    {
+        m_number_of_hits = 0;
+        m_number_of_searches = 0;
+    }
+
+    float get_window_radius() const { return m_window_radius; }
+
+private:
+
+    /// Maximal layout distance of the window neurons to the cached best match
+    float m_window_radius;
+
+    /// Maximal relative increase of the euclidean distance to the cached one
+    float m_max_distance_increase;
+
+    /// Best match + 1 of each data point
+    std::vector<uint32_t> m_best_matches;
+
+    /// Euclidean distance to the best match of each data point
+    std::vector<float> m_distances;
+
+    uint64_t m_number_of_hits = 0;
+
+    uint64_t m_number_of_searches = 0;
+};
+
+} // namespace pink
@@ -0,0 +1,125 @@
+/**
+ * @file   SelfOrganizingMapLib/BestRotationCache.h
+ * @brief  Best match and best spatial transformation of each data point of the previous iteration
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "UtilitiesLib/pink_exception.h"
+
+namespace pink {
+
+/// The best match of a data point and its best rotation change only slightly between two iterations.
+/// The lowest euclidean distance of the cached best match over a window of rotations around the cached
+/// transformation bounds the search over all neurons and all spatial transformations, which abandons
+/// each summation as soon as it exceeds the bound (see find_best_match_pruned.h). The search stays exact,
+/// as all distances below the bound are found, so the trained SOM is the same as without the cache.
+///
+/// The best match and the transformation index are stored for each data point, identified by its index
+/// in the data file. Different data points can be accessed concurrently.
+class BestRotationCache
+{
+public:
+
+    /// Marks data points without a cached transformation
+    static constexpr uint16_t no_transformation = std::numeric_limits<uint16_t>::max();
+
+    /// The window covers the cached rotation and window_size rotations on each side
+    BestRotationCache(uint32_t number_of_data_entries, uint32_t number_of_rotations, bool use_flip, uint32_t window_size)
+     : m_number_of_rotations(number_of_rotations),
+       m_window_size(window_size),
+       m_best_matches(number_of_data_entries, 0),
+       m_transformations(number_of_data_entries, no_transformation)
+    {
+        if (window_size == 0) throw pink::exception("Window size of best rotation cache must be > 0");
+        if (number_of_rotations * (use_flip ? 2 : 1) >= no_transformation) {
+            throw pink::exception("Number of spatial transformations too large for best rotation cache");
+        }
+    }
+
+    /// Returns false if there is no cached entry of the data point
+    bool get(uint32_t index, uint32_t& best_match, uint32_t& transformation) const
+    {
+        if (index >= m_transformations.size()) throw pink::exception("Data index of best rotation cache out of range");
+        if (m_transformations[index] == no_transformation) return false;
+
+        best_match = m_best_matches[index];
+        transformation = m_transformations[index];
+        return true;
+    }
+
+    /// Transformations of the window around the given one, starting with itself and alternating
+    /// to both sides. All transformations of the window have the flip of the given one.
+    void get_window(uint32_t transformation, std::vector<uint32_t>& transformations) const
+    {
+        auto rotation = transformation % m_number_of_rotations;
+        auto flip_offset = transformation - rotation;
+        auto window_size = std::min(2 * m_window_size + 1, m_number_of_rotations);
+
+        transformations.clear();
+        transformations.push_back(transformation);
+        for (uint32_t i = 1; transformations.size() < window_size; ++i) {
+            transformations.push_back(flip_offset + (rotation + i) % m_number_of_rotations);
+            if (transformations.size() == window_size) break;
+            transformations.push_back(flip_offset + (rotation + m_number_of_rotations - i) % m_number_of_rotations);
+        }
+    }
+
+    void set(uint32_t index, uint32_t best_match, uint32_t transformation)
+    {
+        if (index >= m_transformations.size()) throw pink::exception("Data index of best rotation cache out of range");
+        m_best_matches[index] = best_match;
+        m_transformations[index] = static_cast<uint16_t>(transformation);
+    }
+
+    /// Count a search, thread-safe
+    void count(bool hit)
+    {
+        #pragma omp atomic
+        ++m_number_of_searches;
+        if (hit) {
+            #pragma omp atomic
+            ++m_number_of_hits;
+        }
+    }
+
+    /// Fraction of the searches since the last reset which kept the cached best match
+    double get_hit_rate() const
+    {
+        return m_number_of_searches == 0 ? 0.0 : static_cast<double>(m_number_of_hits) / m_number_of_searches;
+    }
+
+    uint64_t get_number_of_searches() const { return m_number_of_searches; }
+
+    void reset_counters()
+    {
+        m_number_of_hits = 0;
+        m_number_of_searches = 0;
+    }
+
+private:
+
+    uint32_t m_number_of_rotations;
+
+    /// Number of rotations on each side of the cached one
+    uint32_t m_window_size;
+
+    /// Best match of each data point
+    std::vector<uint32_t> m_best_matches;
+
+    /// Best spatial transformation of each data point
+    std::vector<uint16_t> m_transformations;
+
+    uint64_t m_number_of_hits = 0;
+
+    uint64_t m_number_of_searches = 0;
+};
+
+} // namespace pink
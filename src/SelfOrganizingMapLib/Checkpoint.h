@@ -0,0 +1,304 @@
+/**
+ * @file   SelfOrganizingMapLib/Checkpoint.h
+ * @brief  Training state for restarting an interrupted training
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Data.h"
+#include "SOM.h"
+#include "UtilitiesLib/DataType.h"
+#include "UtilitiesLib/DecayType.h"
+#include "UtilitiesLib/DistributionFunction.h"
+#include "UtilitiesLib/EuclideanDistanceShape.h"
+#include "UtilitiesLib/InputData.h"
+#include "UtilitiesLib/Interpolation.h"
+#include "UtilitiesLib/Layout.h"
+#include "UtilitiesLib/SOMInitializationType.h"
+#include "UtilitiesLib/pink_exception.h"
+
+namespace pink {
+
+/// Everything beside the SOM and the update counters needed to continue a training
+/// bit-identical to an uninterrupted run. The shuffled order of an iteration is
+/// reproduced from the seed, so that only the position within the order is stored.
+struct Checkpoint
+{
+    /// Default constructor
+    Checkpoint() = default;
+
+    /// Training parameters of the input data at the beginning of the training
+    explicit Checkpoint(InputData const& input_data)
+     : seed(input_data.m_seed),
+       number_of_iterations(input_data.m_number_of_iterations),
+       number_of_data_entries(input_data.m_number_of_data_entries),
+       shuffle_data_input(input_data.m_shuffle_data_input),
+       sigma(input_data.m_sigma),
+       damping(input_data.m_damping),
+       max_update_distance(input_data.m_max_update_distance),
+       decay_type(input_data.m_decay_type),
+       final_sigma(input_data.m_final_sigma),
+       final_damping(input_data.m_final_damping),
+       final_max_update_distance(input_data.m_final_max_update_distance),
+       som_layout(input_data.m_layout),
+       som_width(input_data.m_som_width),
+       som_height(input_data.m_som_height),
+       som_depth(input_data.m_som_depth),
+       neuron_dimension(input_data.m_neuron_dimension),
+       init(input_data.m_init),
+       number_of_rotations(input_data.m_number_of_rotations),
+       use_flip(input_data.m_use_flip),
+       interpolation(input_data.m_interpolation),
+       distribution_function(input_data.m_distribution_function),
+       use_pbc(input_data.m_use_pbc != 0),
+       euclidean_distance_dim(input_data.m_euclidean_distance_dim),
+       euclidean_distance_shape(input_data.m_euclidean_distance_shape),
+       euclidean_distance_type(input_data.m_euclidean_distance_type),
+       batch_size(input_data.m_batch_size),
+       asynchronous(input_data.m_asynchronous),
+       pipelined(input_data.m_pipelined)
+    {}
+
+    /// A training can only be continued with the same parameters
+    bool has_same_parameters(Checkpoint const& other) const
+    {
+        return seed == other.seed and
+               number_of_iterations == other.number_of_iterations and
+               number_of_data_entries == other.number_of_data_entries and
+               shuffle_data_input == other.shuffle_data_input and
+               sigma == other.sigma and
+               damping == other.damping and
+               max_update_distance == other.max_update_distance and
+               decay_type == other.decay_type and
+               final_sigma == other.final_sigma and
+               final_damping == other.final_damping and
+               final_max_update_distance == other.final_max_update_distance and
+               som_layout == other.som_layout and
+               som_width == other.som_width and
+               som_height == other.som_height and
+               som_depth == other.som_depth and
+               neuron_dimension == other.neuron_dimension and
+               init == other.init and
+               number_of_rotations == other.number_of_rotations and
+               use_flip == other.use_flip and
+               interpolation == other.interpolation and
+               distribution_function == other.distribution_function and
+               use_pbc == other.use_pbc and
+               euclidean_distance_dim == other.euclidean_distance_dim and
+               euclidean_distance_shape == other.euclidean_distance_shape and
+               euclidean_distance_type == other.euclidean_distance_type and
+               batch_size == other.batch_size and
+               asynchronous == other.asynchronous and
+               pipelined == other.pipelined;
+    }
+
+    /// Iteration of the next data point
+    uint32_t iteration = 0;
+
+    /// Position of the next data point within the shuffled order of the iteration
+    uint32_t position = 0;
+
+    /// Number of written intermediate SOMs (--inter-store keep)
+    uint32_t intermediate_count = 0;
+
+    uint32_t seed = 0;
+    uint32_t number_of_iterations = 0;
+    uint32_t number_of_data_entries = 0;
+    bool shuffle_data_input = true;
+
+    /// Parameters of the decay schedule
+    float sigma = 0.0f;
+    float damping = 0.0f;
+    float max_update_distance = 0.0f;
+    DecayType decay_type = DecayType::OFF;
+    float final_sigma = 0.0f;
+    float final_damping = 0.0f;
+    float final_max_update_distance = 0.0f;
+
+    /// Layouts of SOM and neurons
+    Layout som_layout = Layout::CARTESIAN;
+    uint32_t som_width = 0;
+    uint32_t som_height = 0;
+    uint32_t som_depth = 0;
+    std::vector<uint32_t> neuron_dimension;
+    SOMInitialization init = SOMInitialization::ZERO;
+
+    /// Parameters of the best match search and the update
+    uint32_t number_of_rotations = 0;
+    bool use_flip = true;
+    Interpolation interpolation = Interpolation::BILINEAR;
+    DistributionFunction distribution_function = DistributionFunction::GAUSSIAN;
+    bool use_pbc = false;
+    uint32_t euclidean_distance_dim = 0;
+    EuclideanDistanceShape euclidean_distance_shape = EuclideanDistanceShape::QUADRATIC;
+    DataType euclidean_distance_type = DataType::UINT8;
+
+    /// Training mode
+    uint32_t batch_size = 1;
+    bool asynchronous = false;
+    bool pipelined = false;
+};
+
+namespace detail {
+
+template <typename V>
+void write_value(std::ostream& os, V const& value)
+{
+    os.write(reinterpret_cast<char const*>(&value), sizeof(V));
+}
+
+template <typename V>
+void read_value(std::istream& is, V& value)
+{
+    is.read(reinterpret_cast<char*>(&value), sizeof(V));
+}
+
+/// Call func for all fields of the checkpoint in the order of the file format
+template <typename C, typename F>
+void for_each_checkpoint_field(C& checkpoint, F&& func)
+{
+    func(checkpoint.iteration);
+    func(checkpoint.position);
+    func(checkpoint.intermediate_count);
+    func(checkpoint.seed);
+    func(checkpoint.number_of_iterations);
+    func(checkpoint.number_of_data_entries);
+    func(checkpoint.shuffle_data_input);
+    func(checkpoint.sigma);
+    func(checkpoint.damping);
+    func(checkpoint.max_update_distance);
+    func(checkpoint.decay_type);
+    func(checkpoint.final_sigma);
+    func(checkpoint.final_damping);
+    func(checkpoint.final_max_update_distance);
+    func(checkpoint.som_layout);
+    func(checkpoint.som_width);
+    func(checkpoint.som_height);
+    func(checkpoint.som_depth);
+    func(checkpoint.neuron_dimension);
+    func(checkpoint.init);
+    func(checkpoint.number_of_rotations);
+    func(checkpoint.use_flip);
+    func(checkpoint.interpolation);
+    func(checkpoint.distribution_function);
+    func(checkpoint.use_pbc);
+    func(checkpoint.euclidean_distance_dim);
+    func(checkpoint.euclidean_distance_shape);
+    func(checkpoint.euclidean_distance_type);
+    func(checkpoint.batch_size);
+    func(checkpoint.asynchronous);
+    func(checkpoint.pipelined);
+}
+
+/// Fields are written as 32-bit floats or 32-bit integers, a list of dimensions with its size first
+inline void write_checkpoint_fields(std::ostream& os, Checkpoint const& checkpoint)
+{
+    for_each_checkpoint_field(checkpoint, [&os](auto const& field)
+    {
+        using V = std::decay_t<decltype(field)>;
+        if constexpr (std::is_same_v<V, float>) {
+            write_value(os, field);
+        } else if constexpr (std::is_same_v<V, std::vector<uint32_t>>) {
+            write_value(os, static_cast<uint32_t>(field.size()));
+            for (auto d : field) write_value(os, d);
+        } else {
+            write_value(os, static_cast<int32_t>(field));
+        }
+    });
+}
+
+inline void read_checkpoint_fields(std::istream& is, Checkpoint& checkpoint)
+{
+    for_each_checkpoint_field(checkpoint, [&is](auto& field)
+    {
+        using V = std::decay_t<decltype(field)>;
+        if constexpr (std::is_same_v<V, float>) {
+            read_value(is, field);
+        } else if constexpr (std::is_same_v<V, std::vector<uint32_t>>) {
+            uint32_t size = 0;
+            read_value(is, size);
+            if (size > 3) throw pink::exception("Wrong dimensionality in checkpoint");
+            field.resize(size);
+            for (auto& d : field) read_value(is, d);
+        } else {
+            int32_t value = 0;
+            read_value(is, value);
+            if constexpr (std::is_same_v<V, bool>) field = value != 0;
+            else field = static_cast<V>(value);
+        }
+    });
+}
+
+} // namespace detail
+
+/// Write SOM, update counters and training state in binary mode.
+/// The file is first written to filename.tmp and then renamed, so that an interruption
+/// during writing will never leave a corrupted checkpoint.
+template <typename SOMLayout, typename NeuronLayout, typename T>
+void write_checkpoint(std::string const& filename, Checkpoint const& checkpoint,
+    SOM<SOMLayout, NeuronLayout, T> const& som, Data<SOMLayout, uint32_t> const& update_info)
+{
+    std::string tmp_filename = filename + ".tmp";
+    {
+        std::ofstream os(tmp_filename, std::ios::binary);
+        if (!os) throw pink::exception("Error opening " + tmp_filename);
+
+        // <file format version> 4 <state> <SOM size> <SOM> <update counters>
+        int version = 2;
+        int file_type = 4;
+        detail::write_value(os, version);
+        detail::write_value(os, file_type);
+        detail::write_checkpoint_fields(os, checkpoint);
+
+        uint64_t som_size = som.size();
+        detail::write_value(os, som_size);
+        os.write(reinterpret_cast<char const*>(som.get_data_pointer()), static_cast<std::streamsize>(som_size * sizeof(T)));
+        os.write(reinterpret_cast<char const*>(update_info.get_data_pointer()),
+            static_cast<std::streamsize>(update_info.size() * sizeof(uint32_t)));
+
+        os.flush();
+        if (!os) throw pink::exception("Error writing " + tmp_filename);
+    }
+    if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+        throw pink::exception("Error renaming " + tmp_filename + " to " + filename);
+    }
+}
+
+/// Read SOM, update counters and training state in binary mode
+template <typename SOMLayout, typename NeuronLayout, typename T>
+Checkpoint read_checkpoint(std::string const& filename,
+    SOM<SOMLayout, NeuronLayout, T>& som, Data<SOMLayout, uint32_t>& update_info)
+{
+    std::ifstream is(filename, std::ios::binary);
+    if (!is) throw pink::exception("Error opening " + filename);
+
+    int version, file_type;
+    detail::read_value(is, version);
+    detail::read_value(is, file_type);
+    if (version != 2 or file_type != 4) throw pink::exception(filename + " is not a checkpoint file");
+
+    Checkpoint checkpoint;
+    detail::read_checkpoint_fields(is, checkpoint);
+
+    uint64_t som_size;
+    detail::read_value(is, som_size);
+    if (som_size != som.size()) throw pink::exception("SOM size of checkpoint " + filename + " does not fit");
+
+    is.read(reinterpret_cast<char*>(som.get_data_pointer()), static_cast<std::streamsize>(som_size * sizeof(T)));
+    is.read(reinterpret_cast<char*>(update_info.get_data_pointer()),
+        static_cast<std::streamsize>(update_info.size() * sizeof(uint32_t)));
+    if (!is) throw pink::exception("Error reading " + filename);
+
+    return checkpoint;
+}
+
+} // namespace pink
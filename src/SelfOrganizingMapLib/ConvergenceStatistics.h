@@ -0,0 +1,139 @@
+/**
+ * @file   SelfOrganizingMapLib/ConvergenceStatistics.h
+ * @brief  Statistics of the best matching neurons of a training iteration
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "UtilitiesLib/pink_exception.h"
+
+namespace pink {
+
+/// Convergence measures of a single iteration
+struct IterationStatistics
+{
+    /// Mean euclidean distance between the data points and their best matching neurons
+    double mean_quantization_error = 0.0;
+
+    /// Fraction of data points whose best matching neuron changed since the previous iteration.
+    /// Equal to one if there is no previous iteration.
+    double best_match_churn = 1.0;
+
+    /// Entropy of the number of best matches per neuron, normalized to [0, 1].
+    /// One if all neurons are used equally, zero if a single neuron wins all data points.
+    double update_entropy = 0.0;
+
+    /// Number of data points of the iteration
+    uint32_t number_of_data_points = 0;
+};
+
+/// Pretty printing of IterationStatistics
+inline std::ostream& operator << (std::ostream& os, IterationStatistics const& statistics)
+{
+    return os << "mean quantization error = " << statistics.mean_quantization_error
+              << ", best match churn = " << statistics.best_match_churn
+              << ", update entropy = " << statistics.update_entropy;
+}
+
+/// Collects the best match and its euclidean distance, which are calculated by the training anyway,
+/// so that the convergence can be monitored without any additional distance calculation.
+/// The best match of each data point is stored to calculate the churn between two iterations,
+/// therefore each data point is identified by its index in the data file.
+class ConvergenceStatistics
+{
+public:
+
+    /// Marks data points which are not trained in the current iteration
+    static constexpr uint32_t no_best_match = 0;
+
+    ConvergenceStatistics(uint32_t number_of_data_entries, uint32_t som_size)
+     : m_som_size(som_size),
+       m_best_matches(number_of_data_entries, no_best_match),
+       m_previous_best_matches(number_of_data_entries, no_best_match)
+    {}
+
+    /// Add the best match of a data point with the squared euclidean distance of the training, not thread-safe
+    void add(uint32_t index, uint32_t best_match, float squared_distance)
+    {
+        if (index >= m_best_matches.size()) throw pink::exception("Data index of convergence statistics out of range");
+        m_best_matches[index] = best_match + 1;
+        m_sum_of_distances += std::sqrt(squared_distance);
+    }
+
+    /// Returns the statistics of the current iteration and starts the next one
+    IterationStatistics finish_iteration()
+    {
+        IterationStatistics statistics;
+
+        uint32_t number_of_comparisons = 0;
+        uint32_t number_of_changes = 0;
+        std::vector<uint32_t> number_of_best_matches(m_som_size, 0);
+        for (size_t i = 0; i < m_best_matches.size(); ++i) {
+            if (m_best_matches[i] == no_best_match) continue;
+            ++statistics.number_of_data_points;
+            ++number_of_best_matches[m_best_matches[i] - 1];
+            if (m_previous_best_matches[i] == no_best_match) continue;
+            ++number_of_comparisons;
+            if (m_previous_best_matches[i] != m_best_matches[i]) ++number_of_changes;
+        }
+
+        if (statistics.number_of_data_points != 0) {
+            statistics.mean_quantization_error = m_sum_of_distances / statistics.number_of_data_points;
+            for (auto n : number_of_best_matches) {
+                if (n == 0) continue;
+                double p = static_cast<double>(n) / statistics.number_of_data_points;
+                statistics.update_entropy -= p * std::log(p);
+            }
+            if (m_som_size > 1) statistics.update_entropy /= std::log(static_cast<double>(m_som_size));
+        }
+        if (number_of_comparisons != 0) {
+            statistics.best_match_churn = static_cast<double>(number_of_changes) / number_of_comparisons;
+        }
+
+        std::swap(m_best_matches, m_previous_best_matches);
+        std::fill(m_best_matches.begin(), m_best_matches.end(), no_best_match);
+        m_sum_of_distances = 0.0;
+
+        return statistics;
+    }
+
+    /// Best match + 1 of each data point in the current iteration, for the reduction across processes
+    std::vector<uint32_t>& get_best_matches() { return m_best_matches; }
+
+    /// Sum of the distances in the current iteration, for the reduction across processes
+    double& get_sum_of_distances() { return m_sum_of_distances; }
+
+private:
+
+    uint32_t m_som_size;
+
+    std::vector<uint32_t> m_best_matches;
+
+    std::vector<uint32_t> m_previous_best_matches;
+
+    double m_sum_of_distances = 0.0;
+};
+
+/// The training has converged if the best matches are stable and the quantization error stagnates.
+/// A negative threshold switches the corresponding criterion off.
+inline bool is_converged(IterationStatistics const& previous, IterationStatistics const& current,
+    double max_best_match_churn, double max_quantization_error_change)
+{
+    if (max_best_match_churn < 0.0 and max_quantization_error_change < 0.0) return false;
+    if (max_best_match_churn >= 0.0 and current.best_match_churn > max_best_match_churn) return false;
+    if (max_quantization_error_change >= 0.0) {
+        if (previous.number_of_data_points == 0) return false;
+        auto change = std::abs(previous.mean_quantization_error - current.mean_quantization_error);
+        if (change > max_quantization_error_change * previous.mean_quantization_error) return false;
+    }
+    return true;
+}
+
+} // namespace pink
@@ -103,6 +103,12 @@ public:
         return &(operator*());
     }
 
+    /// Returns the position of the current entry in the data file
+    uint32_t get_index() const
+    {
+        return count - 1;
+    }
+
 private:
 
     /// Read next entry
@@ -38,7 +38,11 @@ public:
     {}
 
     /// Parameter constructor
-    DataIteratorShuffled(std::istream& is, uint64_t seed, bool do_shuffle = true)
+    ///
+    /// For data-parallel training the shuffled entries are dealt round-robin to number_of_shards
+    /// iterators, which will then only read the entries of their shard.
+    DataIteratorShuffled(std::istream& is, uint64_t seed, bool do_shuffle = true,
+        uint32_t shard = 0, uint32_t number_of_shards = 1)
      : number_of_entries(0),
        is(is),
        header_offset(0),
@@ -68,6 +72,12 @@ public:
             std::shuffle(std::begin(random_list), std::end(random_list), dist);
         }
 
+        if (number_of_shards > 1) {
+            size_t j = 0;
+            for (size_t i = shard; i < random_list.size(); i += number_of_shards) random_list[j++] = random_list[i];
+            random_list.resize(j);
+        }
+
         cur_random_list = std::begin(random_list);
 
         next();
@@ -92,10 +102,11 @@ public:
         return *this;
     }
 
-    /// Addition assignment operator
+    /// Addition assignment operator, moves steps entries forward like DataIterator
     DataIteratorShuffled& operator += (int steps)
     {
-        cur_random_list += steps;
+        cur_random_list += std::min(static_cast<std::ptrdiff_t>(steps - 1),
+            std::distance(cur_random_list, std::cend(random_list)));
         next();
         return *this;
     }
@@ -112,6 +123,12 @@ public:
         return &(operator*());
     }
 
+    /// Returns the position of the current entry in the data file
+    uint32_t get_index() const
+    {
+        return *(cur_random_list - 1);
+    }
+
 private:
 
     /// Read next entry
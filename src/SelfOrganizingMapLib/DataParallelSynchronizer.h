@@ -0,0 +1,139 @@
+/**
+ * @file   SelfOrganizingMapLib/DataParallelSynchronizer.h
+ * @brief  Synchronization of the SOM replicas of data-parallel MPI processes
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#ifdef PINK_USE_MPI
+    #include <mpi.h>
+#endif
+
+#include "ConvergenceStatistics.h"
+#include "Data.h"
+#include "SOM.h"
+
+namespace pink {
+
+#ifdef PINK_USE_MPI
+
+/// MPI datatype corresponding to T
+template <typename T>
+MPI_Datatype get_mpi_datatype();
+
+template <>
+inline MPI_Datatype get_mpi_datatype<float>() { return MPI_FLOAT; }
+
+template <>
+inline MPI_Datatype get_mpi_datatype<uint32_t>() { return MPI_UINT32_T; }
+
+#endif
+
+/// Each process trains its own replica of the SOM with its own shard of the data.
+/// At each synchronization the changes of all replicas since the last synchronization
+/// are summed up, so that each image contributes its update once like in the sequential
+/// training, and all replicas are equal afterwards. The number of images between two
+/// synchronizations must be small compared to the number of images needed to move a
+/// neuron, otherwise the summed changes will overshoot.
+///
+/// Without MPI support, or with a single process, all operations are no-ops and the
+/// training is identical to the sequential one.
+template <typename SOMLayout, typename NeuronLayout, typename T>
+class DataParallelSynchronizer
+{
+public:
+
+    typedef SOM<SOMLayout, NeuronLayout, T> SOMType;
+
+    /// All replicas start with the SOM of rank 0
+    explicit DataParallelSynchronizer(SOMType& som)
+     : m_som(som)
+    {
+#ifdef PINK_USE_MPI
+        MPI_Comm_rank(MPI_COMM_WORLD, &m_rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &m_number_of_ranks);
+
+        if (m_number_of_ranks > 1) {
+            MPI_Bcast(som.get_data_pointer(), static_cast<int>(som.size()), get_mpi_datatype<T>(), 0, MPI_COMM_WORLD);
+            m_reference.assign(som.get_data().begin(), som.get_data().end());
+            m_delta.resize(som.size());
+        }
+#endif
+    }
+
+    DataParallelSynchronizer(DataParallelSynchronizer const&) = delete;
+
+    /// Sum up the changes of all replicas since the last synchronization
+    void operator () ()
+    {
+#ifdef PINK_USE_MPI
+        if (m_number_of_ranks == 1) return;
+
+        auto som = m_som.get_data_pointer();
+        for (size_t i = 0; i < m_delta.size(); ++i) m_delta[i] = som[i] - m_reference[i];
+
+        MPI_Allreduce(MPI_IN_PLACE, m_delta.data(), static_cast<int>(m_delta.size()), get_mpi_datatype<T>(),
+            MPI_SUM, MPI_COMM_WORLD);
+
+        for (size_t i = 0; i < m_delta.size(); ++i) {
+            m_reference[i] += m_delta[i];
+            som[i] = m_reference[i];
+        }
+#endif
+    }
+
+    /// Sum up the update counters of all processes
+    template <typename Layout>
+    void reduce(Data<Layout, uint32_t>& update_info) const
+    {
+#ifdef PINK_USE_MPI
+        if (m_number_of_ranks == 1) return;
+
+        MPI_Allreduce(MPI_IN_PLACE, update_info.get_data_pointer(), static_cast<int>(update_info.size()),
+            get_mpi_datatype<uint32_t>(), MPI_SUM, MPI_COMM_WORLD);
+#else
+        static_cast<void>(update_info);
+#endif
+    }
+
+    /// Combine the convergence statistics of all processes, each data point is trained by a single process
+    void reduce(ConvergenceStatistics& statistics) const
+    {
+#ifdef PINK_USE_MPI
+        if (m_number_of_ranks == 1) return;
+
+        auto&& best_matches = statistics.get_best_matches();
+        MPI_Allreduce(MPI_IN_PLACE, best_matches.data(), static_cast<int>(best_matches.size()),
+            get_mpi_datatype<uint32_t>(), MPI_MAX, MPI_COMM_WORLD);
+        MPI_Allreduce(MPI_IN_PLACE, &statistics.get_sum_of_distances(), 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+#else
+        static_cast<void>(statistics);
+#endif
+    }
+
+    int get_rank() const { return m_rank; }
+
+    int get_number_of_ranks() const { return m_number_of_ranks; }
+
+private:
+
+    /// The replica of this process
+    SOMType& m_som;
+
+    int m_rank = 0;
+
+    int m_number_of_ranks = 1;
+
+    /// Common SOM of all replicas at the last synchronization
+    std::vector<T> m_reference;
+
+    /// Buffer for the changes of the replica
+    std::vector<T> m_delta;
+};
+
+} // namespace pink
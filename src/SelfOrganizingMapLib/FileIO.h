@@ -15,18 +15,10 @@
 
 namespace pink {
 
-//! Write SOM in binary mode
-template <typename SOMLayout, typename NeuronLayout, typename T>
-void write(SOM<SOMLayout, NeuronLayout, T> const& som, std::string const& filename)
+//! Write the layouts of a SOM file in binary mode, which must be followed by the neurons
+template <typename SOMLayout, typename NeuronLayout>
+void write_layout(SOMLayout const& som_layout, NeuronLayout const& neuron_layout, std::ostream& os)
 {
-    std::ofstream os(filename);
-    if (!os) throw std::runtime_error("Error opening " + filename);
-
-    auto&& som_layout = som.get_som_layout();
-    auto&& neuron_layout = som.get_neuron_layout();
-
-    os << som.m_header;
-
     // <file format version> 1 <data-type> <som layout> <neuron layout> <data>
     int version = 2;
     int file_type = 1;
@@ -45,7 +37,24 @@ void write(SOM<SOMLayout, NeuronLayout, T> const& som, std::string const& filena
     os.write(reinterpret_cast<char*>(&neuron_layout_idx), sizeof(int));
     os.write(reinterpret_cast<char*>(&neuron_dimensionality), sizeof(int));
     for (auto d : neuron_layout.m_dimension) os.write(reinterpret_cast<char*>(&d), sizeof(int));
+}
+
+//! Write SOM in binary mode to stream
+template <typename SOMLayout, typename NeuronLayout, typename T>
+void write(SOM<SOMLayout, NeuronLayout, T> const& som, std::ostream& os)
+{
+    os << som.m_header;
+    write_layout(som.get_som_layout(), som.get_neuron_layout(), os);
     os.write(reinterpret_cast<const char*>(som.get_data_pointer()), static_cast<std::streamsize>(som.size() * sizeof(T)));
 }
 
+//! Write SOM in binary mode
+template <typename SOMLayout, typename NeuronLayout, typename T>
+void write(SOM<SOMLayout, NeuronLayout, T> const& som, std::string const& filename)
+{
+    std::ofstream os(filename);
+    if (!os) throw std::runtime_error("Error opening " + filename);
+    write(som, os);
+}
+
 } // namespace pink
@@ -10,16 +10,21 @@
 #include <cstdint>
 #include <functional>
 #include <iostream>
+#include <omp.h>
+#include <tuple>
 #include <vector>
 
 #include "Data.h"
 #include "find_best_match.h"
 #include "generate_rotated_images.h"
 #include "generate_euclidean_distance_matrix.h"
+#include "generate_euclidean_distance_matrix_pixel_major.h"
 #include "SOM.h"
 #include "SOMIO.h"
+#include "Workspace.h"
 #include "UtilitiesLib/Interpolation.h"
 #include "UtilitiesLib/pink_exception.h"
+#include "UtilitiesLib/TransformationLayout.h"
 
 #ifdef __CUDACC__
     #include "CudaLib/CudaLib.h"
@@ -99,27 +104,125 @@ public:
     Mapper(SOM<SOMLayout, DataLayout, T> const& som, int verbosity,
         uint32_t number_of_rotations, bool use_flip,
         Interpolation interpolation, uint32_t euclidean_distance_dim,
-        EuclideanDistanceShape const& euclidean_distance_shape = EuclideanDistanceShape::QUADRATIC)
+        EuclideanDistanceShape const& euclidean_distance_shape = EuclideanDistanceShape::QUADRATIC,
+        TransformationLayout transformation_layout = TransformationLayout::NEURON_MAJOR)
      : MapperCommon<SOMLayout, DataLayout, T>(som, verbosity, number_of_rotations,
-        use_flip, interpolation, euclidean_distance_dim, euclidean_distance_shape)
-    {}
+        use_flip, interpolation, euclidean_distance_dim, euclidean_distance_shape),
+       m_transformation_layout(transformation_layout)
+    {
+        if (transformation_layout == TransformationLayout::PIXEL_MAJOR) {
+            m_euclidean_distance_region = get_euclidean_distance_region(som.get_neuron_layout(),
+                euclidean_distance_dim, euclidean_distance_shape);
+        }
+
+        resize_workspaces(static_cast<size_t>(omp_get_max_threads()));
+    }
 
+    /// Returns the euclidean distance and the best spatial transformation for all neurons
     auto operator () (Data<DataLayout, T> const& data)
     {
-        auto&& spatial_transformed_images = SpatialTransformer<DataLayout>()(data, this->m_number_of_rotations,
-            this->m_use_flip, this->m_interpolation, this->m_som.get_neuron_layout());
-
         std::vector<T> euclidean_distance_matrix(this->m_som.get_number_of_neurons());
         std::vector<uint32_t> best_rotation_matrix(this->m_som.get_number_of_neurons());
 
-        generate_euclidean_distance_matrix(euclidean_distance_matrix, best_rotation_matrix,
-            this->m_som.get_number_of_neurons(), this->m_som.get_data_pointer(),
-            this->m_som.get_neuron_layout(), this->m_number_of_spatial_transformations,
-            spatial_transformed_images, this->m_euclidean_distance_dim, this->m_euclidean_distance_shape);
+        operator()(data, euclidean_distance_matrix.data(), best_rotation_matrix.data());
+        return std::make_tuple(euclidean_distance_matrix, best_rotation_matrix);
+    }
+
+    /// Writes the euclidean distance and the best spatial transformation for all neurons
+    /// into the caller-provided arrays of size number_of_neurons. No heap allocation is needed.
+    void operator () (Data<DataLayout, T> const& data, T *euclidean_distance_matrix, uint32_t *best_rotation_matrix)
+    {
+        map(data, m_workspaces[0], euclidean_distance_matrix, best_rotation_matrix);
+    }
+
+    /// Returns the euclidean distances and the best spatial transformations of all data points of the batch,
+    /// each of size batch size x number_of_neurons in the order of the batch
+    auto operator () (std::vector<Data<DataLayout, T>> const& batch)
+    {
+        auto size = batch.size() * this->m_som.get_number_of_neurons();
+        std::vector<T> euclidean_distance_matrix(size);
+        std::vector<uint32_t> best_rotation_matrix(size);
 
-        for (auto& e : euclidean_distance_matrix) e = std::sqrt(e);
+        operator()(batch, euclidean_distance_matrix.data(), best_rotation_matrix.data());
         return std::make_tuple(euclidean_distance_matrix, best_rotation_matrix);
     }
+
+    /// Mapping a batch of data points
+    ///
+    /// The data points are independent and mapped concurrently against the unchanged SOM,
+    /// each one by a single thread with its own workspace. The results of data point b are written
+    /// at the offset b * number_of_neurons of the caller-provided arrays, i.e. in the order of the batch.
+    /// The results are the same as mapping the data points one after another.
+    void operator () (std::vector<Data<DataLayout, T>> const& batch, T *euclidean_distance_matrix,
+        uint32_t *best_rotation_matrix)
+    {
+        auto batch_size = static_cast<uint32_t>(batch.size());
+        auto som_size = static_cast<size_t>(this->m_som.get_number_of_neurons());
+        resize_workspaces(static_cast<size_t>(omp_get_max_threads()));
+
+        // A single data point uses the parallelization of the mapping step instead
+        #pragma omp parallel for schedule(dynamic) if(batch_size > 1)
+        for (uint32_t b = 0; b < batch_size; ++b)
+        {
+            map(batch[b], m_workspaces[static_cast<size_t>(omp_get_thread_num())],
+                euclidean_distance_matrix + b * som_size, best_rotation_matrix + b * som_size);
+        }
+    }
+
+private:
+
+    /// Provide at least the given number of workspaces
+    void resize_workspaces(size_t number_of_workspaces)
+    {
+        while (m_workspaces.size() < number_of_workspaces) {
+            m_workspaces.emplace_back(this->m_som.get_number_of_neurons(),
+                this->m_number_of_spatial_transformations * this->m_som.get_neuron_size());
+        }
+    }
+
+    /// Mapping of a single data point using the buffers of the workspace
+    void map(Data<DataLayout, T> const& data, Workspace<T>& workspace, T *euclidean_distance_matrix,
+        uint32_t *best_rotation_matrix) const
+    {
+        SpatialTransformer<DataLayout>()(workspace.spatial_transformed_images, workspace.spatial_transformer_buffer,
+            data, this->m_number_of_rotations, this->m_use_flip, this->m_interpolation,
+            this->m_som.get_neuron_layout());
+
+        workspace.euclidean_distance_matrix.resize(this->m_som.get_number_of_neurons());
+        workspace.best_rotation_matrix.resize(this->m_som.get_number_of_neurons());
+
+        if (m_transformation_layout == TransformationLayout::PIXEL_MAJOR) {
+            interleave_spatial_transformed_images(workspace.interleaved_images,
+                workspace.spatial_transformed_images, this->m_number_of_spatial_transformations,
+                this->m_som.get_neuron_size(), m_euclidean_distance_region);
+
+            generate_euclidean_distance_matrix_pixel_major(workspace.euclidean_distance_matrix,
+                workspace.best_rotation_matrix, this->m_som.get_number_of_neurons(),
+                this->m_som.get_data_pointer(), this->m_som.get_neuron_size(),
+                this->m_number_of_spatial_transformations, workspace.interleaved_images,
+                m_euclidean_distance_region);
+        } else {
+            generate_euclidean_distance_matrix(workspace.euclidean_distance_matrix,
+                workspace.best_rotation_matrix, this->m_som.get_number_of_neurons(),
+                this->m_som.get_data_pointer(), this->m_som.get_neuron_layout(),
+                this->m_number_of_spatial_transformations, workspace.spatial_transformed_images,
+                this->m_euclidean_distance_dim, this->m_euclidean_distance_shape);
+        }
+
+        for (uint32_t i = 0; i < this->m_som.get_number_of_neurons(); ++i) {
+            euclidean_distance_matrix[i] = std::sqrt(workspace.euclidean_distance_matrix[i]);
+            best_rotation_matrix[i] = workspace.best_rotation_matrix[i];
+        }
+    }
+
+    /// Memory layout of the spatial transformed images for the euclidean distance
+    TransformationLayout m_transformation_layout;
+
+    /// Pixel indices of the euclidean distance region (only pixel-major)
+    std::vector<uint32_t> m_euclidean_distance_region;
+
+    /// Reused buffers of the mapping steps, one for each thread
+    std::vector<Workspace<T>> m_workspaces;
 };
 
 
@@ -177,8 +280,20 @@ public:
         }
     }
 
-    /// Training the SOM by a single data point
+    /// Returns the euclidean distance and the best spatial transformation for all neurons
     auto operator () (Data<DataLayout, T> const& data)
+    {
+        std::vector<float> euclidean_distance_matrix(this->m_som.get_number_of_neurons());
+        std::vector<uint32_t> best_rotation_matrix(this->m_som.get_number_of_neurons());
+
+        operator()(data, euclidean_distance_matrix.data(), best_rotation_matrix.data());
+        return std::make_tuple(euclidean_distance_matrix, best_rotation_matrix);
+    }
+
+    /// Writes the euclidean distance and the best spatial transformation for all neurons
+    /// into the caller-provided arrays of size number_of_neurons
+    void operator () (Data<DataLayout, T> const& data, float *euclidean_distance_matrix,
+        uint32_t *best_rotation_matrix)
     {
         /// Device memory for data
         thrust::device_vector<T> d_data = data.get_data();
@@ -195,16 +310,14 @@ public:
             d_spatial_transformed_images, m_block_size, m_euclidean_distance_type, this->m_euclidean_distance_dim,
             this->m_euclidean_distance_shape, d_circle_offset, d_circle_delta);
 
-        std::vector<float> euclidean_distance_matrix(this->m_som.get_number_of_neurons());
-        std::vector<uint32_t> best_rotation_matrix(this->m_som.get_number_of_neurons());
-
         thrust::copy(d_euclidean_distance_matrix.begin(),
-            d_euclidean_distance_matrix.end(), &euclidean_distance_matrix[0]);
+            d_euclidean_distance_matrix.end(), euclidean_distance_matrix);
         thrust::copy(d_best_rotation_matrix.begin(),
-            d_best_rotation_matrix.end(), &best_rotation_matrix[0]);
+            d_best_rotation_matrix.end(), best_rotation_matrix);
 
-        for (auto& e : euclidean_distance_matrix) e = std::sqrt(e);
-        return std::make_tuple(euclidean_distance_matrix, best_rotation_matrix);
+        for (uint32_t i = 0; i < this->m_som.get_number_of_neurons(); ++i) {
+            euclidean_distance_matrix[i] = std::sqrt(euclidean_distance_matrix[i]);
+        }
     }
 
 private:
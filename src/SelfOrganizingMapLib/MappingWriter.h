@@ -0,0 +1,117 @@
+/**
+ * @file   SelfOrganizingMapLib/MappingWriter.h
+ * @brief  Writing the euclidean distances and best spatial transformations of the mapping
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "UtilitiesLib/pink_exception.h"
+
+namespace pink {
+
+/// Writes the mapping result file (file type 2) and optionally the file of the best rotations and
+/// flips (file type 3). The records of the data points have a fixed size, so that they can be written
+/// in any order, e.g. in the shuffled order of a training iteration. Each record is placed at the
+/// position of its data point in the data file.
+template <typename SOMLayout>
+class MappingWriter
+{
+public:
+
+    /// No file of best rotations and flips is written, if rot_flip_filename is empty
+    MappingWriter(std::string const& filename, std::string const& rot_flip_filename, SOMLayout const& som_layout,
+        uint32_t number_of_data_entries, uint32_t number_of_rotations)
+     : m_som_size(static_cast<uint32_t>(som_layout.size())),
+       m_number_of_rotations(number_of_rotations),
+       m_angle_step_radians(static_cast<float>(2.0 * M_PI) / number_of_rotations)
+    {
+        m_result_file.open(filename, std::ios::binary);
+        if (!m_result_file) throw pink::exception("Error opening " + filename);
+
+        // <file format version> 2 <data-type> <number of entries> <som layout> <data>
+        write_header(m_result_file, 2, true, som_layout, number_of_data_entries);
+        m_result_header_size = m_result_file.tellp();
+
+        if (!rot_flip_filename.empty()) {
+            m_spatial_transformation_file.open(rot_flip_filename, std::ios::binary);
+            if (!m_spatial_transformation_file) throw pink::exception("Error opening " + rot_flip_filename);
+
+            // <file format version> 3 <number of entries> <som layout> <data>
+            write_header(m_spatial_transformation_file, 3, false, som_layout, number_of_data_entries);
+            m_spatial_transformation_header_size = m_spatial_transformation_file.tellp();
+        }
+    }
+
+    /// Write the euclidean distances and best spatial transformations of all neurons for the data point
+    /// of the given index. Sequential indices are written without repositioning.
+    void operator () (uint32_t index, float const *euclidean_distance_matrix, uint32_t const *best_rotation_matrix)
+    {
+        if (index != m_next_index) {
+            m_result_file.seekp(m_result_header_size +
+                static_cast<std::streamoff>(index) * m_som_size * static_cast<std::streamoff>(sizeof(float)));
+        }
+        m_result_file.write(reinterpret_cast<char const*>(euclidean_distance_matrix),
+            static_cast<std::streamsize>(m_som_size * sizeof(float)));
+
+        if (m_spatial_transformation_file.is_open()) {
+            if (index != m_next_index) {
+                m_spatial_transformation_file.seekp(m_spatial_transformation_header_size +
+                    static_cast<std::streamoff>(index) * m_som_size * static_cast<std::streamoff>(sizeof(char) + sizeof(float)));
+            }
+            for (uint32_t i = 0; i != m_som_size; ++i) {
+                char flip = static_cast<char>(best_rotation_matrix[i] / m_number_of_rotations);
+                float angle = (best_rotation_matrix[i] % m_number_of_rotations) * m_angle_step_radians;
+                m_spatial_transformation_file.write(&flip, sizeof(char));
+                m_spatial_transformation_file.write(reinterpret_cast<char*>(&angle), sizeof(float));
+            }
+        }
+
+        m_next_index = index + 1;
+    }
+
+private:
+
+    static void write_header(std::ofstream& os, int file_type, bool with_data_type, SOMLayout const& som_layout,
+        uint32_t number_of_data_entries)
+    {
+        int version = 2;
+        int data_type_idx = 0;
+        int entries = static_cast<int>(number_of_data_entries);
+        int som_layout_idx = 0;
+        int som_dimensionality = static_cast<int>(SOMLayout::dimensionality);
+
+        os.write(reinterpret_cast<char*>(&version), sizeof(int));
+        os.write(reinterpret_cast<char*>(&file_type), sizeof(int));
+        if (with_data_type) os.write(reinterpret_cast<char*>(&data_type_idx), sizeof(int));
+        os.write(reinterpret_cast<char*>(&entries), sizeof(int));
+        os.write(reinterpret_cast<char*>(&som_layout_idx), sizeof(int));
+        os.write(reinterpret_cast<char*>(&som_dimensionality), sizeof(int));
+        for (auto d : som_layout.m_dimension) os.write(reinterpret_cast<char*>(&d), sizeof(int));
+    }
+
+    uint32_t m_som_size;
+
+    uint32_t m_number_of_rotations;
+
+    float m_angle_step_radians;
+
+    std::ofstream m_result_file;
+
+    std::ofstream m_spatial_transformation_file;
+
+    std::streamoff m_result_header_size = 0;
+
+    std::streamoff m_spatial_transformation_header_size = 0;
+
+    /// Index of the data point following the last written one
+    uint32_t m_next_index = 0;
+};
+
+} // namespace pink
@@ -0,0 +1,295 @@
+/**
+ * @file   SelfOrganizingMapLib/ModelParallelTrainer.h
+ * @brief  Training of a SOM whose neurons are distributed across MPI processes
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+#ifdef PINK_USE_MPI
+    #include <mpi.h>
+#endif
+
+#include "Data.h"
+#include "DataParallelSynchronizer.h"
+#include "FileIO.h"
+#include "find_best_match.h"
+#include "generate_euclidean_distance_matrix.h"
+#include "generate_euclidean_distance_matrix_pixel_major.h"
+#include "generate_rotated_images.h"
+#include "pca_initialization.h"
+#include "read_neurons.h"
+#include "SOM.h"
+#include "Trainer.h"
+#include "update_neurons.h"
+#include "Workspace.h"
+#include "UtilitiesLib/InputData.h"
+#include "UtilitiesLib/pink_exception.h"
+
+namespace pink {
+
+/// Each process holds only a contiguous range of neurons (shard), so that the SOM must not
+/// fit into the memory of a single node. The image of rank 0 is broadcast to all processes,
+/// which rotate it and search the best match within their shard. A global argmin reduction
+/// selects the best matching neuron and each process updates the neighbors within its shard.
+/// All distances are calculated like in the sequential training, therefore the trained SOM
+/// is identical for any number of processes.
+///
+/// Without MPI support the single shard covers the whole SOM.
+template <typename SOMLayout, typename DataLayout, typename T>
+class ModelParallelTrainer : public TrainerCommon<SOMLayout, DataLayout, T>
+{
+    typedef SOM<SOMLayout, DataLayout, T> SOMType;
+
+public:
+
+    ModelParallelTrainer(SOMLayout const& som_layout, DataLayout const& neuron_layout,
+        std::function<float(float)> const& distribution_function, int verbosity,
+        uint32_t number_of_rotations, bool use_flip, float max_update_distance,
+        Interpolation interpolation, uint32_t euclidean_distance_dim,
+        EuclideanDistanceShape const& euclidean_distance_shape = EuclideanDistanceShape::QUADRATIC,
+        TransformationLayout transformation_layout = TransformationLayout::NEURON_MAJOR)
+     : TrainerCommon<SOMLayout, DataLayout, T>(som_layout, distribution_function, verbosity, number_of_rotations,
+           use_flip, max_update_distance, interpolation, euclidean_distance_dim, euclidean_distance_shape),
+       m_som_layout(som_layout),
+       m_neuron_layout(neuron_layout),
+       m_neuron_size(static_cast<uint32_t>(neuron_layout.size())),
+       m_transformation_layout(transformation_layout)
+    {
+#ifdef PINK_USE_MPI
+        MPI_Comm_rank(MPI_COMM_WORLD, &m_rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &m_number_of_ranks);
+#endif
+        auto number_of_ranks = static_cast<uint32_t>(m_number_of_ranks);
+        if (this->m_som_size < number_of_ranks) throw pink::exception("Number of neurons is smaller than number of processes.");
+
+        m_begin = get_shard_begin(static_cast<uint32_t>(m_rank));
+        m_end = get_shard_begin(static_cast<uint32_t>(m_rank) + 1);
+        m_shard.resize(static_cast<size_t>(m_end - m_begin) * m_neuron_size);
+
+        if (transformation_layout == TransformationLayout::PIXEL_MAJOR) {
+            m_euclidean_distance_region = get_euclidean_distance_region(neuron_layout,
+                euclidean_distance_dim, euclidean_distance_shape);
+        }
+
+        m_workspace = Workspace<T>(m_end - m_begin, this->m_number_of_spatial_transformations * m_neuron_size,
+            static_cast<uint32_t>(this->m_neighborhood_table.get_max_number_of_neighbors()));
+    }
+
+    ModelParallelTrainer(ModelParallelTrainer const&) = delete;
+
+    /// Initialize the shard like SOM(input_data), but without allocating the whole SOM
+    void initialize(InputData const& input_data)
+    {
+        auto shard_size = m_shard.size();
+        auto offset = static_cast<size_t>(m_begin) * m_neuron_size;
+
+        if (input_data.m_init == SOMInitialization::ZERO)
+            fill_value_parallel(m_shard.data(), shard_size);
+        else if (input_data.m_init == SOMInitialization::RANDOM or
+                 input_data.m_init == SOMInitialization::RANDOM_WITH_PREFERRED_DIRECTION) {
+            // The counter-based generator starts directly at the first element of the shard
+            fill_random_uniform_parallel(m_shard.data(), shard_size, input_data.m_seed, offset);
+
+            if (input_data.m_init == SOMInitialization::RANDOM_WITH_PREFERRED_DIRECTION) {
+                for (uint32_t n = 0; n < m_end - m_begin; ++n)
+                    for (uint32_t i = 0; i < input_data.m_neuron_dim; ++i)
+                        m_shard[n * m_neuron_size + i * input_data.m_neuron_dim + i] = 1.0;
+            }
+        }
+        else if (input_data.m_init == SOMInitialization::PCA) {
+            // The principal components are calculated on each process, only the shard is initialized
+            std::ifstream ifs(input_data.m_data_filename);
+            if (!ifs) throw pink::exception("Error opening " + input_data.m_data_filename);
+            initialize_by_pca<DataLayout>(m_shard.data(), ifs, m_som_layout, m_neuron_layout,
+                m_begin, m_end, input_data.m_seed);
+        }
+        else if (input_data.m_init == SOMInitialization::FILEINIT) {
+            // Only the neurons of the shard are read or interpolated
+            m_header = read_neurons(input_data.m_som_filename, m_som_layout, m_neuron_size, m_shard.data(), m_begin, m_end);
+        } else
+            throw pink::exception("Unknown SOMInitialization");
+    }
+
+    /// Initialize the shard by the corresponding neurons of a complete SOM
+    void set_shard(SOMType const& som)
+    {
+        auto begin = som.get_data_pointer() + static_cast<size_t>(m_begin) * m_neuron_size;
+        std::copy(begin, begin + m_shard.size(), m_shard.begin());
+    }
+
+    /// Training the SOM by a single data point, which is given by rank 0.
+    /// On all other processes data must have the right layout and will be overwritten.
+    /// The index of the data point for the convergence statistics is also given by rank 0.
+    void operator () (Data<DataLayout, T>& data, uint32_t index = 0)
+    {
+#ifdef PINK_USE_MPI
+        if (m_number_of_ranks > 1) {
+            MPI_Bcast(data.get_data_pointer(), static_cast<int>(data.size()), get_mpi_datatype<T>(), 0, MPI_COMM_WORLD);
+            if (this->m_statistics) MPI_Bcast(&index, 1, get_mpi_datatype<uint32_t>(), 0, MPI_COMM_WORLD);
+        }
+#endif
+        float distance;
+        auto best_match = find_best_matching_neuron(data, distance);
+        if (this->m_statistics) this->m_statistics->add(index, best_match, distance);
+
+        // Only the neighbors within the shard are updated, the indices are shifted to the shard
+        this->m_neighborhood_table.get_neighbors(best_match, m_workspace.neighbor_indices, m_workspace.neighbor_factors);
+        uint32_t number_of_local_neighbors = 0;
+        for (size_t n = 0; n < m_workspace.neighbor_indices.size(); ++n) {
+            auto i = m_workspace.neighbor_indices[n];
+            if (i < m_begin or i >= m_end) continue;
+            m_workspace.neighbor_indices[number_of_local_neighbors] = i - m_begin;
+            m_workspace.neighbor_factors[number_of_local_neighbors] = m_workspace.neighbor_factors[n];
+            ++number_of_local_neighbors;
+        }
+
+        update_neurons(m_shard.data(), m_neuron_size, m_workspace.spatial_transformed_images.data(),
+            m_workspace.best_rotation_matrix.data(), m_workspace.neighbor_indices.data(),
+            m_workspace.neighbor_factors.data(), number_of_local_neighbors);
+
+        // The best match is known by all processes, the update counters need no reduction
+        ++this->m_update_info[best_match];
+    }
+
+    /// A larger update distance may need larger neighbor buffers
+    void set_neighborhood(std::function<float(float)> const& distribution_function, float max_update_distance)
+    {
+        TrainerCommon<SOMLayout, DataLayout, T>::set_neighborhood(distribution_function, max_update_distance);
+
+        auto max_number_of_neighbors = this->m_neighborhood_table.get_max_number_of_neighbors();
+        m_workspace.neighbor_indices.reserve(max_number_of_neighbors);
+        m_workspace.neighbor_factors.reserve(max_number_of_neighbors);
+    }
+
+    /// Write the SOM file by rank 0, which receives the shards one after another.
+    /// Must be called by all processes.
+    void write(std::string const& filename) const
+    {
+        std::ofstream os;
+        if (m_rank == 0) {
+            os.open(filename);
+            if (!os) throw pink::exception("Error opening " + filename);
+            os << m_header;
+            write_layout(m_som_layout, m_neuron_layout, os);
+            os.write(reinterpret_cast<char const*>(m_shard.data()), static_cast<std::streamsize>(m_shard.size() * sizeof(T)));
+        }
+#ifdef PINK_USE_MPI
+        std::vector<T> buffer;
+        for (int rank = 1; rank < m_number_of_ranks; ++rank) {
+            if (m_rank == 0) {
+                buffer.resize(static_cast<size_t>(get_shard_begin(static_cast<uint32_t>(rank) + 1)
+                    - get_shard_begin(static_cast<uint32_t>(rank))) * m_neuron_size);
+                MPI_Recv(buffer.data(), static_cast<int>(buffer.size()), get_mpi_datatype<T>(), rank, 0,
+                    MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+                os.write(reinterpret_cast<char const*>(buffer.data()), static_cast<std::streamsize>(buffer.size() * sizeof(T)));
+            } else if (m_rank == rank) {
+                MPI_Send(m_shard.data(), static_cast<int>(m_shard.size()), get_mpi_datatype<T>(), 0, 0, MPI_COMM_WORLD);
+            }
+        }
+#endif
+        if (m_rank == 0 and !os) throw pink::exception("Error writing " + filename);
+    }
+
+    /// Neurons of this process
+    std::vector<T> const& get_shard() const { return m_shard; }
+
+    /// Index of the first neuron of this process
+    uint32_t get_begin() const { return m_begin; }
+
+    /// Index behind the last neuron of this process
+    uint32_t get_end() const { return m_end; }
+
+    int get_rank() const { return m_rank; }
+
+    int get_number_of_ranks() const { return m_number_of_ranks; }
+
+private:
+
+    /// The neurons are distributed as equally as possible
+    uint32_t get_shard_begin(uint32_t rank) const
+    {
+        return static_cast<uint32_t>(static_cast<uint64_t>(this->m_som_size) * rank / static_cast<uint32_t>(m_number_of_ranks));
+    }
+
+    /// Returns the global index of the best matching neuron of all processes and its distance
+    uint32_t find_best_matching_neuron(Data<DataLayout, T> const& data, float& distance)
+    {
+        auto shard_size = m_end - m_begin;
+
+        SpatialTransformer<DataLayout>()(m_workspace.spatial_transformed_images, m_workspace.spatial_transformer_buffer,
+            data, this->m_number_of_rotations, this->m_use_flip, this->m_interpolation, m_neuron_layout);
+
+        m_workspace.euclidean_distance_matrix.resize(shard_size);
+        m_workspace.best_rotation_matrix.resize(shard_size);
+
+        if (m_transformation_layout == TransformationLayout::PIXEL_MAJOR) {
+            interleave_spatial_transformed_images(m_workspace.interleaved_images,
+                m_workspace.spatial_transformed_images, this->m_number_of_spatial_transformations,
+                m_neuron_size, m_euclidean_distance_region);
+
+            generate_euclidean_distance_matrix_pixel_major(m_workspace.euclidean_distance_matrix,
+                m_workspace.best_rotation_matrix, shard_size, m_shard.data(), m_neuron_size,
+                this->m_number_of_spatial_transformations, m_workspace.interleaved_images, m_euclidean_distance_region);
+        } else {
+            generate_euclidean_distance_matrix(m_workspace.euclidean_distance_matrix,
+                m_workspace.best_rotation_matrix, shard_size, m_shard.data(), m_neuron_layout,
+                this->m_number_of_spatial_transformations, m_workspace.spatial_transformed_images,
+                this->m_euclidean_distance_dim, this->m_euclidean_distance_shape);
+        }
+
+        auto local_best_match = find_best_match(m_workspace.euclidean_distance_matrix, shard_size);
+
+#ifdef PINK_USE_MPI
+        if (m_number_of_ranks > 1) {
+            // On equal distances MPI_MINLOC selects the lower index like find_best_match
+            struct { float distance; int index; } best_match;
+            best_match.distance = static_cast<float>(m_workspace.euclidean_distance_matrix[local_best_match]);
+            best_match.index = static_cast<int>(m_begin + local_best_match);
+            MPI_Allreduce(MPI_IN_PLACE, &best_match, 1, MPI_FLOAT_INT, MPI_MINLOC, MPI_COMM_WORLD);
+            distance = best_match.distance;
+            return static_cast<uint32_t>(best_match.index);
+        }
+#endif
+        distance = static_cast<float>(m_workspace.euclidean_distance_matrix[local_best_match]);
+        return m_begin + local_best_match;
+    }
+
+    SOMLayout m_som_layout;
+
+    DataLayout m_neuron_layout;
+
+    uint32_t m_neuron_size;
+
+    /// Memory layout of the spatial transformed images for the euclidean distance
+    TransformationLayout m_transformation_layout;
+
+    /// Pixel indices of the euclidean distance region (only pixel-major)
+    std::vector<uint32_t> m_euclidean_distance_region;
+
+    int m_rank = 0;
+
+    int m_number_of_ranks = 1;
+
+    /// Range [m_begin, m_end) of the neurons of this process
+    uint32_t m_begin = 0;
+    uint32_t m_end = 0;
+
+    /// Neurons of this process
+    std::vector<T> m_shard;
+
+    /// Header of initialization SOM, will be copied to resulting SOM
+    std::string m_header;
+
+    /// Buffers of the training step, the distance matrices cover only the shard
+    Workspace<T> m_workspace;
+};
+
+} // namespace pink
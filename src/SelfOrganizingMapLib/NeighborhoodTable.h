@@ -0,0 +1,283 @@
+/**
+ * @file   SelfOrganizingMapLib/NeighborhoodTable.h
+ * @brief  Compact storage of the SOM update factors
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace pink {
+
+/// The update factor of a neuron depends only on the layout offset to the best matching neuron.
+/// Instead of a dense som_size x som_size matrix, the factors are stored for all non-zero
+/// offsets within the bounding box of the layout, together with a position grid mapping
+/// layout positions back to neuron indices. Both need O(som_size) memory.
+///
+/// The offsets are grouped in classes of equal distance, so that a new distribution function
+/// must only be evaluated once per distance class (see update).
+template <typename SOMLayout>
+class NeighborhoodTable
+{
+public:
+
+    static const uint8_t dimensionality = SOMLayout::dimensionality;
+
+    typedef typename SOMLayout::DimensionType DimensionType;
+    typedef std::array<int32_t, dimensionality> OffsetType;
+
+    /// Marks grid positions which are not occupied by a neuron
+    static constexpr uint32_t invalid_index = std::numeric_limits<uint32_t>::max();
+
+    NeighborhoodTable(SOMLayout const& som_layout, std::function<float(float)> const& distribution_function,
+        float max_update_distance)
+     : m_som_size(static_cast<uint32_t>(som_layout.size())),
+       m_positions(m_som_size)
+    {
+        m_grid_dimension.fill(1);
+        for (uint32_t i = 0; i < m_som_size; ++i) {
+            m_positions[i] = som_layout.get_position(i);
+            for (uint8_t d = 0; d < dimensionality; ++d) {
+                m_grid_dimension[d] = std::max(m_grid_dimension[d], m_positions[i][d] + 1);
+            }
+        }
+
+        size_t grid_size = 1;
+        for (uint8_t d = 0; d < dimensionality; ++d) {
+            m_grid_stride[d] = static_cast<uint32_t>(grid_size);
+            grid_size *= m_grid_dimension[d];
+        }
+
+        m_grid.resize(grid_size, invalid_index);
+        for (uint32_t i = 0; i < m_som_size; ++i) m_grid[get_grid_index(m_positions[i])] = i;
+
+        // Table of all offsets [-(grid_dimension - 1), grid_dimension - 1], non-zero factors are listed
+        size_t table_size = 1;
+        for (uint8_t d = 0; d < dimensionality; ++d) {
+            m_table_stride[d] = static_cast<uint32_t>(table_size);
+            table_size *= 2 * m_grid_dimension[d] - 1;
+        }
+
+        m_table_center = 0;
+        for (uint8_t d = 0; d < dimensionality; ++d) m_table_center += (m_grid_dimension[d] - 1) * m_table_stride[d];
+
+        m_table_positions.resize(m_som_size);
+        for (uint32_t i = 0; i < m_som_size; ++i) {
+            m_table_positions[i] = 0;
+            for (uint8_t d = 0; d < dimensionality; ++d) m_table_positions[i] += m_positions[i][d] * m_table_stride[d];
+        }
+
+        std::vector<float> distances(table_size);
+        for (size_t t = 0; t < table_size; ++t)
+        {
+            // Both positions are shifted by grid_dimension - 1 to stay positive
+            DimensionType p1, p2;
+            for (uint8_t d = 0; d < dimensionality; ++d) {
+                p1[d] = static_cast<uint32_t>(t / m_table_stride[d] % (2 * m_grid_dimension[d] - 1));
+                p2[d] = m_grid_dimension[d] - 1;
+            }
+            distances[t] = som_layout.get_distance(p1, p2);
+        }
+
+        m_distances = distances;
+        std::sort(m_distances.begin(), m_distances.end());
+        m_distances.erase(std::unique(m_distances.begin(), m_distances.end()), m_distances.end());
+
+        m_distance_class.resize(table_size);
+        for (size_t t = 0; t < table_size; ++t) {
+            m_distance_class[t] = static_cast<uint32_t>(std::distance(m_distances.begin(),
+                std::lower_bound(m_distances.begin(), m_distances.end(), distances[t])));
+        }
+
+        m_table.resize(table_size);
+        update(distribution_function, max_update_distance);
+    }
+
+    /// Recalculate all update factors for a new distribution function and maximal update distance.
+    /// The effort is one evaluation of the distribution function for each distance class
+    /// and a linear pass over the table.
+    void update(std::function<float(float)> const& distribution_function, float max_update_distance)
+    {
+        std::vector<float> class_factors(m_distances.size(), 0.0f);
+        for (size_t c = 0; c < m_distances.size(); ++c) {
+            if (max_update_distance <= 0 or m_distances[c] < max_update_distance) {
+                class_factors[c] = distribution_function(m_distances[c]);
+            }
+        }
+
+        m_offsets.clear();
+        m_offset_factors.clear();
+        for (size_t t = 0; t < m_table.size(); ++t)
+        {
+            float factor = class_factors[m_distance_class[t]];
+            m_table[t] = factor;
+            if (factor == 0.0f) continue;
+
+            OffsetType offset;
+            for (uint8_t d = 0; d < dimensionality; ++d) {
+                offset[d] = static_cast<int32_t>(t / m_table_stride[d] % (2 * m_grid_dimension[d] - 1))
+                          - static_cast<int32_t>(m_grid_dimension[d] - 1);
+            }
+            m_offsets.push_back(offset);
+            m_offset_factors.push_back(factor);
+        }
+    }
+
+    /// Returns the update factor of neuron i for the best matching neuron
+    float get_factor(uint32_t best_match, uint32_t i) const
+    {
+        return m_table[get_table_index(best_match, i)];
+    }
+
+    /// Returns the distance of neuron i to the best matching neuron
+    float get_distance(uint32_t best_match, uint32_t i) const
+    {
+        return m_distances[m_distance_class[get_table_index(best_match, i)]];
+    }
+
+    /// Collect all neurons with a non-zero update factor for the best matching neuron
+    void get_neighbors(uint32_t best_match, std::vector<uint32_t>& neuron_indices, std::vector<float>& factors) const
+    {
+        neuron_indices.clear();
+        factors.clear();
+
+        auto&& center = m_positions[best_match];
+        for (size_t n = 0; n < m_offsets.size(); ++n)
+        {
+            auto index = get_neuron_index(center, m_offsets[n]);
+            if (index == invalid_index) continue;
+
+            neuron_indices.push_back(index);
+            factors.push_back(m_offset_factors[n]);
+        }
+    }
+
+    /// Define the window of get_window by the maximal distance to its center
+    void set_window(float radius)
+    {
+        m_window_radius = radius;
+        m_window_offsets.clear();
+        for (size_t t = 0; t < m_table.size(); ++t)
+        {
+            if (m_distances[m_distance_class[t]] > radius) continue;
+
+            OffsetType offset;
+            for (uint8_t d = 0; d < dimensionality; ++d) {
+                offset[d] = static_cast<int32_t>(t / m_table_stride[d] % (2 * m_grid_dimension[d] - 1))
+                          - static_cast<int32_t>(m_grid_dimension[d] - 1);
+            }
+            m_window_offsets.push_back(offset);
+        }
+    }
+
+    /// Collect all neurons within the window radius around the center neuron
+    void get_window(uint32_t center, std::vector<uint32_t>& neuron_indices) const
+    {
+        neuron_indices.clear();
+        for (auto&& offset : m_window_offsets)
+        {
+            auto index = get_neuron_index(m_positions[center], offset);
+            if (index != invalid_index) neuron_indices.push_back(index);
+        }
+    }
+
+    float get_window_radius() const { return m_window_radius; }
+
+    /// Update factors of all offsets. The factor of neuron i for the best matching neuron is at
+    /// get_table_center() + get_table_positions()[i] - get_table_positions()[best_match],
+    /// which needs no other lookup, e.g. for the GPU update.
+    std::vector<float> const& get_table() const { return m_table; }
+
+    /// Index of the zero offset in the table
+    uint32_t get_table_center() const { return m_table_center; }
+
+    /// Position of each neuron in the table relative to the zero offset
+    std::vector<uint32_t> const& get_table_positions() const { return m_table_positions; }
+
+    /// Returns the maximal number of neighbors of a best matching neuron
+    auto get_max_number_of_neighbors() const { return std::min(m_offsets.size(), static_cast<size_t>(m_som_size)); }
+
+    /// Returns the largest distance between two neurons
+    float get_max_distance() const { return m_distances.back(); }
+
+private:
+
+    size_t get_grid_index(DimensionType const& p) const
+    {
+        size_t g = 0;
+        for (uint8_t d = 0; d < dimensionality; ++d) g += p[d] * m_grid_stride[d];
+        return g;
+    }
+
+    /// Index of the offset of neuron i to the best matching neuron in the table
+    size_t get_table_index(uint32_t best_match, uint32_t i) const
+    {
+        return static_cast<size_t>(m_table_center) + m_table_positions[i] - m_table_positions[best_match];
+    }
+
+    /// Returns the neuron at the offset to the center position, or invalid_index if there is none
+    uint32_t get_neuron_index(DimensionType const& center, OffsetType const& offset) const
+    {
+        size_t g = 0;
+        for (uint8_t d = 0; d < dimensionality; ++d) {
+            auto pos = static_cast<int64_t>(center[d]) + offset[d];
+            if (pos < 0 or pos >= m_grid_dimension[d]) return invalid_index;
+            g += static_cast<size_t>(pos) * m_grid_stride[d];
+        }
+        return m_grid[g];
+    }
+
+    /// Number of neurons
+    uint32_t m_som_size;
+
+    /// Layout position of each neuron
+    std::vector<DimensionType> m_positions;
+
+    /// Bounding box of all layout positions
+    DimensionType m_grid_dimension;
+
+    /// Strides of the position grid
+    DimensionType m_grid_stride;
+
+    /// Neuron index of each grid position
+    std::vector<uint32_t> m_grid;
+
+    /// Strides of the offset table
+    DimensionType m_table_stride;
+
+    /// Update factor of each offset
+    std::vector<float> m_table;
+
+    /// Table index of the zero offset
+    uint32_t m_table_center;
+
+    /// Table index of the position of each neuron, without the zero offset
+    std::vector<uint32_t> m_table_positions;
+
+    /// Sorted distances of all distance classes
+    std::vector<float> m_distances;
+
+    /// Distance class of each offset
+    std::vector<uint32_t> m_distance_class;
+
+    /// Offsets with a non-zero update factor
+    std::vector<OffsetType> m_offsets;
+
+    /// Update factors corresponding to m_offsets
+    std::vector<float> m_offset_factors;
+
+    /// Maximal distance of the window to its center
+    float m_window_radius = 0.0f;
+
+    /// Offsets within the window radius
+    std::vector<OffsetType> m_window_offsets;
+};
+
+} // namespace pink
@@ -9,13 +9,16 @@
 #include <array>
 #include <fstream>
 #include <functional>
+#include <utility>
 #include <vector>
 
 #include "CartesianLayout.h"
 #include "Data.h"
 #include "HexagonalLayout.h"
+#include "pca_initialization.h"
+#include "read_neurons.h"
+#include "UtilitiesLib/DefaultInitAllocator.h"
 #include "UtilitiesLib/Filler.h"
-#include "UtilitiesLib/get_file_header.h"
 #include "UtilitiesLib/InputData.h"
 #include "UtilitiesLib/get_static_array.h"
 
@@ -60,6 +63,9 @@ public:
     typedef SOM<SOMLayout, NeuronLayout, T> SelfType;
     typedef Data<NeuronLayout, T> NeuronType;
 
+    /// The elements are not zeroed at allocation, but first touched by the initialization
+    typedef std::vector<T, DefaultInitAllocator<T>> StorageType;
+
     /// Default construction
     SOM()
      : m_som_layout{0},
@@ -73,58 +79,59 @@ public:
        m_neuron_layout{get_static_array<NeuronLayout::dimensionality>(input_data.m_neuron_dimension)},
        m_data(m_som_layout.size() * m_neuron_layout.size())
     {
-        // Initialize SOM
+        // Initialize SOM, each branch writes all elements
         if (input_data.m_init == SOMInitialization::ZERO)
-            fill_value(&m_data[0], m_data.size());
+            fill_value_parallel(&m_data[0], m_data.size());
         else if (input_data.m_init == SOMInitialization::RANDOM)
-            fill_random_uniform(&m_data[0], m_data.size(), input_data.m_seed);
+            fill_random_uniform_parallel(&m_data[0], m_data.size(), input_data.m_seed);
         else if (input_data.m_init == SOMInitialization::RANDOM_WITH_PREFERRED_DIRECTION) {
-            fill_random_uniform(&m_data[0], m_data.size(), input_data.m_seed);
+            fill_random_uniform_parallel(&m_data[0], m_data.size(), input_data.m_seed);
             for (uint32_t n = 0; n < input_data.m_som_size; ++n)
                 for (uint32_t i = 0; i < input_data.m_neuron_dim; ++i)
                     m_data[n * input_data.m_neuron_size + i * input_data.m_neuron_dim + i] = 1.0;
         }
+        else if (input_data.m_init == SOMInitialization::PCA) {
+            std::ifstream ifs(input_data.m_data_filename);
+            if (!ifs) throw pink::exception("Error opening " + input_data.m_data_filename);
+            initialize_by_pca<NeuronLayout>(&m_data[0], ifs, m_som_layout, m_neuron_layout,
+                0, static_cast<uint32_t>(m_som_layout.size()), input_data.m_seed);
+        }
         else if (input_data.m_init == SOMInitialization::FILEINIT) {
-            std::ifstream is(input_data.m_som_filename);
-            if (!is) throw pink::exception("Error opening " + input_data.m_som_filename);
-
-            m_header = get_file_header(is);
-
-            // Ignore first three entries
-            is.seekg((9 + SOMLayout::dimensionality) * sizeof(int), is.cur);
-            is.read(reinterpret_cast<char*>(&m_data[0]), static_cast<std::streamsize>(m_data.size() * sizeof(float)));
+            // A SOM of another size will be interpolated
+            m_header = read_neurons(input_data.m_som_filename, m_som_layout, static_cast<uint32_t>(m_neuron_layout.size()),
+                &m_data[0], 0, static_cast<uint32_t>(m_som_layout.size()));
         } else
             throw pink::exception("Unknown SOMInitialization");
     }
 
-    /// Construction without initialization
+    /// Construction without initialization, all elements are zero
     SOM(SOMLayoutType const& som_layout, NeuronLayoutType const& neuron_layout)
-     : m_som_layout(som_layout),
-       m_neuron_layout(neuron_layout),
-       m_data(som_layout.size() * neuron_layout.size())
+     : SOM(som_layout, neuron_layout, T(0))
     {}
 
     /// Construction and initialize all elements to value
     SOM(SOMLayoutType const& som_layout, NeuronLayoutType const& neuron_layout, T value)
      : m_som_layout(som_layout),
        m_neuron_layout(neuron_layout),
-       m_data(som_layout.size() * neuron_layout.size(), value)
-    {}
+       m_data(som_layout.size() * neuron_layout.size())
+    {
+        fill_value_parallel(m_data.data(), m_data.size(), value);
+    }
 
     /// Construction and copy data
     SOM(SOMLayoutType const& som_layout, NeuronLayoutType const& neuron_layout,
         std::vector<T> const& data)
      : m_som_layout(som_layout),
        m_neuron_layout(neuron_layout),
-       m_data(data)
+       m_data(data.begin(), data.end())
     {}
 
-    /// Construction and move data
+    /// Construction and move data, only the storage type can be taken over without copy
     SOM(SOMLayoutType const& som_layout, NeuronLayoutType const& neuron_layout,
-        std::vector<T>&& data)
+        StorageType&& data)
      : m_som_layout(som_layout),
        m_neuron_layout(neuron_layout),
-       m_data(data)
+       m_data(std::move(data))
     {}
 
     auto operator == (SelfType const& other) const
@@ -136,8 +143,8 @@ public:
 
     auto size() const { return m_data.size(); }
 
-    auto get_data() { return m_data; }
-    auto get_data() const { return m_data; }
+    auto get_data() -> StorageType& { return m_data; }
+    auto get_data() const -> StorageType const& { return m_data; }
 
     auto get_data_pointer() { return &m_data[0]; }
     auto get_data_pointer() const { return &m_data[0]; }
@@ -174,7 +181,7 @@ public:
 private:
 
     template <typename A, typename B, typename C>
-    friend void write(SOM<A, B, C> const& som, std::string const& filename);
+    friend void write(SOM<A, B, C> const& som, std::ostream& os);
 
     template <typename A, typename B, typename C>
     friend std::ostream& operator << (std::ostream& os, SOM<A, B, C> const& som);
@@ -186,7 +193,7 @@ private:
     // Header of initialization SOM, will be copied to resulting SOM
     std::string m_header;
 
-    std::vector<T> m_data;
+    StorageType m_data;
 
 };
 
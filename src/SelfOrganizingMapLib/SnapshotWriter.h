@@ -0,0 +1,172 @@
+/**
+ * @file   SelfOrganizingMapLib/SnapshotWriter.h
+ * @brief  Writing SOM snapshots in a background thread
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "FileIO.h"
+#include "SOM.h"
+#include "UtilitiesLib/pink_exception.h"
+
+namespace pink {
+
+/// The training only pays for copying the SOM into the snapshot buffer, the file is written
+/// by a background thread. At most one snapshot is in flight: a new snapshot waits until
+/// the previous one is written. Each file is written to filename.tmp and then renamed,
+/// so that readers will never see a partly written SOM.
+template <typename SOMLayout, typename NeuronLayout, typename T>
+class SnapshotWriter
+{
+public:
+
+    typedef SOM<SOMLayout, NeuronLayout, T> SOMType;
+
+    /// Size of the file buffer
+    static constexpr size_t buffer_size = 16 * 1024 * 1024;
+
+    SnapshotWriter()
+     : m_buffer(buffer_size),
+       m_thread(&SnapshotWriter::run, this)
+    {}
+
+    SnapshotWriter(SnapshotWriter const&) = delete;
+    SnapshotWriter& operator = (SnapshotWriter const&) = delete;
+
+    ~SnapshotWriter()
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]{ return !m_pending; });
+            m_terminate = true;
+        }
+        m_condition.notify_all();
+        m_thread.join();
+    }
+
+    /// Copy the SOM and write it in the background
+    void operator () (SOMType const& som, std::string const& filename)
+    {
+        auto&& start_time = std::chrono::steady_clock::now();
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]{ return !m_pending; });
+            rethrow_error();
+
+            // The snapshot buffer is allocated once and reused afterwards
+            if (m_snapshot) *m_snapshot = som;
+            else m_snapshot = std::make_unique<SOMType>(som);
+            m_filename = filename;
+            m_pending = true;
+        }
+        m_condition.notify_all();
+        m_stall_time += std::chrono::steady_clock::now() - start_time;
+    }
+
+    /// Block until the last snapshot is written
+    void wait()
+    {
+        auto&& start_time = std::chrono::steady_clock::now();
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [this]{ return !m_pending; });
+        m_stall_time += std::chrono::steady_clock::now() - start_time;
+        rethrow_error();
+    }
+
+    /// Returns the total time the caller was blocked
+    double get_stall_time() const { return m_stall_time.count(); }
+
+private:
+
+    void rethrow_error()
+    {
+        if (m_error) {
+            auto error = m_error;
+            m_error = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;)
+        {
+            m_condition.wait(lock, [this]{ return m_pending or m_terminate; });
+            if (!m_pending) return;
+
+            // The snapshot is not touched by the caller while pending
+            lock.unlock();
+            std::exception_ptr error;
+            try {
+                write_file();
+            } catch (...) {
+                error = std::current_exception();
+            }
+            lock.lock();
+
+            m_error = error;
+            m_pending = false;
+            m_condition.notify_all();
+        }
+    }
+
+    void write_file()
+    {
+        std::string tmp_filename = m_filename + ".tmp";
+        {
+            std::ofstream os;
+            os.rdbuf()->pubsetbuf(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+            os.open(tmp_filename, std::ios::binary);
+            if (!os) throw pink::exception("Error opening " + tmp_filename);
+            write(*m_snapshot, os);
+            os.flush();
+            if (!os) throw pink::exception("Error writing " + tmp_filename);
+        }
+        if (std::rename(tmp_filename.c_str(), m_filename.c_str()) != 0) {
+            throw pink::exception("Error renaming " + tmp_filename + " to " + m_filename);
+        }
+    }
+
+    /// Copy of the SOM which is written
+    std::unique_ptr<SOMType> m_snapshot;
+
+    std::string m_filename;
+
+    /// File buffer
+    std::vector<char> m_buffer;
+
+    std::mutex m_mutex;
+
+    std::condition_variable m_condition;
+
+    /// A snapshot is waiting or being written
+    bool m_pending = false;
+
+    /// Stop the background thread
+    bool m_terminate = false;
+
+    /// Exception of the background thread, which will be rethrown to the caller
+    std::exception_ptr m_error;
+
+    /// Time the caller was blocked by waiting and copying
+    std::chrono::duration<double> m_stall_time{0};
+
+    /// Must be the last member, since the thread is started in the constructor
+    std::thread m_thread;
+};
+
+} // namespace pink
@@ -0,0 +1,81 @@
+/**
+ * @file   SelfOrganizingMapLib/SweepTrainer.h
+ * @brief  Training of several SOMs by a single pass of spatial transformations
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Data.h"
+#include "generate_rotated_images.h"
+#include "Trainer.h"
+#include "UtilitiesLib/pink_exception.h"
+
+namespace pink {
+
+/// Hyper-parameter sweep: the SOMs of the trainers may differ in size, distribution function
+/// or initialization, but must share the neuron layout and the spatial transformations.
+/// The spatial transformations of each data point are generated only once and
+/// all trainers are trained in parallel by them, each one by a single thread.
+template <typename SOMLayout, typename DataLayout, typename T>
+class SweepTrainer : public TrainerBase
+{
+    typedef Trainer<SOMLayout, DataLayout, T, false> TrainerType;
+
+public:
+
+    /// The trainers are not owned and must outlive the sweep trainer
+    explicit SweepTrainer(std::vector<TrainerType*> const& trainers)
+     : m_trainers(trainers)
+    {
+        if (trainers.empty()) throw pink::exception("Sweep trainer needs at least one trainer");
+
+        auto&& first = *trainers[0];
+        for (auto&& trainer : trainers) {
+            if (trainer->get_number_of_rotations() != first.get_number_of_rotations() or
+                trainer->get_use_flip() != first.get_use_flip() or
+                trainer->get_interpolation() != first.get_interpolation() or
+                !(trainer->get_neuron_layout() == first.get_neuron_layout())) {
+                throw pink::exception("Trainers of a sweep must have equal neuron layouts and spatial transformations");
+            }
+        }
+    }
+
+    /// Training all SOMs by a single data point, index is the position
+    /// of the data point in the data file for the convergence statistics
+    void operator () (Data<DataLayout, T> const& data, uint32_t index = 0)
+    {
+        auto&& first = *m_trainers[0];
+        SpatialTransformer<DataLayout>()(m_spatial_transformed_images, m_spatial_transformer_buffer, data,
+            first.get_number_of_rotations(), first.get_use_flip(), first.get_interpolation(),
+            first.get_neuron_layout());
+
+        auto number_of_trainers = static_cast<uint32_t>(m_trainers.size());
+
+        #pragma omp parallel for schedule(dynamic)
+        for (uint32_t i = 0; i < number_of_trainers; ++i) {
+            m_trainers[i]->train_spatial_transformed(m_spatial_transformed_images, index);
+        }
+    }
+
+    void update_som()
+    {}
+
+    auto get_number_of_trainers() const { return m_trainers.size(); }
+
+private:
+
+    std::vector<TrainerType*> m_trainers;
+
+    /// Spatial transformed images in neuron-major layout, shared by all trainers
+    std::vector<T> m_spatial_transformed_images;
+
+    /// Buffer of SpatialTransformer (only 3D data)
+    std::vector<T> m_spatial_transformer_buffer;
+};
+
+} // namespace pink
@@ -10,17 +10,31 @@
 #include <cstdint>
 #include <functional>
 #include <iostream>
+#include <omp.h>
+#include <optional>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "BestMatchCache.h"
+#include "BestRotationCache.h"
+#include "ConvergenceStatistics.h"
 #include "Data.h"
 #include "find_best_match.h"
+#include "find_best_match_pruned.h"
 #include "generate_euclidean_distance_matrix.h"
+#include "generate_euclidean_distance_matrix_pixel_major.h"
 #include "generate_rotated_images.h"
+#include "NeighborhoodTable.h"
 #include "SOM.h"
 #include "SOMIO.h"
+#include "TransformCache.h"
+#include "update_neurons.h"
+#include "Workspace.h"
 #include "UtilitiesLib/InputData.h"
 #include "UtilitiesLib/Interpolation.h"
 #include "UtilitiesLib/pink_exception.h"
+#include "UtilitiesLib/TransformationLayout.h"
 
 #ifdef __CUDACC__
     #include <thrust/host_vector.h>
@@ -34,6 +48,17 @@
 
 namespace pink {
 
+namespace detail {
+
+/// Detects iterators which provide the index of the data point in the data file
+template <typename Iterator, typename = void>
+struct HasDataIndex : std::false_type {};
+
+template <typename Iterator>
+struct HasDataIndex<Iterator, std::void_t<decltype(std::declval<Iterator const&>().get_index())>> : std::true_type {};
+
+} // namespace detail
+
 /// Abstract base class
 struct TrainerBase
 {
@@ -50,6 +75,14 @@ public:
     TrainerCommon(SOM<SOMLayout, DataLayout, T> const& som, std::function<float(float)> const& distribution_function,
         int verbosity, uint32_t number_of_rotations, bool use_flip, float max_update_distance,
         Interpolation interpolation, uint32_t euclidean_distance_dim, EuclideanDistanceShape const& euclidean_distance_shape)
+     : TrainerCommon(som.get_som_layout(), distribution_function, verbosity, number_of_rotations, use_flip,
+           max_update_distance, interpolation, euclidean_distance_dim, euclidean_distance_shape)
+    {}
+
+    /// Construction by the SOM layout only, e.g. if the neurons are distributed across processes
+    TrainerCommon(SOMLayout const& som_layout, std::function<float(float)> const& distribution_function,
+        int verbosity, uint32_t number_of_rotations, bool use_flip, float max_update_distance,
+        Interpolation interpolation, uint32_t euclidean_distance_dim, EuclideanDistanceShape const& euclidean_distance_shape)
      : m_distribution_function(distribution_function),
        m_verbosity(verbosity),
        m_number_of_rotations(number_of_rotations),
@@ -57,27 +90,72 @@ public:
        m_number_of_spatial_transformations(number_of_rotations * (use_flip ? 2 : 1)),
        m_max_update_distance(max_update_distance),
        m_interpolation(interpolation),
-       m_update_info(som.get_som_layout()),
-       m_som_size(static_cast<uint32_t>(som.get_som_layout().size())),
-       m_update_factors(m_som_size * m_som_size, 0.0),
+       m_update_info(som_layout),
+       m_som_size(static_cast<uint32_t>(som_layout.size())),
+       m_neighborhood_table(som_layout, distribution_function, max_update_distance),
        m_euclidean_distance_dim(euclidean_distance_dim),
        m_euclidean_distance_shape(euclidean_distance_shape)
     {
         if (number_of_rotations == 0 or (number_of_rotations != 1 and number_of_rotations % 4 != 0))
             throw pink::exception("Number of rotations must be 1 or larger then 1 and divisible by 4");
-
-        for (uint32_t i = 0; i < m_som_size; ++i) {
-            for (uint32_t j = 0; j < m_som_size; ++j) {
-                float distance = som.get_som_layout().get_distance(i, j);
-                if (this->m_max_update_distance <= 0 or distance < this->m_max_update_distance) {
-                    m_update_factors[i * m_som_size + j] = distribution_function(distance);
-                }
-            }
-        }
     }
 
     auto get_update_info() const { return m_update_info; }
 
+    /// Restore the update counters, e.g. from a checkpoint
+    void set_update_info(Data<SOMLayout, uint32_t> const& update_info) { m_update_info = update_info; }
+
+    /// Replace the distribution function and the maximal update distance, e.g. for a decay schedule.
+    /// Only the update factors of the distance classes are recalculated.
+    void set_neighborhood(std::function<float(float)> const& distribution_function, float max_update_distance)
+    {
+        m_distribution_function = distribution_function;
+        m_max_update_distance = max_update_distance;
+        m_neighborhood_table.update(distribution_function, max_update_distance);
+    }
+
+    /// Returns the largest distance between two neurons
+    float get_max_distance() const { return m_neighborhood_table.get_max_distance(); }
+
+    /// Collect the convergence statistics of all following training steps
+    void enable_statistics(uint32_t number_of_data_entries)
+    {
+        m_statistics.emplace(number_of_data_entries, m_som_size);
+    }
+
+    bool has_statistics() const { return m_statistics.has_value(); }
+
+    ConvergenceStatistics& get_statistics() { return m_statistics.value(); }
+
+    /// Search the best match of the following training steps first in a window
+    /// around the best match of the previous iteration (see BestMatchCache)
+    void enable_best_match_cache(uint32_t number_of_data_entries, float window_radius, float max_distance_increase)
+    {
+        m_best_match_cache.emplace(number_of_data_entries, window_radius, max_distance_increase);
+        m_neighborhood_table.set_window(window_radius);
+    }
+
+    bool has_best_match_cache() const { return m_best_match_cache.has_value(); }
+
+    BestMatchCache& get_best_match_cache() { return m_best_match_cache.value(); }
+
+    /// Bound the search of the following training steps by the distance of the best match of the previous
+    /// iteration within a window of rotations (see BestRotationCache)
+    void enable_best_rotation_cache(uint32_t number_of_data_entries, uint32_t window_size)
+    {
+        m_best_rotation_cache.emplace(number_of_data_entries, m_number_of_rotations, m_use_flip, window_size);
+    }
+
+    bool has_best_rotation_cache() const { return m_best_rotation_cache.has_value(); }
+
+    BestRotationCache& get_best_rotation_cache() { return m_best_rotation_cache.value(); }
+
+    uint32_t get_number_of_rotations() const { return m_number_of_rotations; }
+
+    bool get_use_flip() const { return m_use_flip; }
+
+    Interpolation get_interpolation() const { return m_interpolation; }
+
 protected:
 
     typedef Data<SOMLayout, uint32_t> UpdateInfoType;
@@ -98,13 +176,22 @@ protected:
     uint32_t m_som_size;
 
     /// Pre-calculation of updating factors
-    std::vector<float> m_update_factors;
+    NeighborhoodTable<SOMLayout> m_neighborhood_table;
 
     /// Dimension for calculation of euclidean distance
     uint32_t m_euclidean_distance_dim;
 
     /// Shape of euclidean distance region
     EuclideanDistanceShape m_euclidean_distance_shape;
+
+    /// Convergence statistics (optional)
+    std::optional<ConvergenceStatistics> m_statistics;
+
+    /// Best matches of the previous iteration (optional)
+    std::optional<BestMatchCache> m_best_match_cache;
+
+    /// Best rotations of the previous iteration (optional)
+    std::optional<BestRotationCache> m_best_rotation_cache;
 };
 
 /// Primary template will never be instantiated
@@ -124,74 +211,690 @@ public:
     Trainer(SOMType& som, std::function<float(float)> const& distribution_function, int verbosity,
         uint32_t number_of_rotations, bool use_flip, float max_update_distance,
         Interpolation interpolation, uint32_t euclidean_distance_dim,
-        EuclideanDistanceShape const& euclidean_distance_shape = EuclideanDistanceShape::QUADRATIC)
+        EuclideanDistanceShape const& euclidean_distance_shape = EuclideanDistanceShape::QUADRATIC,
+        TransformationLayout transformation_layout = TransformationLayout::NEURON_MAJOR)
      : TrainerCommon<SOMLayout, DataLayout, T>(som, distribution_function, verbosity, number_of_rotations,
            use_flip, max_update_distance, interpolation, euclidean_distance_dim, euclidean_distance_shape),
-       m_som(som)
+       m_som(som),
+       m_transformation_layout(transformation_layout)
+    {
+        if (transformation_layout == TransformationLayout::PIXEL_MAJOR) {
+            m_euclidean_distance_region = get_euclidean_distance_region(som.get_neuron_layout(),
+                euclidean_distance_dim, euclidean_distance_shape);
+        }
+
+        resize_workspaces(static_cast<size_t>(omp_get_max_threads()));
+    }
+
+    /// Training the SOM by a single data point, index is the position
+    /// of the data point in the data file for the convergence statistics
+    void operator () (Data<DataLayout, T> const& data, uint32_t index = 0)
+    {
+        auto&& workspace = m_workspaces[0];
+        auto best_match = train(data, workspace, index);
+        if (this->m_statistics) {
+            this->m_statistics->add(index, best_match, workspace.euclidean_distance_matrix[best_match]);
+        }
+    }
+
+    /// Training the SOM by the spatial transformed images of a data point in neuron-major layout,
+    /// e.g. generated once for several trainers with equal spatial transformations (see SweepTrainer).
+    /// The images are read in place and not copied into the workspace.
+    void train_spatial_transformed(std::vector<T> const& spatial_transformed_images, uint32_t index = 0)
+    {
+        if (spatial_transformed_images.size() != static_cast<size_t>(this->m_number_of_spatial_transformations) * m_som.get_neuron_size()) {
+            throw pink::exception("Number of spatial transformed images does not match the trainer");
+        }
+
+        auto&& workspace = m_workspaces[0];
+        workspace.euclidean_distance_matrix.resize(m_som.get_number_of_neurons());
+        workspace.best_rotation_matrix.resize(m_som.get_number_of_neurons());
+
+        bool best_match_cache_hit = false;
+        auto best_match = search_best_matching_neuron(workspace, spatial_transformed_images, index, best_match_cache_hit);
+        update_best_rotation_cache(workspace, index, best_match);
+        update_best_match_cache(workspace, index, best_match, best_match_cache_hit);
+        update_neighborhood(workspace, spatial_transformed_images, best_match);
+
+        if (this->m_statistics) {
+            this->m_statistics->add(index, best_match, workspace.euclidean_distance_matrix[best_match]);
+        }
+    }
+
+    /// Asynchronous training (Hogwild)
+    ///
+    /// All threads pull data points from the shared iterator and train the SOM without any locks:
+    /// the best match is searched against the live SOM, which may be updated at the same time
+    /// by other threads, and the neuron updates are written concurrently. As an update touches
+    /// only the neighborhood of the best match, conflicting writes are rare and only perturb
+    /// single pixels by one update step. The result is not reproducible for more than one thread.
+    /// The optional callback is called in order after each data point, e.g. for a progress bar.
+    /// The data points are identified for the convergence statistics by the index of the iterator,
+    /// or if not available by their reading order.
+    template <typename Iterator>
+    void train_asynchronous(Iterator& iter_cur, Iterator const& iter_end,
+        std::function<void()> const& callback = std::function<void()>())
+    {
+        resize_workspaces(static_cast<size_t>(omp_get_max_threads()));
+        uint32_t number_of_reads = 0;
+
+        #pragma omp parallel
+        {
+            auto&& workspace = m_workspaces[static_cast<size_t>(omp_get_thread_num())];
+            Data<DataLayout, T> data;
+
+            for (;;)
+            {
+                bool end_reached = false;
+                uint32_t index = 0;
+
+                // Reading the data is sequential
+                #pragma omp critical (train_asynchronous_read)
+                {
+                    if (iter_cur == iter_end) end_reached = true;
+                    else {
+                        data = *iter_cur;
+                        if constexpr (detail::HasDataIndex<Iterator>::value) index = iter_cur.get_index();
+                        else index = number_of_reads;
+                        ++number_of_reads;
+                        ++iter_cur;
+                    }
+                }
+                if (end_reached) break;
+
+                auto best_match = train(data, workspace, index);
+
+                if (this->m_statistics) {
+                    #pragma omp critical (train_asynchronous_statistics)
+                    this->m_statistics->add(index, best_match, workspace.euclidean_distance_matrix[best_match]);
+                }
+
+                if (callback) {
+                    #pragma omp critical (train_asynchronous_callback)
+                    callback();
+                }
+            }
+        }
+    }
+
+    /// Pipelined training
+    ///
+    /// The reading, the spatial transformation and the best match search of the next data point run
+    /// on all threads but one, while the last thread applies the neighborhood update of the current
+    /// data point. Therefore, a second level of active parallel regions is enabled during the training.
+    /// The search of the next data point skips the neurons which are updated at the same time and
+    /// calculates their distances after the update. Therefore, the result is the same as training the data
+    /// points one after another. If the neighborhood of a best match covers the whole SOM, nothing can
+    /// be searched during the update and both run one after another with all threads.
+    /// The optional callback is called in order after each update, e.g. for a progress bar.
+    template <typename Iterator>
+    void train_pipelined(Iterator& iter_cur, Iterator const& iter_end,
+        std::function<void()> const& callback = std::function<void()>())
+    {
+        if (this->m_best_match_cache or this->m_best_rotation_cache or m_two_phase_search or m_transform_cache) {
+            throw pink::exception("Pipelined training can not be combined with best match cache, "
+                "best rotation cache, two-phase search or transform cache");
+        }
+        if (iter_cur == iter_end) return;
+
+        resize_workspaces(2);
+        m_is_updated.assign(m_som.get_number_of_neurons(), false);
+        uint32_t number_of_reads = 0;
+
+        // Returns the index of the data point for the convergence statistics
+        auto&& read = [&](Data<DataLayout, T>& data) {
+            data = *iter_cur;
+            uint32_t index = number_of_reads++;
+            if constexpr (detail::HasDataIndex<Iterator>::value) index = iter_cur.get_index();
+            ++iter_cur;
+            return index;
+        };
+
+        Data<DataLayout, T> data;
+        uint32_t index = read(data);
+        uint32_t best_match = find_best_matching_neuron(data, m_workspaces[0], index);
+
+        // The search stage opens its own parallel regions within the pipeline
+        int number_of_threads = omp_get_max_threads();
+        int max_active_levels = omp_get_max_active_levels();
+        omp_set_max_active_levels(std::max(max_active_levels, 2));
+
+        for (uint32_t n = 0;; ++n)
+        {
+            auto&& workspace = m_workspaces[n % 2];
+            auto&& next_workspace = m_workspaces[(n + 1) % 2];
+            bool has_next = iter_cur != iter_end;
+            uint32_t next_index = 0;
+
+            this->m_neighborhood_table.get_neighbors(best_match, workspace.neighbor_indices, workspace.neighbor_factors);
+            bool overlap = has_next and workspace.neighbor_indices.size() < m_som.get_number_of_neurons();
+
+            if (overlap) {
+                #pragma omp parallel sections num_threads(2) if(number_of_threads > 1)
+                {
+                    #pragma omp section
+                    {
+                        omp_set_num_threads(1);
+                        update_neurons(m_som.get_data_pointer(), m_som.get_neuron_size(),
+                            workspace.spatial_transformed_images.data(), workspace.best_rotation_matrix.data(),
+                            workspace.neighbor_indices.data(), workspace.neighbor_factors.data(),
+                            static_cast<uint32_t>(workspace.neighbor_indices.size()));
+                    }
+                    #pragma omp section
+                    {
+                        omp_set_num_threads(std::max(number_of_threads - 1, 1));
+                        next_index = read(data);
+                        search_independent_neurons(data, next_workspace, workspace.neighbor_indices);
+                    }
+                }
+            } else {
+                update_neurons(m_som.get_data_pointer(), m_som.get_neuron_size(),
+                    workspace.spatial_transformed_images.data(), workspace.best_rotation_matrix.data(),
+                    workspace.neighbor_indices.data(), workspace.neighbor_factors.data(),
+                    static_cast<uint32_t>(workspace.neighbor_indices.size()));
+            }
+
+            ++this->m_update_info[best_match];
+            if (this->m_statistics) {
+                this->m_statistics->add(index, best_match, workspace.euclidean_distance_matrix[best_match]);
+            }
+            if (callback) callback();
+            if (!has_next) break;
+
+            if (overlap) {
+                // The distances of the updated neurons are calculated after the update
+                generate_euclidean_distance_matrix(next_workspace, next_workspace.spatial_transformed_images,
+                    workspace.neighbor_indices);
+                best_match = find_best_match(next_workspace.euclidean_distance_matrix, m_som.get_number_of_neurons());
+            } else {
+                next_index = read(data);
+                best_match = find_best_matching_neuron(data, next_workspace, next_index);
+            }
+            index = next_index;
+        }
+
+        omp_set_max_active_levels(max_active_levels);
+    }
+
+    /// Training the SOM by a mini-batch of data points
+    ///
+    /// The best matching neurons and rotations of all data points are searched in parallel
+    /// against the unchanged SOM. Afterwards, the neighborhood-weighted contributions of all
+    /// data points are accumulated into the neurons in a single step. If the sum of the
+    /// update factors of a neuron exceeds one, the contributions are normalized by this sum,
+    /// so that a neuron never overshoots the weighted mean of its data points.
+    /// For floating point types, a batch of a single data point gives the same result
+    /// as the single data point training. The indices of the data points are only needed
+    /// for the convergence statistics.
+    void operator () (std::vector<Data<DataLayout, T>> const& batch, std::vector<uint32_t> const& indices = {})
+    {
+        auto batch_size = static_cast<uint32_t>(batch.size());
+        if ((this->m_statistics or this->m_best_match_cache or this->m_best_rotation_cache or m_transform_cache)
+            and indices.size() != batch.size()) {
+            throw pink::exception("Convergence statistics and caches need the indices of all data points of the batch");
+        }
+        auto som_size = m_som.get_number_of_neurons();
+        auto neuron_size = m_som.get_neuron_size();
+
+        // Each data point of the batch needs its own spatial transformed images
+        resize_workspaces(batch_size);
+        m_best_matches.resize(batch_size);
+
+        // Images of the batch are independent, the inner loops run single-threaded
+        #pragma omp parallel for schedule(dynamic)
+        for (uint32_t b = 0; b < batch_size; ++b)
+        {
+            m_best_matches[b] = find_best_matching_neuron(batch[b], m_workspaces[b], indices.empty() ? 0 : indices[b]);
+        }
+
+        // Neurons are independent, each one accumulates the contributions of the whole batch
+        #pragma omp parallel
+        {
+            std::vector<float> factors(batch_size);
+            std::vector<T> delta(neuron_size);
+
+            #pragma omp for schedule(dynamic, 16)
+            for (uint32_t i = 0; i < som_size; ++i)
+            {
+                float sum_of_factors = 0.0f;
+                for (uint32_t b = 0; b < batch_size; ++b) {
+                    factors[b] = this->m_neighborhood_table.get_factor(m_best_matches[b], i);
+                    sum_of_factors += factors[b];
+                }
+                if (sum_of_factors == 0.0f) continue;
+                float normalization = std::max(1.0f, sum_of_factors);
+
+                T *current_neuron = m_som.get_data_pointer() + static_cast<size_t>(i) * neuron_size;
+                std::fill(delta.begin(), delta.end(), 0);
+
+                for (uint32_t b = 0; b < batch_size; ++b) {
+                    if (factors[b] == 0.0f) continue;
+                    float factor = factors[b] / normalization;
+                    T const *current_image = &m_workspaces[b].spatial_transformed_images[
+                        static_cast<size_t>(m_workspaces[b].best_rotation_matrix[i]) * neuron_size];
+                    for (uint32_t j = 0; j < neuron_size; ++j) {
+                        delta[j] += (current_neuron[j] - current_image[j]) * factor;
+                    }
+                }
+
+                for (uint32_t j = 0; j < neuron_size; ++j) current_neuron[j] -= delta[j];
+            }
+        }
+
+        for (uint32_t b = 0; b < batch_size; ++b) {
+            auto best_match = m_best_matches[b];
+            ++this->m_update_info[best_match];
+            if (this->m_statistics) {
+                this->m_statistics->add(indices[b], best_match, m_workspaces[b].euclidean_distance_matrix[best_match]);
+            }
+        }
+    }
+
+    void update_som()
     {}
 
-    void operator () (Data<DataLayout, T> const& data)
+    /// Search the best match of the following training steps in two phases (see find_best_match_pruned.h):
+    /// the exact best match by early abandoning, then the best rotations of the neurons with a non-zero
+    /// update factor only. The trained SOM is the same as without.
+    void enable_two_phase_search()
+    {
+        m_two_phase_search = true;
+        if (m_euclidean_distance_region.empty()) {
+            m_euclidean_distance_region = get_euclidean_distance_region(m_som.get_neuron_layout(),
+                this->m_euclidean_distance_dim, this->m_euclidean_distance_shape);
+        }
+    }
+
+    bool has_two_phase_search() const { return m_two_phase_search; }
+
+    /// The best rotation cache bounds the two-phase search (see BestRotationCache).
+    /// The trained SOM is the same as without.
+    void enable_best_rotation_cache(uint32_t number_of_data_entries, uint32_t window_size)
+    {
+        TrainerCommon<SOMLayout, DataLayout, T>::enable_best_rotation_cache(number_of_data_entries, window_size);
+        if (m_euclidean_distance_region.empty()) {
+            m_euclidean_distance_region = get_euclidean_distance_region(m_som.get_neuron_layout(),
+                this->m_euclidean_distance_dim, this->m_euclidean_distance_shape);
+        }
+    }
+
+    /// Store the spatial transformed images of the following training steps for the next iterations
+    /// within a memory budget of max_bytes (see TransformCache). The trained SOM is the same as without.
+    void enable_transform_cache(uint32_t number_of_data_entries, size_t max_bytes)
     {
-        auto&& spatial_transformed_images = SpatialTransformer<DataLayout>()(data, this->m_number_of_rotations,
-            this->m_use_flip, this->m_interpolation, this->m_som.get_neuron_layout());
+        m_transform_cache.emplace(number_of_data_entries,
+            static_cast<size_t>(this->m_number_of_spatial_transformations) * m_som.get_neuron_size(), max_bytes);
+    }
+
+    bool has_transform_cache() const { return m_transform_cache.has_value(); }
+
+    TransformCache<T>& get_transform_cache() { return m_transform_cache.value(); }
+
+    DataLayout get_neuron_layout() const { return m_som.get_neuron_layout(); }
+
+    /// Euclidean distances of all neurons to the last trained data point, or to the data point b
+    /// of the last mini-batch, before the SOM was updated by it. The distances of all neurons are
+    /// only calculated without best match cache, best rotation cache and two-phase search.
+    std::vector<T> const& get_euclidean_distance_matrix(uint32_t b = 0) const
+    {
+        return m_workspaces[b].euclidean_distance_matrix;
+    }
+
+    /// Best spatial transformations belonging to get_euclidean_distance_matrix
+    std::vector<uint32_t> const& get_best_rotation_matrix(uint32_t b = 0) const
+    {
+        return m_workspaces[b].best_rotation_matrix;
+    }
+
+    /// A larger update distance may need larger neighbor buffers
+    void set_neighborhood(std::function<float(float)> const& distribution_function, float max_update_distance)
+    {
+        TrainerCommon<SOMLayout, DataLayout, T>::set_neighborhood(distribution_function, max_update_distance);
+
+        auto max_number_of_neighbors = this->m_neighborhood_table.get_max_number_of_neighbors();
+        for (auto&& workspace : m_workspaces) {
+            workspace.neighbor_indices.reserve(max_number_of_neighbors);
+            workspace.neighbor_factors.reserve(max_number_of_neighbors);
+        }
+    }
+
+private:
+
+    /// Returns a workspace with all buffers allocated
+    Workspace<T> create_workspace() const
+    {
+        return Workspace<T>(m_som.get_number_of_neurons(),
+            this->m_number_of_spatial_transformations * m_som.get_neuron_size(),
+            static_cast<uint32_t>(this->m_neighborhood_table.get_max_number_of_neighbors()));
+    }
+
+    /// Provide at least the given number of workspaces
+    void resize_workspaces(size_t number_of_workspaces)
+    {
+        while (m_workspaces.size() < number_of_workspaces) m_workspaces.push_back(create_workspace());
+    }
+
+    /// Training the SOM by a single data point using the buffers of the workspace, returns the best match
+    uint32_t train(Data<DataLayout, T> const& data, Workspace<T>& workspace, uint32_t index)
+    {
+        auto best_match = find_best_matching_neuron(data, workspace, index);
+        update_neighborhood(workspace, workspace.spatial_transformed_images, best_match);
+        return best_match;
+    }
+
+    /// Move the neighbors of the best match towards their best spatial transformed images
+    void update_neighborhood(Workspace<T>& workspace, std::vector<T> const& spatial_transformed_images,
+        uint32_t best_match)
+    {
+        this->m_neighborhood_table.get_neighbors(best_match, workspace.neighbor_indices, workspace.neighbor_factors);
+        update_neurons(m_som.get_data_pointer(), m_som.get_neuron_size(),
+            spatial_transformed_images.data(), workspace.best_rotation_matrix.data(),
+            workspace.neighbor_indices.data(), workspace.neighbor_factors.data(),
+            static_cast<uint32_t>(workspace.neighbor_indices.size()));
+
+        #pragma omp atomic
+        ++this->m_update_info[best_match];
+
+#ifdef PRINT_DEBUG
+        std::cout << "best_match = " << best_match << std::endl;
+#endif
+    }
+
+    /// Calculate the euclidean distance of all neurons to the best spatial transformation
+    /// of the data point and returns the best matching neuron with the lowest euclidean distance.
+    uint32_t find_best_matching_neuron(Data<DataLayout, T> const& data, Workspace<T>& workspace, uint32_t index = 0)
+    {
+        workspace.euclidean_distance_matrix.resize(m_som.get_number_of_neurons());
+        workspace.best_rotation_matrix.resize(m_som.get_number_of_neurons());
+
+        generate_spatial_transformed_images(data, workspace, index);
 
 #ifdef PRINT_DEBUG
         std::cout << "spatial_transformed_images" << std::endl;
-        for (auto&& e : spatial_transformed_images) std::cout << e << " ";
+        for (auto&& e : workspace.spatial_transformed_images) std::cout << e << " ";
         std::cout << std::endl;
 #endif
 
-        // Memory allocation
-        std::vector<T> euclidean_distance_matrix(this->m_som.get_number_of_neurons());
-        std::vector<uint32_t> best_rotation_matrix(this->m_som.get_number_of_neurons());
-
-        generate_euclidean_distance_matrix(euclidean_distance_matrix, best_rotation_matrix,
-            this->m_som.get_number_of_neurons(), m_som.get_data_pointer(),
-            m_som.get_neuron_layout(), this->m_number_of_spatial_transformations,
-            spatial_transformed_images, this->m_euclidean_distance_dim, this->m_euclidean_distance_shape);
+        bool best_match_cache_hit = false;
+        auto best_match = search_best_matching_neuron(workspace, workspace.spatial_transformed_images, index,
+            best_match_cache_hit);
 
 #ifdef PRINT_DEBUG
         std::cout << "euclidean_distance_matrix" << std::endl;
-        for (auto&& e : euclidean_distance_matrix) std::cout << e << " ";
+        for (auto&& e : workspace.euclidean_distance_matrix) std::cout << e << " ";
         std::cout << std::endl;
 
         std::cout << "best_rotation_matrix" << std::endl;
-        for (auto&& e : best_rotation_matrix) std::cout << e << " ";
+        for (auto&& e : workspace.best_rotation_matrix) std::cout << e << " ";
         std::cout << std::endl;
 #endif
 
-        /// Find the best matching neuron, with the lowest euclidean distance
-        auto&& best_match = std::distance(euclidean_distance_matrix.begin(),
-            std::min_element(std::begin(euclidean_distance_matrix), std::end(euclidean_distance_matrix)));
+        update_best_rotation_cache(workspace, index, best_match);
+        update_best_match_cache(workspace, index, best_match, best_match_cache_hit);
+        return best_match;
+    }
 
-        auto neuron_size = m_som.get_neuron_size();
-        auto&& current_neuron = m_som.get_data_pointer();
-        for (uint32_t i = 0; i < this->m_som.get_number_of_neurons(); ++i) {
-            float factor = this->m_update_factors[
-                static_cast<size_t>(best_match * this->m_som.get_number_of_neurons()) + i];
-            if (factor != 0.0f) {
-                T *current_image = &spatial_transformed_images[best_rotation_matrix[i] * neuron_size];
-                for (uint32_t j = 0; j < neuron_size; ++j) {
-                    current_neuron[j] -= (current_neuron[j] - current_image[j]) * factor;
+    /// All spatial transformations of the data point, copied from the transform cache if available
+    void generate_spatial_transformed_images(Data<DataLayout, T> const& data, Workspace<T>& workspace, uint32_t index)
+    {
+        if (m_transform_cache) {
+            bool hit = m_transform_cache->get(index, workspace.spatial_transformed_images);
+            m_transform_cache->count(hit);
+            if (hit) return;
+        }
+
+        SpatialTransformer<DataLayout>()(workspace.spatial_transformed_images, workspace.spatial_transformer_buffer,
+            data, this->m_number_of_rotations, this->m_use_flip, this->m_interpolation,
+            this->m_som.get_neuron_layout());
+
+        if (m_transform_cache) m_transform_cache->set(index, workspace.spatial_transformed_images);
+    }
+
+    /// Returns the best matching neuron for the spatial transformed images, which may be stored outside of
+    /// the workspace. With the best match cache, only the neurons of the window around the cached best match
+    /// and the neighbors of the new best match are calculated, if the search in the window is accepted.
+    uint32_t search_best_matching_neuron(Workspace<T>& workspace, std::vector<T> const& spatial_transformed_images,
+        uint32_t index, bool& best_match_cache_hit) const
+    {
+        if (m_transformation_layout == TransformationLayout::PIXEL_MAJOR) {
+            interleave_spatial_transformed_images(workspace.interleaved_images,
+                spatial_transformed_images, get_number_of_spatial_transformations(spatial_transformed_images),
+                m_som.get_neuron_size(), m_euclidean_distance_region);
+        }
+
+        best_match_cache_hit = false;
+        uint32_t cached_best_match = 0;
+        float cached_distance = 0.0f;
+
+        if (this->m_best_match_cache and this->m_best_match_cache->get(index, cached_best_match, cached_distance)) {
+            auto&& cache = *this->m_best_match_cache;
+            auto&& table = this->m_neighborhood_table;
+            table.get_window(cached_best_match, workspace.window_indices);
+            generate_euclidean_distance_matrix(workspace, spatial_transformed_images, workspace.window_indices);
+
+            uint32_t best_match = workspace.window_indices[0];
+            for (auto i : workspace.window_indices) {
+                if (workspace.euclidean_distance_matrix[i] < workspace.euclidean_distance_matrix[best_match] or
+                    (workspace.euclidean_distance_matrix[i] == workspace.euclidean_distance_matrix[best_match]
+                     and i < best_match)) best_match = i;
+            }
+
+            // All layout neighbors of a neuron inside of the border are within the window
+            best_match_cache_hit = table.get_distance(cached_best_match, best_match) <= cache.get_window_radius() - 1.0f and
+                cache.is_accepted(workspace.euclidean_distance_matrix[best_match], cached_distance);
+
+            if (best_match_cache_hit) {
+                // The update needs the best rotations of all neighbors of the best match
+                table.get_neighbors(best_match, workspace.neighbor_indices, workspace.neighbor_factors);
+                workspace.outside_indices.clear();
+                for (auto i : workspace.neighbor_indices) {
+                    if (table.get_distance(cached_best_match, i) > cache.get_window_radius()) {
+                        workspace.outside_indices.push_back(i);
+                    }
                 }
+                generate_euclidean_distance_matrix(workspace, spatial_transformed_images, workspace.outside_indices);
+                return best_match;
             }
-            current_neuron += neuron_size;
         }
 
-        ++this->m_update_info[static_cast<uint32_t>(best_match)];
+        uint32_t previous_best_match = 0;
+        uint32_t previous_transformation = 0;
+        if (this->m_best_rotation_cache and
+            this->m_best_rotation_cache->get(index, previous_best_match, previous_transformation)) {
+            return search_best_matching_neuron_two_phase(workspace, spatial_transformed_images,
+                get_best_rotation_cache_bound(workspace, spatial_transformed_images, previous_best_match,
+                    previous_transformation));
+        }
+
+        if (m_two_phase_search) return search_best_matching_neuron_two_phase(workspace, spatial_transformed_images);
 
-#ifdef PRINT_DEBUG
-        std::cout << "best_match = " << best_match << std::endl;
-#endif
+        generate_euclidean_distance_matrix(workspace, spatial_transformed_images);
+        return find_best_match(workspace.euclidean_distance_matrix, m_som.get_number_of_neurons());
     }
 
-    void update_som()
-    {}
+    /// Phase one finds the best match and its best rotation by early abandoning, phase two the best rotations
+    /// of its neighbors, warm-started by the best rotation of the best match. The euclidean distances
+    /// of all other neurons are not calculated. Phase one is repeated without bound, if no distance
+    /// is below the given one.
+    uint32_t search_best_matching_neuron_two_phase(Workspace<T>& workspace,
+        std::vector<T> const& spatial_transformed_images, T bound = std::numeric_limits<T>::max()) const
+    {
+        auto number_of_spatial_transformations = get_number_of_spatial_transformations(spatial_transformed_images);
+        T min_distance = 0;
+        uint32_t best_rotation = 0;
+        uint32_t best_match = 0;
+
+        if (m_transformation_layout == TransformationLayout::PIXEL_MAJOR) {
+            best_match = find_best_match_pruned_pixel_major(min_distance, best_rotation,
+                m_som.get_number_of_neurons(), m_som.get_data_pointer(), m_som.get_neuron_size(),
+                number_of_spatial_transformations, workspace.interleaved_images, m_euclidean_distance_region, bound);
+        } else {
+            best_match = find_best_match_pruned(min_distance, best_rotation,
+                m_som.get_number_of_neurons(), m_som.get_data_pointer(), m_som.get_neuron_size(),
+                number_of_spatial_transformations, spatial_transformed_images, m_euclidean_distance_region, bound);
+        }
+        if (best_match == std::numeric_limits<uint32_t>::max()) {
+            return search_best_matching_neuron_two_phase(workspace, spatial_transformed_images);
+        }
 
-private:
+        this->m_neighborhood_table.get_neighbors(best_match, workspace.neighbor_indices, workspace.neighbor_factors);
+
+        if (m_transformation_layout == TransformationLayout::PIXEL_MAJOR) {
+            generate_best_rotations_pixel_major(workspace.euclidean_distance_matrix, workspace.best_rotation_matrix,
+                workspace.neighbor_indices, m_som.get_data_pointer(), m_som.get_neuron_size(),
+                number_of_spatial_transformations, workspace.interleaved_images, m_euclidean_distance_region,
+                best_rotation);
+        } else {
+            generate_best_rotations(workspace.euclidean_distance_matrix, workspace.best_rotation_matrix,
+                workspace.neighbor_indices, m_som.get_data_pointer(), m_som.get_neuron_size(),
+                number_of_spatial_transformations, spatial_transformed_images, m_euclidean_distance_region,
+                best_rotation);
+        }
+
+        // The best match may be no neighbor of itself if its update factor vanishes
+        workspace.euclidean_distance_matrix[best_match] = min_distance;
+        workspace.best_rotation_matrix[best_match] = best_rotation;
+        return best_match;
+    }
+
+    /// Spatial transformation of the data point and euclidean distances of all neurons,
+    /// which are not in the list of updated neurons
+    void search_independent_neurons(Data<DataLayout, T> const& data, Workspace<T>& workspace,
+        std::vector<uint32_t> const& updated_neurons)
+    {
+        workspace.euclidean_distance_matrix.resize(m_som.get_number_of_neurons());
+        workspace.best_rotation_matrix.resize(m_som.get_number_of_neurons());
+
+        SpatialTransformer<DataLayout>()(workspace.spatial_transformed_images, workspace.spatial_transformer_buffer,
+            data, this->m_number_of_rotations, this->m_use_flip, this->m_interpolation,
+            this->m_som.get_neuron_layout());
+
+        if (m_transformation_layout == TransformationLayout::PIXEL_MAJOR) {
+            interleave_spatial_transformed_images(workspace.interleaved_images, workspace.spatial_transformed_images,
+                get_number_of_spatial_transformations(workspace.spatial_transformed_images),
+                m_som.get_neuron_size(), m_euclidean_distance_region);
+        }
+
+        for (auto i : updated_neurons) m_is_updated[i] = true;
+        workspace.independent_indices.clear();
+        for (uint32_t i = 0; i < m_som.get_number_of_neurons(); ++i) {
+            if (!m_is_updated[i]) workspace.independent_indices.push_back(i);
+        }
+        for (auto i : updated_neurons) m_is_updated[i] = false;
+
+        generate_euclidean_distance_matrix(workspace, workspace.spatial_transformed_images,
+            workspace.independent_indices);
+    }
+
+    /// Lowest euclidean distance of the previous best match over the window of rotations around its
+    /// previous best transformation. A small margin covers rounding differences of the pixel-major summation,
+    /// a wrong bound only costs time, as phase one is repeated without bound.
+    T get_best_rotation_cache_bound(Workspace<T>& workspace, std::vector<T> const& spatial_transformed_images,
+        uint32_t previous_best_match, uint32_t previous_transformation) const
+    {
+        T bound = std::numeric_limits<T>::max();
+        if (previous_best_match >= m_som.get_number_of_neurons() or
+            previous_transformation >= get_number_of_spatial_transformations(spatial_transformed_images)) return bound;
+
+        auto neuron_size = m_som.get_neuron_size();
+        T const *neuron = m_som.get_data_pointer() + static_cast<size_t>(previous_best_match) * neuron_size;
+
+        this->m_best_rotation_cache->get_window(previous_transformation, workspace.transformations);
+        for (auto j : workspace.transformations) {
+            T distance;
+            if (detail::euclidean_distance_pruned(distance, neuron,
+                &spatial_transformed_images[static_cast<size_t>(j) * neuron_size], m_euclidean_distance_region.data(),
+                static_cast<uint32_t>(m_euclidean_distance_region.size()), bound)) bound = std::min(bound, distance);
+        }
+        return bound == std::numeric_limits<T>::max() ? bound : bound * T(1.0001) + std::numeric_limits<T>::min();
+    }
+
+    /// Store the best match and its best transformation, if the best rotation cache is used.
+    /// A search is a hit if the best match is the cached one.
+    void update_best_rotation_cache(Workspace<T> const& workspace, uint32_t index, uint32_t best_match)
+    {
+        if (!this->m_best_rotation_cache) return;
+        auto&& cache = *this->m_best_rotation_cache;
+        uint32_t previous_best_match = 0;
+        uint32_t previous_transformation = 0;
+        bool hit = cache.get(index, previous_best_match, previous_transformation) and previous_best_match == best_match;
+        cache.set(index, best_match, workspace.best_rotation_matrix[best_match]);
+        cache.count(hit);
+    }
+
+    /// Store the best match of the data point, if the best match cache is used
+    void update_best_match_cache(Workspace<T> const& workspace, uint32_t index, uint32_t best_match, bool hit)
+    {
+        if (!this->m_best_match_cache) return;
+        this->m_best_match_cache->set(index, best_match, workspace.euclidean_distance_matrix[best_match]);
+        this->m_best_match_cache->count(hit);
+    }
+
+    /// Number of spatial transformed images, which may be a window of rotations only
+    uint32_t get_number_of_spatial_transformations(std::vector<T> const& spatial_transformed_images) const
+    {
+        return static_cast<uint32_t>(spatial_transformed_images.size() / m_som.get_neuron_size());
+    }
+
+    /// Euclidean distances of all neurons to the spatial transformed images
+    void generate_euclidean_distance_matrix(Workspace<T>& workspace,
+        std::vector<T> const& spatial_transformed_images) const
+    {
+        if (m_transformation_layout == TransformationLayout::PIXEL_MAJOR) {
+            generate_euclidean_distance_matrix_pixel_major(workspace.euclidean_distance_matrix,
+                workspace.best_rotation_matrix, this->m_som.get_number_of_neurons(), m_som.get_data_pointer(),
+                m_som.get_neuron_size(), get_number_of_spatial_transformations(spatial_transformed_images),
+                workspace.interleaved_images, m_euclidean_distance_region);
+        } else {
+            pink::generate_euclidean_distance_matrix(workspace.euclidean_distance_matrix,
+                workspace.best_rotation_matrix, this->m_som.get_number_of_neurons(), m_som.get_data_pointer(),
+                m_som.get_neuron_layout(), get_number_of_spatial_transformations(spatial_transformed_images),
+                spatial_transformed_images, this->m_euclidean_distance_dim,
+                this->m_euclidean_distance_shape);
+        }
+    }
+
+    /// Euclidean distances of the given neurons only
+    void generate_euclidean_distance_matrix(Workspace<T>& workspace,
+        std::vector<T> const& spatial_transformed_images, std::vector<uint32_t> const& neuron_indices) const
+    {
+        if (m_transformation_layout == TransformationLayout::PIXEL_MAJOR) {
+            generate_euclidean_distance_matrix_pixel_major(workspace.euclidean_distance_matrix,
+                workspace.best_rotation_matrix, neuron_indices, m_som.get_data_pointer(),
+                m_som.get_neuron_size(), get_number_of_spatial_transformations(spatial_transformed_images),
+                workspace.interleaved_images, m_euclidean_distance_region);
+        } else {
+            pink::generate_euclidean_distance_matrix(workspace.euclidean_distance_matrix,
+                workspace.best_rotation_matrix, neuron_indices, m_som.get_data_pointer(),
+                m_som.get_neuron_layout(), get_number_of_spatial_transformations(spatial_transformed_images),
+                spatial_transformed_images, this->m_euclidean_distance_dim,
+                this->m_euclidean_distance_shape);
+        }
+    }
 
     /// A reference to the SOM will be trained
     SOMType& m_som;
+
+    /// Memory layout of the spatial transformed images for the euclidean distance
+    TransformationLayout m_transformation_layout;
+
+    /// Pixel indices of the euclidean distance region (only pixel-major or two-phase search)
+    std::vector<uint32_t> m_euclidean_distance_region;
+
+    /// Search the best match in two phases
+    bool m_two_phase_search = false;
+
+    /// Spatial transformed images of the previous iterations (optional)
+    std::optional<TransformCache<T>> m_transform_cache;
+
+    /// Marks the neurons of the running update (only pipelined training)
+    std::vector<bool> m_is_updated;
+
+    /// Buffers for each thread, or for each data point of a mini-batch
+    std::vector<Workspace<T>> m_workspaces;
+
+    /// Best matching neurons of a mini-batch
+    std::vector<uint32_t> m_best_matches;
 };
 
 
@@ -240,7 +943,8 @@ public:
             d_sin_alpha = sin_alpha;
         }
 
-        d_update_factors = this->m_update_factors;
+        d_table_positions = this->m_neighborhood_table.get_table_positions();
+        copy_update_factors_to_device();
 
         if (euclidean_distance_shape == EuclideanDistanceShape::CIRCULAR) {
             std::vector<uint32_t> delta(euclidean_distance_dim);
@@ -259,8 +963,9 @@ public:
         }
     }
 
-    /// Training the SOM by a single data point
-    void operator () (Data<DataLayout, T> const& data)
+    /// Training the SOM by a single data point, index is the position
+    /// of the data point in the data file for the convergence statistics
+    void operator () (Data<DataLayout, T> const& data, uint32_t index = 0)
     {
         /// Device memory for data
         thrust::device_vector<T> d_data = data.get_data();
@@ -297,10 +1002,17 @@ public:
 #endif
 
         update_neurons(d_som, d_spatial_transformed_images, d_best_rotation_matrix, d_euclidean_distance_matrix,
-            d_best_match, d_update_factors, this->m_som.get_number_of_neurons(), this->m_som.get_neuron_layout().size());
+            d_best_match, d_update_factors, d_table_positions, this->m_neighborhood_table.get_table_center(),
+            this->m_som.get_number_of_neurons(), this->m_som.get_neuron_layout().size());
 
         thrust::host_vector<uint32_t> best_match = d_best_match;
         ++this->m_update_info[best_match[0]];
+
+        // Only the distance of the best match is copied to the host
+        if (this->m_statistics) {
+            T distance = d_euclidean_distance_matrix[best_match[0]];
+            this->m_statistics->add(index, best_match[0], distance);
+        }
     }
 
     void update_som()
@@ -308,8 +1020,22 @@ public:
         thrust::copy(d_som.begin(), d_som.end(), m_som.get_data_pointer());
     }
 
+    /// The device copy of the update factors must be refreshed
+    void set_neighborhood(std::function<float(float)> const& distribution_function, float max_update_distance)
+    {
+        TrainerCommon<SOMLayout, DataLayout, T>::set_neighborhood(distribution_function, max_update_distance);
+        copy_update_factors_to_device();
+    }
+
 private:
 
+    /// The CUDA update kernel reads the factors from the offset table of the neighborhood table,
+    /// which has O(som_size) entries
+    void copy_update_factors_to_device()
+    {
+        d_update_factors = this->m_neighborhood_table.get_table();
+    }
+
     /// A reference to the SOM will be trained
     SOMType& m_som;
 
@@ -328,8 +1054,13 @@ private:
 
     thrust::device_vector<float> d_cos_alpha;
     thrust::device_vector<float> d_sin_alpha;
+
+    /// Update factors of all layout offsets (see NeighborhoodTable)
     thrust::device_vector<float> d_update_factors;
 
+    /// Offset table position of each neuron, constant for the SOM layout
+    thrust::device_vector<uint32_t> d_table_positions;
+
     thrust::device_vector<uint32_t> d_circle_offset;
     thrust::device_vector<uint32_t> d_circle_delta;
 };
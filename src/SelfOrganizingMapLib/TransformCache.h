@@ -0,0 +1,133 @@
+/**
+ * @file   SelfOrganizingMapLib/TransformCache.h
+ * @brief  Spatial transformed images of the data points across the training iterations
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "UtilitiesLib/pink_exception.h"
+
+namespace pink {
+
+/// The spatial transformations of a data point are the same in each iteration. The trainer stores
+/// them in the first iteration and copies them back in all following ones instead of rotating the
+/// data point again. The images are stored in full precision, as the neuron update needs the whole
+/// best transformed image and not only the euclidean distance region.
+///
+/// The memory is a single arena of fixed size, which is allocated at construction. The slots
+/// are taken in the order of the first training steps. If the arena is full, the spatial
+/// transformations of the remaining data points are recalculated in each iteration.
+///
+/// Each data point is identified by its index in the data file. Different data points
+/// can be accessed concurrently.
+template <typename T>
+class TransformCache
+{
+public:
+
+    /// Marks data points without cached images
+    static constexpr uint32_t no_slot = std::numeric_limits<uint32_t>::max();
+
+    /// The arena holds the images of as many data points as fit into max_bytes
+    TransformCache(uint32_t number_of_data_entries, size_t images_size, size_t max_bytes)
+     : m_images_size(images_size),
+       m_number_of_slots(static_cast<uint32_t>(std::min<size_t>(number_of_data_entries,
+           images_size == 0 ? 0 : max_bytes / (images_size * sizeof(T))))),
+       m_slots(number_of_data_entries, no_slot),
+       m_arena(m_number_of_slots * images_size)
+    {
+        if (images_size == 0) throw pink::exception("Size of spatial transformed images of transform cache must be > 0");
+    }
+
+    /// Returns false if the images of the data point are not cached
+    bool get(uint32_t index, std::vector<T>& images) const
+    {
+        if (index >= m_slots.size()) throw pink::exception("Data index of transform cache out of range");
+        auto slot = m_slots[index];
+        if (slot == no_slot) return false;
+        auto begin = m_arena.begin() + static_cast<std::ptrdiff_t>(slot * m_images_size);
+        images.assign(begin, begin + static_cast<std::ptrdiff_t>(m_images_size));
+        return true;
+    }
+
+    /// Returns false if the images are not stored, because the arena is full
+    bool set(uint32_t index, std::vector<T> const& images)
+    {
+        if (index >= m_slots.size()) throw pink::exception("Data index of transform cache out of range");
+        if (images.size() != m_images_size) throw pink::exception("Size of spatial transformed images does not match the transform cache");
+        if (m_slots[index] != no_slot) return true;
+
+        uint64_t slot = 0;
+        #pragma omp atomic capture
+        slot = m_number_of_requested_slots++;
+        if (slot >= m_number_of_slots) return false;
+
+        std::copy(images.begin(), images.end(), m_arena.begin() + static_cast<std::ptrdiff_t>(slot * m_images_size));
+        m_slots[index] = static_cast<uint32_t>(slot);
+        return true;
+    }
+
+    /// Count a request, thread-safe
+    void count(bool hit)
+    {
+        #pragma omp atomic
+        ++m_number_of_requests;
+        if (hit) {
+            #pragma omp atomic
+            ++m_number_of_hits;
+        }
+    }
+
+    /// Fraction of the requests since the last reset which were served by the arena
+    double get_hit_rate() const
+    {
+        return m_number_of_requests == 0 ? 0.0 : static_cast<double>(m_number_of_hits) / m_number_of_requests;
+    }
+
+    void reset_counters()
+    {
+        m_number_of_hits = 0;
+        m_number_of_requests = 0;
+    }
+
+    /// Number of data points whose images are stored
+    uint32_t get_number_of_cached_data_points() const
+    {
+        return static_cast<uint32_t>(std::min<uint64_t>(m_number_of_requested_slots, m_number_of_slots));
+    }
+
+    uint32_t get_number_of_data_entries() const { return static_cast<uint32_t>(m_slots.size()); }
+
+    /// Allocated bytes of the arena
+    size_t get_memory_size() const { return m_arena.size() * sizeof(T); }
+
+private:
+
+    /// Number of elements of all spatial transformations of a data point
+    size_t m_images_size;
+
+    /// Number of data points fitting into the arena
+    uint32_t m_number_of_slots;
+
+    /// Arena slot of each data point
+    std::vector<uint32_t> m_slots;
+
+    /// Spatial transformed images of all cached data points
+    std::vector<T> m_arena;
+
+    /// Requested slots, which may exceed the number of slots
+    uint64_t m_number_of_requested_slots = 0;
+
+    uint64_t m_number_of_hits = 0;
+
+    uint64_t m_number_of_requests = 0;
+};
+
+} // namespace pink
@@ -0,0 +1,67 @@
+/**
+ * @file   SelfOrganizingMapLib/Workspace.h
+ * @brief  Reusable buffers of a training or mapping step
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace pink {
+
+/// All temporary buffers needed to train or map a single data point.
+/// The buffers are allocated once and reused for every data point, so that a step
+/// does not need any heap allocation. A workspace must not be shared between threads.
+template <typename T>
+struct Workspace
+{
+    Workspace() = default;
+
+    /// Allocate all buffers for the given sizes
+    Workspace(uint32_t som_size, uint32_t spatial_transformed_images_size, uint32_t max_number_of_neighbors = 0)
+    {
+        spatial_transformed_images.reserve(spatial_transformed_images_size);
+        euclidean_distance_matrix.reserve(som_size);
+        best_rotation_matrix.reserve(som_size);
+        neighbor_indices.reserve(max_number_of_neighbors);
+        neighbor_factors.reserve(max_number_of_neighbors);
+    }
+
+    /// Spatial transformed images in neuron-major layout
+    std::vector<T> spatial_transformed_images;
+
+    /// Buffer of SpatialTransformer (only 3D data)
+    std::vector<T> spatial_transformer_buffer;
+
+    /// Spatial transformed images in pixel-major layout (only pixel-major)
+    std::vector<T> interleaved_images;
+
+    /// Minimal euclidean distance of each neuron
+    std::vector<T> euclidean_distance_matrix;
+
+    /// Spatial transformation of the minimal euclidean distance of each neuron
+    std::vector<uint32_t> best_rotation_matrix;
+
+    /// Indices of the neurons with a non-zero update factor (only training)
+    std::vector<uint32_t> neighbor_indices;
+
+    /// Update factors corresponding to neighbor_indices (only training)
+    std::vector<float> neighbor_factors;
+
+    /// Neurons of the search window around the cached best match (only best match cache)
+    std::vector<uint32_t> window_indices;
+
+    /// Neighbors of the best match outside of the search window (only best match cache)
+    std::vector<uint32_t> outside_indices;
+
+    /// Transformations of the window around the cached best transformation (only best rotation cache)
+    std::vector<uint32_t> transformations;
+
+    /// Neurons which are not updated by the previous data point (only pipelined training)
+    std::vector<uint32_t> independent_indices;
+};
+
+} // namespace pink
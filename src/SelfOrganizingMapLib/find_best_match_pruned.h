@@ -0,0 +1,276 @@
+/**
+ * @file   SelfOrganizingMapLib/find_best_match_pruned.h
+ * @brief  Two-phase search: exact best match by early abandoning, then best rotations of the neighborhood
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <omp.h>
+#include <vector>
+
+#include "generate_euclidean_distance_matrix_pixel_major.h"
+
+namespace pink {
+
+/// Number of region pixels which are summed up between two checks against the bound
+constexpr uint32_t pruning_interval = 32;
+
+namespace detail {
+
+/// Euclidean distance of the region of a neuron and an image, summed up in the same order and with the
+/// same arithmetic as EuclideanDistanceFunctor. Returns false and stops the summation as soon as the
+/// partial sum exceeds the bound. As all terms are non-negative, the final sum would exceed it as well.
+template <typename T>
+bool euclidean_distance_pruned(T& distance, T const *neuron, T const *image,
+    uint32_t const *region, uint32_t region_size, T bound)
+{
+    T ed = 0;
+    for (uint32_t p0 = 0; p0 < region_size; p0 += pruning_interval) {
+        auto p1 = std::min(p0 + pruning_interval, region_size);
+        for (uint32_t p = p0; p < p1; ++p) ed += std::pow(neuron[region[p]] - image[region[p]], 2);
+        if (ed > bound) return false;
+    }
+    distance = ed;
+    return true;
+}
+
+/// Euclidean distances of all lanes of a pixel-major block, summed up in the same order and with the
+/// same arithmetic as generate_euclidean_distance_matrix_pixel_major. Returns false and stops the
+/// summation as soon as the partial sums of all valid lanes exceed the bound.
+template <typename T>
+bool euclidean_distance_block_pruned(T (&sum)[pixel_major_block_size], T const *neuron, T const *block,
+    uint32_t const *region, uint32_t region_size, uint32_t number_of_lanes, T bound)
+{
+    constexpr uint32_t W = pixel_major_block_size;
+    std::fill(sum, sum + W, T(0));
+
+    for (uint32_t p0 = 0; p0 < region_size; p0 += pruning_interval) {
+        auto p1 = std::min(p0 + pruning_interval, region_size);
+        for (uint32_t p = p0; p < p1; ++p) {
+            T value = neuron[region[p]];
+            T const *lane = block + p * W;
+            #pragma omp simd
+            for (uint32_t l = 0; l < W; ++l) {
+                T diff = value - lane[l];
+                sum[l] += diff * diff;
+            }
+        }
+        T min_sum = sum[0];
+        for (uint32_t l = 1; l < number_of_lanes; ++l) min_sum = std::min(min_sum, sum[l]);
+        if (min_sum > bound) return false;
+    }
+    return true;
+}
+
+/// Best match of lower distance or of equal distance and lower index, like find_best_match
+template <typename T>
+struct BestMatchCandidate
+{
+    T distance = std::numeric_limits<T>::max();
+    uint32_t neuron = std::numeric_limits<uint32_t>::max();
+    uint32_t rotation = 0;
+
+    bool is_better_than(BestMatchCandidate const& other) const
+    {
+        return distance < other.distance or (distance == other.distance and neuron < other.neuron);
+    }
+};
+
+/// Each thread scans a contiguous range of neurons with its own bound, starting with the initial bound,
+/// the thread results are reduced by lowest distance and lowest neuron index.
+template <typename T, typename ScanNeuron>
+uint32_t find_best_match_pruned(T& min_distance, uint32_t& best_rotation, uint32_t som_size,
+    ScanNeuron const& scan_neuron, T initial_bound)
+{
+    BestMatchCandidate<T> best;
+
+    #pragma omp parallel
+    {
+        BestMatchCandidate<T> local;
+        T bound = initial_bound;
+
+        #pragma omp for schedule(static) nowait
+        for (uint32_t i = 0; i < som_size; ++i)
+        {
+            uint32_t rotation = 0;
+            if (scan_neuron(i, bound, rotation)) {
+                local.distance = bound;
+                local.neuron = i;
+                local.rotation = rotation;
+            }
+        }
+
+        #pragma omp critical (find_best_match_pruned)
+        if (local.is_better_than(best)) best = local;
+    }
+
+    min_distance = best.distance;
+    best_rotation = best.rotation;
+    return best.neuron;
+}
+
+} // namespace detail
+
+/// Phase one of the two-phase search: returns the best matching neuron and its euclidean distance and
+/// best spatial transformation, without calculating the distances of all other neurons.
+/// The summation over a transformation is abandoned as soon as it exceeds the lowest distance found so far.
+/// Neurons and transformations are scanned in the order of generate_euclidean_distance_matrix and ties are
+/// resolved to the lowest index, so that the result is exactly the one of find_best_match.
+/// An initial bound, e.g. the distance of the previous best match, abandons the summations earlier.
+/// If no distance is below it, the returned neuron is std::numeric_limits<uint32_t>::max().
+template <typename T>
+uint32_t find_best_match_pruned(T& min_distance, uint32_t& best_rotation, uint32_t som_size, T const *som,
+    uint32_t neuron_size, uint32_t number_of_spatial_transformations, std::vector<T> const& rotated_images,
+    std::vector<uint32_t> const& region, T initial_bound = std::numeric_limits<T>::max())
+{
+    auto region_size = static_cast<uint32_t>(region.size());
+    uint32_t const *region_ptr = region.data();
+
+    return detail::find_best_match_pruned(min_distance, best_rotation, som_size,
+        [&](uint32_t i, T& bound, uint32_t& rotation)
+    {
+        T const *neuron = &som[static_cast<size_t>(i) * neuron_size];
+        bool found = false;
+        for (uint32_t j = 0; j < number_of_spatial_transformations; ++j) {
+            T distance;
+            if (!detail::euclidean_distance_pruned(distance, neuron, &rotated_images[static_cast<size_t>(j) * neuron_size],
+                region_ptr, region_size, bound)) continue;
+            if (distance < bound) {
+                bound = distance;
+                rotation = j;
+                found = true;
+            }
+        }
+        return found;
+    }, initial_bound);
+}
+
+/// Same as above for the spatial transformed images in pixel-major layout.
+/// A block is abandoned if the partial sums of all its transformations exceed the bound.
+template <typename T>
+uint32_t find_best_match_pruned_pixel_major(T& min_distance, uint32_t& best_rotation, uint32_t som_size,
+    T const *som, uint32_t neuron_size, uint32_t number_of_spatial_transformations,
+    std::vector<T> const& interleaved_images, std::vector<uint32_t> const& region,
+    T initial_bound = std::numeric_limits<T>::max())
+{
+    constexpr uint32_t W = pixel_major_block_size;
+    auto region_size = static_cast<uint32_t>(region.size());
+    auto number_of_blocks = (number_of_spatial_transformations + W - 1) / W;
+    uint32_t const *region_ptr = region.data();
+
+    return detail::find_best_match_pruned(min_distance, best_rotation, som_size,
+        [&](uint32_t i, T& bound, uint32_t& rotation)
+    {
+        T const *neuron = &som[static_cast<size_t>(i) * neuron_size];
+        bool found = false;
+        for (uint32_t b = 0; b < number_of_blocks; ++b) {
+            T sum[W];
+            auto number_of_lanes = std::min(W, number_of_spatial_transformations - b * W);
+            if (!detail::euclidean_distance_block_pruned(sum, neuron,
+                &interleaved_images[static_cast<size_t>(b) * region_size * W],
+                region_ptr, region_size, number_of_lanes, bound)) continue;
+            for (uint32_t l = 0; l < number_of_lanes; ++l) {
+                if (sum[l] < bound) {
+                    bound = sum[l];
+                    rotation = b * W + l;
+                    found = true;
+                }
+            }
+        }
+        return found;
+    }, initial_bound);
+}
+
+/// Phase two of the two-phase search: best spatial transformation of the given neurons, e.g. the neurons
+/// with a non-zero update factor. The search is warm-started by the transformation start_rotation, typically
+/// the best one of the best match, whose distance bounds the summation of all other transformations.
+/// The result is exactly the one of generate_euclidean_distance_matrix for these neurons.
+template <typename T>
+void generate_best_rotations(std::vector<T>& euclidean_distance_matrix, std::vector<uint32_t>& best_rotation_matrix,
+    std::vector<uint32_t> const& neuron_indices, T const *som, uint32_t neuron_size,
+    uint32_t number_of_spatial_transformations, std::vector<T> const& rotated_images,
+    std::vector<uint32_t> const& region, uint32_t start_rotation)
+{
+    auto region_size = static_cast<uint32_t>(region.size());
+    uint32_t const *region_ptr = region.data();
+    auto number_of_neurons = static_cast<uint32_t>(neuron_indices.size());
+
+    #pragma omp parallel for
+    for (uint32_t n = 0; n < number_of_neurons; ++n)
+    {
+        auto i = neuron_indices[n];
+        T const *neuron = &som[static_cast<size_t>(i) * neuron_size];
+
+        T min_distance = std::numeric_limits<T>::max();
+        detail::euclidean_distance_pruned(min_distance, neuron, &rotated_images[static_cast<size_t>(start_rotation) * neuron_size],
+            region_ptr, region_size, min_distance);
+        uint32_t best_rotation = start_rotation;
+
+        for (uint32_t j = 0; j < number_of_spatial_transformations; ++j) {
+            if (j == start_rotation) continue;
+            T distance;
+            if (!detail::euclidean_distance_pruned(distance, neuron, &rotated_images[static_cast<size_t>(j) * neuron_size],
+                region_ptr, region_size, min_distance)) continue;
+            if (distance < min_distance or (distance == min_distance and j < best_rotation)) {
+                min_distance = distance;
+                best_rotation = j;
+            }
+        }
+
+        euclidean_distance_matrix[i] = min_distance;
+        best_rotation_matrix[i] = best_rotation;
+    }
+}
+
+/// Same as above for the spatial transformed images in pixel-major layout.
+/// The block of start_rotation is calculated first and bounds all other blocks.
+template <typename T>
+void generate_best_rotations_pixel_major(std::vector<T>& euclidean_distance_matrix,
+    std::vector<uint32_t>& best_rotation_matrix, std::vector<uint32_t> const& neuron_indices, T const *som,
+    uint32_t neuron_size, uint32_t number_of_spatial_transformations, std::vector<T> const& interleaved_images,
+    std::vector<uint32_t> const& region, uint32_t start_rotation)
+{
+    constexpr uint32_t W = pixel_major_block_size;
+    auto region_size = static_cast<uint32_t>(region.size());
+    auto number_of_blocks = (number_of_spatial_transformations + W - 1) / W;
+    auto start_block = start_rotation / W;
+    uint32_t const *region_ptr = region.data();
+    auto number_of_neurons = static_cast<uint32_t>(neuron_indices.size());
+
+    #pragma omp parallel for
+    for (uint32_t n = 0; n < number_of_neurons; ++n)
+    {
+        auto i = neuron_indices[n];
+        T const *neuron = &som[static_cast<size_t>(i) * neuron_size];
+        T min_distance = std::numeric_limits<T>::max();
+        uint32_t best_rotation = 0;
+
+        for (uint32_t k = 0; k < number_of_blocks; ++k)
+        {
+            auto b = k == 0 ? start_block : (k <= start_block ? k - 1 : k);
+            T sum[W];
+            auto number_of_lanes = std::min(W, number_of_spatial_transformations - b * W);
+            if (!detail::euclidean_distance_block_pruned(sum, neuron,
+                &interleaved_images[static_cast<size_t>(b) * region_size * W],
+                region_ptr, region_size, number_of_lanes, min_distance)) continue;
+            for (uint32_t l = 0; l < number_of_lanes; ++l) {
+                auto j = b * W + l;
+                if (sum[l] < min_distance or (sum[l] == min_distance and j < best_rotation)) {
+                    min_distance = sum[l];
+                    best_rotation = j;
+                }
+            }
+        }
+
+        euclidean_distance_matrix[i] = min_distance;
+        best_rotation_matrix[i] = best_rotation;
+    }
+}
+
+} // namespace pink
@@ -37,24 +37,77 @@ void generate_euclidean_distance_matrix(std::vector<T>& euclidean_distance_matri
         }
     }
 
+    // Each thread keeps the minimum of its rotations and merges it once per neuron.
+    // Equal distances are resolved to the lowest rotation, so that the result
+    // does not depend on the number of threads and the order of the merges.
+    #pragma omp parallel
     for (uint32_t i = 0; i < som_size; ++i)
     {
-        euclidean_distance_matrix[i] = ed_func(&som[i * data_layout.size()],
-                   &rotated_images[0], data_layout, euclidean_distance_dim);
+        #pragma omp single
+        {
+            euclidean_distance_matrix[i] = std::numeric_limits<T>::max();
+            best_rotation_matrix[i] = 0;
+        }
 
-        #pragma omp parallel for
-        for (uint32_t j = 1; j < num_rot; ++j)
+        T local_distance = std::numeric_limits<T>::max();
+        uint32_t local_rotation = 0;
+
+        #pragma omp for schedule(static) nowait
+        for (uint32_t j = 0; j < num_rot; ++j)
         {
             auto tmp = ed_func(&som[i * data_layout.size()],
                        &rotated_images[j * data_layout.size()], data_layout, euclidean_distance_dim);
+            if (tmp < local_distance)
+            {
+                local_distance = tmp;
+                local_rotation = j;
+            }
+        }
 
-            #pragma omp critical
-            if (tmp < euclidean_distance_matrix[i])
+        #pragma omp critical (generate_euclidean_distance_matrix)
+        if (local_distance < euclidean_distance_matrix[i] or
+            (local_distance == euclidean_distance_matrix[i] and local_rotation < best_rotation_matrix[i]))
+        {
+            euclidean_distance_matrix[i] = local_distance;
+            best_rotation_matrix[i] = local_rotation;
+        }
+    }
+}
+
+/// Same as above, but only for the given neurons, e.g. a window of the SOM.
+/// The entries of all other neurons are not changed.
+template <typename DataLayout, typename T>
+void generate_euclidean_distance_matrix(std::vector<T>& euclidean_distance_matrix,
+    std::vector<uint32_t>& best_rotation_matrix, std::vector<uint32_t> const& neuron_indices, T const *som,
+    DataLayout const& data_layout, uint32_t num_rot, std::vector<T> const& rotated_images,
+    uint32_t euclidean_distance_dim, EuclideanDistanceShape const& euclidean_distance_shape)
+{
+    std::function<T(T const*, T const*, DataLayout const&, uint32_t)> ed_func;
+    if (euclidean_distance_shape == EuclideanDistanceShape::CIRCULAR) ed_func = CircularEuclideanDistanceFunctor<DataLayout>();
+    else ed_func = EuclideanDistanceFunctor<DataLayout>();
+
+    auto number_of_neurons = static_cast<uint32_t>(neuron_indices.size());
+
+    #pragma omp parallel for
+    for (uint32_t n = 0; n < number_of_neurons; ++n)
+    {
+        auto i = neuron_indices[n];
+        T const *neuron = &som[static_cast<size_t>(i) * data_layout.size()];
+        T min_distance = ed_func(neuron, &rotated_images[0], data_layout, euclidean_distance_dim);
+        uint32_t best_rotation = 0;
+
+        for (uint32_t j = 1; j < num_rot; ++j)
+        {
+            auto tmp = ed_func(neuron, &rotated_images[j * data_layout.size()], data_layout, euclidean_distance_dim);
+            if (tmp < min_distance)
             {
-                euclidean_distance_matrix[i] = tmp;
-                best_rotation_matrix[i] = j;
+                min_distance = tmp;
+                best_rotation = j;
             }
         }
+
+        euclidean_distance_matrix[i] = min_distance;
+        best_rotation_matrix[i] = best_rotation;
     }
 }
 
@@ -0,0 +1,195 @@
+/**
+ * @file   SelfOrganizingMapLib/generate_euclidean_distance_matrix_pixel_major.h
+ * @brief  Euclidean distance matrix with rotations as SIMD lanes
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include "CartesianLayout.h"
+#include "UtilitiesLib/EuclideanDistanceShape.h"
+
+namespace pink {
+
+/// Number of spatial transformations which are interleaved in one block of the pixel-major layout
+#if defined(__AVX512F__)
+constexpr uint32_t pixel_major_block_size = 16;
+#elif defined(__AVX__)
+constexpr uint32_t pixel_major_block_size = 8;
+#else
+constexpr uint32_t pixel_major_block_size = 4;
+#endif
+
+/// Returns the pixel indices of the euclidean distance region in the same order
+/// as they are visited by EuclideanDistanceFunctor and CircularEuclideanDistanceFunctor
+inline std::vector<uint32_t> get_euclidean_distance_region(CartesianLayout<1> const& data_layout,
+    [[maybe_unused]] uint32_t euclidean_distance_dim,
+    [[maybe_unused]] EuclideanDistanceShape const& euclidean_distance_shape)
+{
+    std::vector<uint32_t> region(data_layout.get_dimension(0));
+    std::iota(region.begin(), region.end(), 0);
+    return region;
+}
+
+inline std::vector<uint32_t> get_euclidean_distance_region(CartesianLayout<2> const& data_layout,
+    uint32_t euclidean_distance_dim, EuclideanDistanceShape const& euclidean_distance_shape)
+{
+    std::vector<uint32_t> region;
+    auto dim = data_layout.get_dimension(0);
+
+    if (euclidean_distance_shape == EuclideanDistanceShape::CIRCULAR) {
+        auto center = dim / 2;
+        auto radius = euclidean_distance_dim / 2;
+        for (uint32_t i = 0; i < euclidean_distance_dim; ++i) {
+            auto delta = std::sqrt(2 * radius * (i + 0.5) - std::pow((i + 0.5), 2));
+            uint32_t global_i = i + (dim - euclidean_distance_dim) / 2;
+            for (uint32_t j = std::round(center - delta); j < std::round(center + delta); ++j) {
+                region.push_back(global_i * dim + j);
+            }
+        }
+    } else {
+        auto beg = static_cast<uint32_t>((dim - euclidean_distance_dim) * 0.5);
+        auto end = beg + euclidean_distance_dim;
+        for (uint32_t i = beg; i < end; ++i) {
+            for (uint32_t j = beg; j < end; ++j) {
+                region.push_back(i * dim + j);
+            }
+        }
+    }
+    return region;
+}
+
+inline std::vector<uint32_t> get_euclidean_distance_region(CartesianLayout<3> const& data_layout,
+    uint32_t euclidean_distance_dim, EuclideanDistanceShape const& euclidean_distance_shape)
+{
+    CartesianLayout<2> channel_layout{data_layout.get_dimension(1), data_layout.get_dimension(2)};
+    auto channel_region = get_euclidean_distance_region(channel_layout,
+        euclidean_distance_dim, euclidean_distance_shape);
+
+    auto depth = data_layout.get_dimension(0);
+    auto stride = static_cast<uint32_t>(data_layout.get_stride(0));
+
+    std::vector<uint32_t> region;
+    region.reserve(depth * channel_region.size());
+    for (uint32_t d = 0; d < depth; ++d) {
+        for (auto p : channel_region) region.push_back(d * stride + p);
+    }
+    return region;
+}
+
+/// Copy the euclidean distance region of the spatial transformed images from the
+/// neuron-major layout [transformation][pixel] into the pixel-major layout
+/// [block][region pixel][transformation % pixel_major_block_size]
+template <typename T>
+void interleave_spatial_transformed_images(std::vector<T>& interleaved_images,
+    std::vector<T> const& spatial_transformed_images, uint32_t number_of_spatial_transformations,
+    uint32_t image_size, std::vector<uint32_t> const& region)
+{
+    constexpr uint32_t W = pixel_major_block_size;
+    auto region_size = static_cast<uint32_t>(region.size());
+    auto number_of_blocks = (number_of_spatial_transformations + W - 1) / W;
+
+    // Lanes behind the last transformation are never reduced, their content is arbitrary
+    interleaved_images.resize(static_cast<size_t>(number_of_blocks) * region_size * W);
+
+    #pragma omp parallel for
+    for (uint32_t t = 0; t < number_of_spatial_transformations; ++t) {
+        T const *src = &spatial_transformed_images[static_cast<size_t>(t) * image_size];
+        T *dst = &interleaved_images[static_cast<size_t>(t / W) * region_size * W + t % W];
+        for (uint32_t p = 0; p < region_size; ++p) {
+            dst[p * W] = src[region[p]];
+        }
+    }
+}
+
+namespace detail {
+
+/// Pixel-major euclidean distances of the neurons get_neuron_index(n), 0 <= n < number_of_neurons
+template <typename T, typename NeuronIndex>
+void generate_euclidean_distance_matrix_pixel_major(std::vector<T>& euclidean_distance_matrix,
+    std::vector<uint32_t>& best_rotation_matrix, uint32_t number_of_neurons, NeuronIndex const& get_neuron_index,
+    T const *som, uint32_t neuron_size, uint32_t number_of_spatial_transformations,
+    std::vector<T> const& interleaved_images, std::vector<uint32_t> const& region)
+{
+    constexpr uint32_t W = pixel_major_block_size;
+    auto region_size = static_cast<uint32_t>(region.size());
+    auto number_of_blocks = (number_of_spatial_transformations + W - 1) / W;
+    uint32_t const *region_ptr = region.data();
+
+    #pragma omp parallel for
+    for (uint32_t n = 0; n < number_of_neurons; ++n)
+    {
+        auto i = get_neuron_index(n);
+        T const *neuron = &som[static_cast<size_t>(i) * neuron_size];
+        T min_distance = std::numeric_limits<T>::max();
+        uint32_t best_rotation = 0;
+
+        for (uint32_t b = 0; b < number_of_blocks; ++b)
+        {
+            T const *block = &interleaved_images[static_cast<size_t>(b) * region_size * W];
+            T sum[W] = {};
+
+            for (uint32_t p = 0; p < region_size; ++p) {
+                T value = neuron[region_ptr[p]];
+                T const *lane = block + p * W;
+                #pragma omp simd
+                for (uint32_t l = 0; l < W; ++l) {
+                    T diff = value - lane[l];
+                    sum[l] += diff * diff;
+                }
+            }
+
+            auto number_of_lanes = std::min(W, number_of_spatial_transformations - b * W);
+            for (uint32_t l = 0; l < number_of_lanes; ++l) {
+                if (sum[l] < min_distance) {
+                    min_distance = sum[l];
+                    best_rotation = b * W + l;
+                }
+            }
+        }
+
+        euclidean_distance_matrix[i] = min_distance;
+        best_rotation_matrix[i] = best_rotation;
+    }
+}
+
+} // namespace detail
+
+/// Same result as generate_euclidean_distance_matrix, but the neuron pixel is broadcasted
+/// and pixel_major_block_size transformations are accumulated in parallel.
+/// The minimum over the transformations is a final horizontal reduction of each block.
+/// Ties are resolved to the lowest transformation index.
+template <typename T>
+void generate_euclidean_distance_matrix_pixel_major(std::vector<T>& euclidean_distance_matrix,
+    std::vector<uint32_t>& best_rotation_matrix, uint32_t som_size, T const *som, uint32_t neuron_size,
+    uint32_t number_of_spatial_transformations, std::vector<T> const& interleaved_images,
+    std::vector<uint32_t> const& region)
+{
+    detail::generate_euclidean_distance_matrix_pixel_major(euclidean_distance_matrix, best_rotation_matrix,
+        som_size, [](uint32_t n) { return n; }, som, neuron_size, number_of_spatial_transformations,
+        interleaved_images, region);
+}
+
+/// Same as above, but only for the given neurons, e.g. a window of the SOM.
+/// The entries of all other neurons are not changed.
+template <typename T>
+void generate_euclidean_distance_matrix_pixel_major(std::vector<T>& euclidean_distance_matrix,
+    std::vector<uint32_t>& best_rotation_matrix, std::vector<uint32_t> const& neuron_indices, T const *som,
+    uint32_t neuron_size, uint32_t number_of_spatial_transformations, std::vector<T> const& interleaved_images,
+    std::vector<uint32_t> const& region)
+{
+    uint32_t const *indices = neuron_indices.data();
+    detail::generate_euclidean_distance_matrix_pixel_major(euclidean_distance_matrix, best_rotation_matrix,
+        static_cast<uint32_t>(neuron_indices.size()), [indices](uint32_t n) { return indices[n]; },
+        som, neuron_size, number_of_spatial_transformations, interleaved_images, region);
+}
+
+} // namespace pink
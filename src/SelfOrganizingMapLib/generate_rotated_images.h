@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <omp.h>
@@ -23,9 +24,18 @@
 namespace pink {
 
 /// Primary template for SpatialTransformer
+///
+/// The spatial transformed images are written into rotated_images, which is resized if needed.
+/// The buffer is only used for 3D data. Reusing both vectors avoids heap allocations.
 template <typename DataLayout>
 struct SpatialTransformer
 {
+    template <typename NeuronLayout, typename T>
+    void operator () (std::vector<T>& rotated_images, std::vector<T>& buffer, Data<DataLayout, T> const& data,
+        uint32_t number_of_rotations, bool use_flip, Interpolation interpolation,
+        NeuronLayout const& neuron_layout) const;
+
+    /// Returns the spatial transformed images in a new vector
     template <typename NeuronLayout, typename T>
     auto operator () (Data<DataLayout, T> const& data, uint32_t number_of_rotations, bool use_flip,
         Interpolation interpolation, NeuronLayout const& neuron_layout) const;
@@ -36,12 +46,21 @@ template <>
 struct SpatialTransformer<CartesianLayout<1>>
 {
     template <typename NeuronLayout, typename T>
-    auto operator () ([[maybe_unused]] Data<CartesianLayout<1>, T> const& data,
+    void operator () ([[maybe_unused]] std::vector<T>& rotated_images, [[maybe_unused]] std::vector<T>& buffer,
+        [[maybe_unused]] Data<CartesianLayout<1>, T> const& data,
         [[maybe_unused]] uint32_t number_of_rotations, [[maybe_unused]] bool use_flip,
         [[maybe_unused]] Interpolation interpolation, [[maybe_unused]] NeuronLayout const& neuron_layout) const
     {
         throw pink::exception("Not implemented yet.");
-        return std::vector<T>();
+    }
+
+    template <typename NeuronLayout, typename T>
+    auto operator () (Data<CartesianLayout<1>, T> const& data, uint32_t number_of_rotations, bool use_flip,
+        Interpolation interpolation, NeuronLayout const& neuron_layout) const
+    {
+        std::vector<T> rotated_images, buffer;
+        operator()(rotated_images, buffer, data, number_of_rotations, use_flip, interpolation, neuron_layout);
+        return rotated_images;
     }
 };
 
@@ -52,6 +71,16 @@ struct SpatialTransformer<CartesianLayout<2>>
     template <typename NeuronLayout, typename T>
     auto operator () (Data<CartesianLayout<2>, T> const& data, uint32_t number_of_rotations, bool use_flip,
         Interpolation interpolation, NeuronLayout const& neuron_layout) const
+    {
+        std::vector<T> rotated_images, buffer;
+        operator()(rotated_images, buffer, data, number_of_rotations, use_flip, interpolation, neuron_layout);
+        return rotated_images;
+    }
+
+    template <typename NeuronLayout, typename T>
+    void operator () (std::vector<T>& rotated_images, [[maybe_unused]] std::vector<T>& buffer,
+        Data<CartesianLayout<2>, T> const& data, uint32_t number_of_rotations, bool use_flip,
+        Interpolation interpolation, NeuronLayout const& neuron_layout) const
     {
         // Images must be quadratic
         if (data.get_dimension()[0] != data.get_dimension()[1]) {
@@ -63,7 +92,7 @@ struct SpatialTransformer<CartesianLayout<2>>
         auto neuron_size = neuron_dim * neuron_dim;
 
         uint32_t number_of_spatial_transformations = number_of_rotations * (use_flip ? 2 : 1);
-        std::vector<T> rotated_images(number_of_spatial_transformations * neuron_size);
+        rotated_images.resize(number_of_spatial_transformations * neuron_size);
 
         uint32_t num_real_rot = number_of_rotations / 4;
         float angle_step_radians = static_cast<float>(2 * M_PI) / number_of_rotations;
@@ -75,6 +104,8 @@ struct SpatialTransformer<CartesianLayout<2>>
         // Copy original image to first position of image array
         T const *current_image = &data[0];
         T *current_rotated_image = &rotated_images[0];
+        // The margin is not written by resize, if the neuron is larger than the image
+        if (image_dim < neuron_dim) std::fill(current_rotated_image, current_rotated_image + neuron_size, 0);
         resize(current_image, current_rotated_image, image_dim, image_dim, neuron_dim, neuron_dim);
         if (number_of_rotations != 1) {
             rotate_90_degrees(current_rotated_image, current_rotated_image + offset1,
@@ -111,8 +142,6 @@ struct SpatialTransformer<CartesianLayout<2>>
                     neuron_dim, neuron_dim);
             }
         }
-
-        return rotated_images;
     }
 };
 
@@ -123,6 +152,16 @@ struct SpatialTransformer<CartesianLayout<3>>
     template <typename NeuronLayout, typename T>
     auto operator () (Data<CartesianLayout<3>, T> const& data, uint32_t number_of_rotations, bool use_flip,
         Interpolation interpolation, NeuronLayout const& neuron_layout) const
+    {
+        std::vector<T> rotated_images, buffer;
+        operator()(rotated_images, buffer, data, number_of_rotations, use_flip, interpolation, neuron_layout);
+        return rotated_images;
+    }
+
+    template <typename NeuronLayout, typename T>
+    void operator () (std::vector<T>& rotated_images, std::vector<T>& buffer,
+        Data<CartesianLayout<3>, T> const& data, uint32_t number_of_rotations, bool use_flip,
+        Interpolation interpolation, NeuronLayout const& neuron_layout) const
     {
         // Images must be quadratic
         if (data.get_dimension()[1] != data.get_dimension()[2]) {
@@ -136,7 +175,7 @@ struct SpatialTransformer<CartesianLayout<3>>
         auto spacing = data.get_dimension()[0];
 
         uint32_t number_of_spatial_transformations = number_of_rotations * (use_flip ? 2 : 1);
-        std::vector<T> rotated_images(number_of_spatial_transformations * neuron_size * spacing);
+        rotated_images.resize(number_of_spatial_transformations * neuron_size * spacing);
 
         uint32_t num_real_rot = number_of_rotations / 4;
         float angle_step_radians = static_cast<float>(2 * M_PI) / number_of_rotations;
@@ -151,6 +190,7 @@ struct SpatialTransformer<CartesianLayout<3>>
         {
             T const *current_image = &data[i * image_size];
             T *current_rotated_image = &rotated_images[i * neuron_size];
+            if (image_dim < neuron_dim) std::fill(current_rotated_image, current_rotated_image + neuron_size, 0);
             resize(current_image, current_rotated_image, image_dim, image_dim,
                 neuron_dim, neuron_dim);
             if (number_of_rotations != 1) {
@@ -163,14 +203,24 @@ struct SpatialTransformer<CartesianLayout<3>>
             }
         }
 
+        // Interleave the channels ([pixel][channel]), so that the sampling pattern of each angle
+        // is calculated only once and one gather serves all channels
+        if (num_real_rot > 1) {
+            buffer.resize(spacing * image_size);
+            for (uint32_t j = 0; j < spacing; ++j) {
+                for (uint32_t p = 0; p < image_size; ++p) {
+                    buffer[p * spacing + j] = data[j * image_size + p];
+                }
+            }
+        }
+
         // Rotate images
         #pragma omp parallel for
         for (uint32_t i = 1; i < num_real_rot; ++i) {
+            rotate_channels(&buffer[0], &rotated_images[i * spacing * neuron_size],
+                image_dim, image_dim, neuron_dim, neuron_dim, i * angle_step_radians, spacing, interpolation);
             for (uint32_t j = 0; j < spacing; ++j) {
-                T const *current_image = &data[j * image_size];
                 T *current_rotated_image = &rotated_images[(i * spacing + j) * neuron_size];
-                rotate(current_image, current_rotated_image, image_dim, image_dim,
-                    neuron_dim, neuron_dim, i * angle_step_radians, interpolation);
                 rotate_90_degrees(current_rotated_image, current_rotated_image + offset1,
                     neuron_dim, neuron_dim);
                 rotate_90_degrees(current_rotated_image + offset1, current_rotated_image + offset2,
@@ -194,8 +244,6 @@ struct SpatialTransformer<CartesianLayout<3>>
                 }
             }
         }
-
-        return rotated_images;
     }
 };
 
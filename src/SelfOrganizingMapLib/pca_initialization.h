@@ -0,0 +1,338 @@
+/**
+ * @file   SelfOrganizingMapLib/pca_initialization.h
+ * @brief  SOM initialization on the plane of the principal components of the data
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <istream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "CartesianLayout.h"
+#include "DataIterator.h"
+#include "generate_rotated_images.h"
+#include "HexagonalLayout.h"
+#include "UtilitiesLib/pink_exception.h"
+
+namespace pink {
+
+/// Number of data points which are kept in memory during a pass over the data
+constexpr uint32_t pca_chunk_size = 256;
+
+/// Number of additional random vectors of the randomized subspace iteration
+constexpr uint32_t pca_oversampling = 10;
+
+/// Number of passes over the data refining the subspace before the final projection
+constexpr uint32_t pca_power_iterations = 1;
+
+/// Leading principal components of the data, sorted by decreasing variance
+struct PrincipalComponents
+{
+    /// Mean of the data, dimension D
+    std::vector<double> mean;
+
+    /// Principal components, row-major (number of components x D), each of unit length
+    std::vector<double> components;
+
+    /// Variance of the data along each principal component
+    std::vector<double> variances;
+};
+
+namespace detail {
+
+/// One pass over the data: returns the product C·M of the covariance matrix C of the data and the
+/// matrix M (row-major D x k). The data points are cropped to the neuron layout and processed in chunks
+/// of pca_chunk_size, so that the memory does not depend on the number of data points. If calc_mean
+/// is set, the mean is calculated in the same pass, otherwise the given mean is used.
+/// The summation order does not depend on the number of threads.
+template <typename DataLayout, typename T, typename NeuronLayout>
+std::vector<double> covariance_product(std::istream& is, NeuronLayout const& neuron_layout,
+    std::vector<double> const& m, uint32_t k, std::vector<double>& mean, bool calc_mean)
+{
+    auto dim = static_cast<uint32_t>(neuron_layout.size());
+
+    std::vector<double> s(static_cast<size_t>(dim) * k, 0.0);
+    std::vector<double> chunk(static_cast<size_t>(pca_chunk_size) * dim);
+    std::vector<double> p(static_cast<size_t>(pca_chunk_size) * k);
+    std::vector<double> sum(dim, 0.0);
+    std::vector<T> image, buffer;
+    uint64_t number_of_data_points = 0;
+
+    auto process_chunk = [&](uint32_t size)
+    {
+        // P = X·M, parallel over the data points
+        #pragma omp parallel for
+        for (uint32_t c = 0; c < size; ++c) {
+            double const *x = &chunk[static_cast<size_t>(c) * dim];
+            double *pc = &p[static_cast<size_t>(c) * k];
+            std::fill(pc, pc + k, 0.0);
+            for (uint32_t d = 0; d < dim; ++d) {
+                double const *md = &m[static_cast<size_t>(d) * k];
+                for (uint32_t j = 0; j < k; ++j) pc[j] += x[d] * md[j];
+            }
+        }
+
+        // S += Xᵀ·P, parallel over the dimensions
+        #pragma omp parallel for
+        for (uint32_t d = 0; d < dim; ++d) {
+            double *sd = &s[static_cast<size_t>(d) * k];
+            for (uint32_t c = 0; c < size; ++c) {
+                double x = chunk[static_cast<size_t>(c) * dim + d];
+                double const *pc = &p[static_cast<size_t>(c) * k];
+                for (uint32_t j = 0; j < k; ++j) sd[j] += x * pc[j];
+            }
+            if (calc_mean) for (uint32_t c = 0; c < size; ++c) sum[d] += chunk[static_cast<size_t>(c) * dim + d];
+        }
+    };
+
+    uint32_t size = 0;
+    for (DataIterator<DataLayout, T> iter(is), end(is, true); iter != end; ++iter)
+    {
+        SpatialTransformer<DataLayout>()(image, buffer, *iter, 1, false, Interpolation::BILINEAR, neuron_layout);
+        std::copy(image.begin(), image.begin() + dim, chunk.begin() + static_cast<std::ptrdiff_t>(size) * dim);
+        ++number_of_data_points;
+        if (++size == pca_chunk_size) {
+            process_chunk(size);
+            size = 0;
+        }
+    }
+    if (size != 0) process_chunk(size);
+
+    if (number_of_data_points == 0) throw pink::exception("PCA initialization needs at least one data point");
+
+    if (calc_mean) {
+        mean.resize(dim);
+        for (uint32_t d = 0; d < dim; ++d) mean[d] = sum[d] / number_of_data_points;
+    }
+
+    // C·M = Xᵀ·X·M / n - μ·(μᵀ·M)
+    std::vector<double> mean_m(k, 0.0);
+    for (uint32_t d = 0; d < dim; ++d)
+        for (uint32_t j = 0; j < k; ++j) mean_m[j] += mean[d] * m[static_cast<size_t>(d) * k + j];
+
+    for (uint32_t d = 0; d < dim; ++d)
+        for (uint32_t j = 0; j < k; ++j) {
+            auto&& e = s[static_cast<size_t>(d) * k + j];
+            e = e / number_of_data_points - mean[d] * mean_m[j];
+        }
+
+    return s;
+}
+
+/// Orthonormalize the columns of the row-major matrix m (D x k) by modified Gram-Schmidt.
+/// The orthogonalization is repeated once to compensate the loss of orthogonality.
+/// Columns which are linearly dependent on the preceding ones are set to zero.
+inline void orthonormalize(std::vector<double>& m, uint32_t dim, uint32_t k)
+{
+    auto column_dot = [&](uint32_t a, uint32_t b) {
+        double dot = 0.0;
+        for (uint32_t d = 0; d < dim; ++d) dot += m[static_cast<size_t>(d) * k + a] * m[static_cast<size_t>(d) * k + b];
+        return dot;
+    };
+
+    for (uint32_t j = 0; j < k; ++j) {
+        auto norm0 = std::sqrt(column_dot(j, j));
+        for (int repeat = 0; repeat < 2; ++repeat) {
+            for (uint32_t i = 0; i < j; ++i) {
+                auto dot = column_dot(i, j);
+                for (uint32_t d = 0; d < dim; ++d) m[static_cast<size_t>(d) * k + j] -= dot * m[static_cast<size_t>(d) * k + i];
+            }
+        }
+        auto norm = std::sqrt(column_dot(j, j));
+        auto scale = norm > 1e-12 * norm0 and norm > 0.0 ? 1.0 / norm : 0.0;
+        for (uint32_t d = 0; d < dim; ++d) m[static_cast<size_t>(d) * k + j] *= scale;
+    }
+}
+
+/// Eigenvalues and eigenvectors of the symmetric matrix a (k x k) by the cyclic Jacobi method.
+/// The eigenvectors are returned as columns of the row-major matrix v.
+inline void symmetric_eigen(std::vector<double> a, uint32_t k, std::vector<double>& eigenvalues,
+    std::vector<double>& v)
+{
+    v.assign(static_cast<size_t>(k) * k, 0.0);
+    for (uint32_t i = 0; i < k; ++i) v[i * k + i] = 1.0;
+
+    for (int sweep = 0; sweep < 100; ++sweep)
+    {
+        double off = 0.0, diag = 0.0;
+        for (uint32_t i = 0; i < k; ++i) {
+            diag += a[i * k + i] * a[i * k + i];
+            for (uint32_t j = i + 1; j < k; ++j) off += a[i * k + j] * a[i * k + j];
+        }
+        if (off <= 1e-30 * diag or off == 0.0) break;
+
+        for (uint32_t p = 0; p < k; ++p) {
+            for (uint32_t q = p + 1; q < k; ++q) {
+                if (a[p * k + q] == 0.0) continue;
+                double theta = (a[q * k + q] - a[p * k + p]) / (2.0 * a[p * k + q]);
+                double t = (theta >= 0.0 ? 1.0 : -1.0) / (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+                double c = 1.0 / std::sqrt(t * t + 1.0);
+                double s = t * c;
+
+                for (uint32_t i = 0; i < k; ++i) {
+                    double aip = a[i * k + p], aiq = a[i * k + q];
+                    a[i * k + p] = c * aip - s * aiq;
+                    a[i * k + q] = s * aip + c * aiq;
+                }
+                for (uint32_t i = 0; i < k; ++i) {
+                    double api = a[p * k + i], aqi = a[q * k + i];
+                    a[p * k + i] = c * api - s * aqi;
+                    a[q * k + i] = s * api + c * aqi;
+                }
+                for (uint32_t i = 0; i < k; ++i) {
+                    double vip = v[i * k + p], viq = v[i * k + q];
+                    v[i * k + p] = c * vip - s * viq;
+                    v[i * k + q] = s * vip + c * viq;
+                }
+            }
+        }
+    }
+
+    eigenvalues.resize(k);
+    for (uint32_t i = 0; i < k; ++i) eigenvalues[i] = a[i * k + i];
+}
+
+/// Normalized coordinates in [-1, 1] of all neurons (row-major, number of neurons x dim).
+/// The axes of the layout positions are assigned to the components by decreasing extent.
+template <uint8_t dim>
+std::vector<double> get_pca_coordinates(CartesianLayout<dim> const& som_layout)
+{
+    auto size = static_cast<uint32_t>(som_layout.size());
+
+    // The extent of an axis is taken from the positions, which are the ones of the neighborhood
+    std::array<uint32_t, dim> extent{};
+    for (uint32_t i = 0; i < size; ++i) {
+        auto position = som_layout.get_position(i);
+        for (uint8_t a = 0; a < dim; ++a) extent[a] = std::max(extent[a], position[a] + 1);
+    }
+
+    std::vector<uint8_t> axes(dim);
+    std::iota(axes.begin(), axes.end(), 0);
+    std::stable_sort(axes.begin(), axes.end(), [&](uint8_t a, uint8_t b) { return extent[a] > extent[b]; });
+
+    std::vector<double> coordinates(static_cast<size_t>(size) * dim, 0.0);
+    for (uint32_t i = 0; i < size; ++i) {
+        auto position = som_layout.get_position(i);
+        for (uint8_t c = 0; c < dim; ++c) {
+            auto a = axes[c];
+            if (extent[a] > 1) coordinates[i * dim + c] = 2.0 * position[a] / (extent[a] - 1) - 1.0;
+        }
+    }
+    return coordinates;
+}
+
+/// Cartesian coordinates of the hexagon centers of all neurons, normalized by the radius
+inline std::vector<double> get_pca_coordinates(HexagonalLayout const& som_layout)
+{
+    auto size = static_cast<uint32_t>(som_layout.size());
+    std::vector<double> coordinates(2 * static_cast<size_t>(size), 0.0);
+    if (som_layout.m_radius == 0) return coordinates;
+
+    for (uint32_t i = 0; i < size; ++i) {
+        auto position = som_layout.get_position(i);
+        auto q = static_cast<double>(position[0]) - som_layout.m_radius;
+        auto r = static_cast<double>(position[1]) - som_layout.m_radius;
+        coordinates[2 * i] = (q + 0.5 * r) / som_layout.m_radius;
+        coordinates[2 * i + 1] = 0.5 * std::sqrt(3.0) * r / som_layout.m_radius;
+    }
+    return coordinates;
+}
+
+} // namespace detail
+
+/// Leading principal components of the data, which are cropped to the neuron layout.
+/// Randomized subspace iteration (Halko, Martinsson, Tropp 2011) on the covariance matrix:
+/// each product with the covariance matrix is a single streaming pass over the data,
+/// so that only a chunk of data points and matrices of size D x (number of components + oversampling)
+/// are held in memory. The stream is rewound after each pass.
+template <typename DataLayout, typename T, typename NeuronLayout>
+PrincipalComponents get_principal_components(std::istream& is, NeuronLayout const& neuron_layout,
+    uint32_t number_of_components, uint32_t seed)
+{
+    auto dim = static_cast<uint32_t>(neuron_layout.size());
+    if (number_of_components == 0 or number_of_components > dim) {
+        throw pink::exception("Number of principal components must be between 1 and the neuron size");
+    }
+    auto k = std::min(number_of_components + pca_oversampling, dim);
+
+    // Random starting subspace
+    std::vector<double> q(static_cast<size_t>(dim) * k);
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> dist;
+    for (auto&& e : q) e = dist(rng);
+
+    PrincipalComponents result;
+    for (uint32_t pass = 0; pass <= pca_power_iterations; ++pass) {
+        q = detail::covariance_product<DataLayout, T>(is, neuron_layout, q, k, result.mean, pass == 0);
+        detail::orthonormalize(q, dim, k);
+    }
+
+    // Rayleigh-Ritz: eigendecomposition of the projection B = Qᵀ·C·Q
+    auto cq = detail::covariance_product<DataLayout, T>(is, neuron_layout, q, k, result.mean, false);
+    std::vector<double> b(static_cast<size_t>(k) * k, 0.0);
+    for (uint32_t d = 0; d < dim; ++d)
+        for (uint32_t i = 0; i < k; ++i)
+            for (uint32_t j = 0; j < k; ++j)
+                b[i * k + j] += q[static_cast<size_t>(d) * k + i] * cq[static_cast<size_t>(d) * k + j];
+    for (uint32_t i = 0; i < k; ++i)
+        for (uint32_t j = i + 1; j < k; ++j)
+            b[i * k + j] = b[j * k + i] = 0.5 * (b[i * k + j] + b[j * k + i]);
+
+    std::vector<double> eigenvalues, v;
+    detail::symmetric_eigen(b, k, eigenvalues, v);
+
+    std::vector<uint32_t> order(k);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return eigenvalues[a] > eigenvalues[b];
+    });
+
+    result.components.assign(static_cast<size_t>(number_of_components) * dim, 0.0);
+    result.variances.resize(number_of_components);
+    for (uint32_t c = 0; c < number_of_components; ++c) {
+        auto j = order[c];
+        result.variances[c] = std::max(eigenvalues[j], 0.0);
+        for (uint32_t d = 0; d < dim; ++d) {
+            double e = 0.0;
+            for (uint32_t i = 0; i < k; ++i) e += q[static_cast<size_t>(d) * k + i] * v[i * k + j];
+            result.components[static_cast<size_t>(c) * dim + d] = e;
+        }
+    }
+    return result;
+}
+
+/// Initialize the neurons [begin, end) on the plane (or space) spanned by the leading principal
+/// components of the data. The neurons of a SOM are placed on a regular grid from minus to plus
+/// the standard deviation along each component, centered at the mean of the data.
+template <typename DataLayout, typename T, typename SOMLayout, typename NeuronLayout>
+void initialize_by_pca(T *neurons, std::istream& is, SOMLayout const& som_layout, NeuronLayout const& neuron_layout,
+    uint32_t begin, uint32_t end, uint32_t seed)
+{
+    auto dim = static_cast<uint32_t>(neuron_layout.size());
+    uint32_t number_of_components = std::min<uint32_t>(SOMLayout::dimensionality, dim);
+    auto pca = get_principal_components<DataLayout, T>(is, neuron_layout, number_of_components, seed);
+    auto coordinates = detail::get_pca_coordinates(som_layout);
+
+    #pragma omp parallel for
+    for (uint32_t i = begin; i < end; ++i) {
+        double const *c_i = &coordinates[static_cast<size_t>(i) * SOMLayout::dimensionality];
+        T *neuron = neurons + static_cast<size_t>(i - begin) * dim;
+        for (uint32_t d = 0; d < dim; ++d) {
+            double value = pca.mean[d];
+            for (uint32_t c = 0; c < number_of_components; ++c) {
+                value += c_i[c] * std::sqrt(pca.variances[c]) * pca.components[static_cast<size_t>(c) * dim + d];
+            }
+            neuron[d] = static_cast<T>(value);
+        }
+    }
+}
+
+} // namespace pink
@@ -0,0 +1,68 @@
+/**
+ * @file   SelfOrganizingMapLib/read_neurons.h
+ * @brief  Read the neurons of a SOM file, which may have a different SOM layout
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "UtilitiesLib/get_file_header.h"
+#include "UtilitiesLib/pink_exception.h"
+#include "upsample.h"
+
+namespace pink {
+
+/// Read the neurons [begin, end) of a SOM with som_layout from a SOM file and returns the header of the file.
+/// If the SOM layout of the file differs in size, e.g. a coarse SOM of a previous training stage,
+/// the neurons are interpolated to som_layout. The neuron size must be equal.
+template <typename SOMLayout, typename T>
+std::string read_neurons(std::string const& filename, SOMLayout const& som_layout, uint32_t neuron_size,
+    T *data, uint32_t begin, uint32_t end)
+{
+    std::ifstream is(filename);
+    if (!is) throw pink::exception("Error opening " + filename);
+
+    auto header = get_file_header(is);
+
+    auto read_int = [&is](){
+        int value = 0;
+        is.read(reinterpret_cast<char*>(&value), sizeof(int));
+        return value;
+    };
+
+    // <file format version> 1 <data-type> <som layout> <neuron layout> <data>
+    read_int();
+    if (read_int() != 1) throw pink::exception("File " + filename + " is not a SOM file");
+    read_int();
+    read_int();
+    if (read_int() != SOMLayout::dimensionality) throw pink::exception("SOM dimensionality of " + filename + " does not match");
+    typename SOMLayout::DimensionType dimension;
+    for (auto&& d : dimension) d = static_cast<uint32_t>(read_int());
+    read_int();
+    int neuron_dimensionality = read_int();
+    uint32_t file_neuron_size = 1;
+    for (int i = 0; i < neuron_dimensionality; ++i) file_neuron_size *= static_cast<uint32_t>(read_int());
+    if (!is) throw pink::exception("Error reading " + filename);
+    if (file_neuron_size != neuron_size) throw pink::exception("Neuron size of " + filename + " does not match");
+
+    if (dimension == som_layout.m_dimension) {
+        is.seekg(static_cast<std::streamoff>(static_cast<size_t>(begin) * neuron_size * sizeof(T)), is.cur);
+        is.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(static_cast<size_t>(end - begin) * neuron_size * sizeof(T)));
+    } else {
+        SOMLayout file_layout{dimension};
+        std::vector<T> file_data(static_cast<size_t>(file_layout.size()) * neuron_size);
+        is.read(reinterpret_cast<char*>(file_data.data()), static_cast<std::streamsize>(file_data.size() * sizeof(T)));
+        upsample(file_layout, file_data.data(), som_layout, data, neuron_size, begin, end);
+    }
+    if (!is) throw pink::exception("Error reading " + filename);
+
+    return header;
+}
+
+} // namespace pink
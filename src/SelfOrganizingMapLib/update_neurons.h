@@ -0,0 +1,48 @@
+/**
+ * @file   SelfOrganizingMapLib/update_neurons.h
+ * @brief  CPU update of the neurons in the neighborhood of the best matching neuron
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace pink {
+
+/// Move a single neuron towards the image: neuron -= (neuron - image) * factor
+///
+/// The loop has no dependencies between the pixels and is vectorized.
+/// On targets supporting FMA (e.g. -march=native) the multiply-subtract is fused.
+template <typename T>
+inline void update_neuron(T *neuron, T const *image, float factor, uint32_t neuron_size)
+{
+    #pragma omp simd
+    for (uint32_t j = 0; j < neuron_size; ++j) {
+        neuron[j] -= (neuron[j] - image[j]) * factor;
+    }
+}
+
+/// Update only the neurons with a non-zero factor, which are given by a list of neuron indices
+/// and corresponding factors. Each neuron is moved towards its best rotated image.
+/// The neurons are independent, so that the list is split across the threads.
+template <typename T>
+void update_neurons(T *som, uint32_t neuron_size, T const *spatial_transformed_images,
+    uint32_t const *best_rotation_matrix, uint32_t const *neuron_indices, float const *factors,
+    uint32_t number_of_neurons)
+{
+    // Small updates are not worth the thread synchronization
+    bool parallel = static_cast<uint64_t>(number_of_neurons) * neuron_size > 16384;
+
+    #pragma omp parallel for schedule(static) if(parallel)
+    for (uint32_t n = 0; n < number_of_neurons; ++n)
+    {
+        auto i = neuron_indices[n];
+        update_neuron(som + static_cast<size_t>(i) * neuron_size,
+            spatial_transformed_images + static_cast<size_t>(best_rotation_matrix[i]) * neuron_size,
+            factors[n], neuron_size);
+    }
+}
+
+} // namespace pink
@@ -0,0 +1,205 @@
+/**
+ * @file   SelfOrganizingMapLib/upsample.h
+ * @brief  Interpolation of a SOM to a larger SOM layout
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "CartesianLayout.h"
+#include "HexagonalLayout.h"
+
+namespace pink {
+
+/// Returns the neurons of a SOM layout and their weights to interpolate a neuron of another
+/// SOM layout of the same type, where both layouts cover the same area.
+/// Primary template will never be instantiated.
+template <typename SOMLayout>
+class LayoutInterpolation;
+
+/// Multilinear interpolation of the corners of the grid cell
+template <uint8_t dim>
+class LayoutInterpolation<CartesianLayout<dim>>
+{
+public:
+
+    typedef CartesianLayout<dim> LayoutType;
+    typedef typename LayoutType::DimensionType DimensionType;
+
+    LayoutInterpolation(LayoutType const& from_layout, LayoutType const& to_layout)
+     : m_from_layout(from_layout),
+       m_to_layout(to_layout),
+       m_from_extent(get_extent(from_layout)),
+       m_to_extent(get_extent(to_layout))
+    {
+        // Neuron index of each grid position, the positions are given by the layout
+        for (uint8_t d = 0; d < dim; ++d) m_stride[d] = d == 0 ? 1 : m_stride[d - 1] * m_from_extent[d - 1];
+        m_grid.resize(from_layout.size());
+        for (uint32_t i = 0; i < from_layout.size(); ++i) m_grid[get_grid_index(from_layout.get_position(i))] = i;
+    }
+
+    void operator () (uint32_t to_index, std::vector<uint32_t>& indices, std::vector<float>& weights) const
+    {
+        indices.clear();
+        weights.clear();
+
+        auto&& position = m_to_layout.get_position(to_index);
+        DimensionType lower;
+        std::array<float, dim> fraction;
+        for (uint8_t d = 0; d < dim; ++d) {
+            float x = m_to_extent[d] == 1 ? 0.0f :
+                static_cast<float>(position[d]) * (m_from_extent[d] - 1) / (m_to_extent[d] - 1);
+            lower[d] = std::min(static_cast<uint32_t>(x), m_from_extent[d] - 1);
+            fraction[d] = x - lower[d];
+        }
+
+        for (uint32_t corner = 0; corner < (1U << dim); ++corner) {
+            DimensionType p = lower;
+            float weight = 1.0f;
+            for (uint8_t d = 0; d < dim; ++d) {
+                if (corner & (1U << d)) {
+                    ++p[d];
+                    weight *= fraction[d];
+                } else {
+                    weight *= 1.0f - fraction[d];
+                }
+            }
+            if (weight == 0.0f) continue;
+            indices.push_back(m_grid[get_grid_index(p)]);
+            weights.push_back(weight);
+        }
+    }
+
+private:
+
+    static DimensionType get_extent(LayoutType const& layout)
+    {
+        DimensionType extent;
+        extent.fill(1);
+        for (uint32_t i = 0; i < layout.size(); ++i) {
+            auto&& p = layout.get_position(i);
+            for (uint8_t d = 0; d < dim; ++d) extent[d] = std::max(extent[d], p[d] + 1);
+        }
+        return extent;
+    }
+
+    uint32_t get_grid_index(DimensionType const& p) const
+    {
+        uint32_t index = 0;
+        for (uint8_t d = 0; d < dim; ++d) index += p[d] * m_stride[d];
+        return index;
+    }
+
+    LayoutType m_from_layout;
+    LayoutType m_to_layout;
+
+    DimensionType m_from_extent;
+    DimensionType m_to_extent;
+
+    DimensionType m_stride;
+
+    /// Neuron index of each grid position of the from-layout
+    std::vector<uint32_t> m_grid;
+};
+
+/// The neuron centers of a hexagonal layout are the vertices of a triangular lattice.
+/// The position is scaled in axial coordinates relative to the center neuron and
+/// interpolated by the barycentric weights of the surrounding triangle.
+template <>
+class LayoutInterpolation<HexagonalLayout>
+{
+public:
+
+    LayoutInterpolation(HexagonalLayout const& from_layout, HexagonalLayout const& to_layout)
+     : m_from_layout(from_layout),
+       m_to_layout(to_layout)
+    {}
+
+    void operator () (uint32_t to_index, std::vector<uint32_t>& indices, std::vector<float>& weights) const
+    {
+        indices.clear();
+        weights.clear();
+
+        auto&& position = m_to_layout.get_position(to_index);
+        float scale = m_to_layout.m_radius == 0 ? 0.0f :
+            static_cast<float>(m_from_layout.m_radius) / m_to_layout.m_radius;
+        float q = (static_cast<float>(position[0]) - m_to_layout.m_radius) * scale;
+        float r = (static_cast<float>(position[1]) - m_to_layout.m_radius) * scale;
+
+        auto q0 = static_cast<int32_t>(std::floor(q));
+        auto r0 = static_cast<int32_t>(std::floor(r));
+        float fq = q - q0;
+        float fr = r - r0;
+
+        // The cell [q0, q0 + 1] x [r0, r0 + 1] is split along the diagonal of the neighbors (q0 + 1, r0) and (q0, r0 + 1)
+        if (fq + fr <= 1.0f) {
+            add(q0, r0, 1.0f - fq - fr, indices, weights);
+            add(q0 + 1, r0, fq, indices, weights);
+            add(q0, r0 + 1, fr, indices, weights);
+        } else {
+            add(q0 + 1, r0 + 1, fq + fr - 1.0f, indices, weights);
+            add(q0 + 1, r0, 1.0f - fr, indices, weights);
+            add(q0, r0 + 1, 1.0f - fq, indices, weights);
+        }
+
+        // Vertices outside of the layout can only have a vanishing weight by rounding
+        float sum_of_weights = 0.0f;
+        for (auto w : weights) sum_of_weights += w;
+        for (auto&& w : weights) w /= sum_of_weights;
+    }
+
+private:
+
+    /// Add the neuron at the axial position relative to the center, if inside of the layout
+    void add(int32_t q, int32_t r, float weight, std::vector<uint32_t>& indices, std::vector<float>& weights) const
+    {
+        auto radius = static_cast<int32_t>(m_from_layout.m_radius);
+        if (weight <= 0.0f or std::abs(q) > radius or std::abs(r) > radius or std::abs(q + r) > radius) return;
+        indices.push_back(m_from_layout.get_index({static_cast<uint32_t>(q + radius), static_cast<uint32_t>(r + radius)}));
+        weights.push_back(weight);
+    }
+
+    HexagonalLayout m_from_layout;
+    HexagonalLayout m_to_layout;
+};
+
+/// Interpolate the neurons [begin, end) of the SOM layout to_layout from a SOM with from_layout.
+/// Both SOMs cover the same area of the layout space, so that the corner neurons are kept.
+/// Typically from_layout is smaller, e.g. to continue the training of a coarse SOM at a higher resolution.
+template <typename SOMLayout, typename T>
+void upsample(SOMLayout const& from_layout, T const *from_som, SOMLayout const& to_layout, T *to_som,
+    uint32_t neuron_size, uint32_t begin, uint32_t end)
+{
+    LayoutInterpolation<SOMLayout> interpolation(from_layout, to_layout);
+    std::vector<uint32_t> indices;
+    std::vector<float> weights;
+
+    for (uint32_t i = begin; i < end; ++i)
+    {
+        interpolation(i, indices, weights);
+
+        T *neuron = to_som + static_cast<size_t>(i - begin) * neuron_size;
+        std::fill(neuron, neuron + neuron_size, 0);
+        for (size_t n = 0; n < indices.size(); ++n) {
+            T const *from_neuron = from_som + static_cast<size_t>(indices[n]) * neuron_size;
+            for (uint32_t j = 0; j < neuron_size; ++j) neuron[j] += from_neuron[j] * weights[n];
+        }
+    }
+}
+
+/// Interpolate all neurons of the SOM layout to_layout
+template <typename SOMLayout, typename T>
+void upsample(SOMLayout const& from_layout, T const *from_som, SOMLayout const& to_layout, T *to_som,
+    uint32_t neuron_size)
+{
+    upsample(from_layout, from_som, to_layout, to_som, neuron_size, 0, static_cast<uint32_t>(to_layout.size()));
+}
+
+} // namespace pink
@@ -0,0 +1,58 @@
+/**
+ * @file   UtilitiesLib/DecayType.h
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+namespace pink {
+
+/// Schedule of the training parameters across the iterations
+enum class DecayType
+{
+    OFF,
+    LINEAR,
+    EXPONENTIAL
+};
+
+/// Pretty printing of DecayType.
+inline std::ostream& operator << (std::ostream& os, DecayType type)
+{
+    if (type == DecayType::OFF) os << "off";
+    else if (type == DecayType::LINEAR) os << "linear";
+    else if (type == DecayType::EXPONENTIAL) os << "exponential";
+    else os << "undefined";
+    return os;
+}
+
+/// Returns the value at iteration (0 <= iteration < number_of_iterations), which decays
+/// from initial_value at the first to final_value at the last iteration.
+/// An exponential decay needs initial and final values of the same sign, otherwise linear is used.
+inline float get_decayed_value(DecayType type, float initial_value, float final_value,
+    uint32_t iteration, uint32_t number_of_iterations)
+{
+    if (type == DecayType::OFF or number_of_iterations < 2) return initial_value;
+    float t = static_cast<float>(iteration) / (number_of_iterations - 1);
+
+    if (type == DecayType::EXPONENTIAL and initial_value * final_value > 0.0f)
+        return initial_value * std::pow(final_value / initial_value, t);
+    return initial_value + (final_value - initial_value) * t;
+}
+
+/// Returns the maximal update distance at iteration, a non-positive value is no limit.
+/// Without a positive final value the initial one is kept. Otherwise, the distance decays from the
+/// initial one, or from beyond max_distance (the largest distance within the SOM) if there is no initial limit.
+inline float get_decayed_max_update_distance(DecayType type, float initial_value, float final_value,
+    float max_distance, uint32_t iteration, uint32_t number_of_iterations)
+{
+    if (final_value <= 0.0f) return initial_value;
+    if (initial_value <= 0.0f) initial_value = max_distance + 1.0f;
+    return get_decayed_value(type, initial_value, final_value, iteration, number_of_iterations);
+}
+
+} // namespace pink
@@ -0,0 +1,48 @@
+/**
+ * @file   UtilitiesLib/DefaultInitAllocator.h
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#pragma once
+
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace pink {
+
+/// Allocator whose value-less construction is a default-initialization, so that
+/// std::vector<T, DefaultInitAllocator<T>>(n) does not write zeros into its elements.
+/// The pages of the memory are first touched by the fill which follows, which may be
+/// a parallel one placing each page next to the thread that uses it later.
+template <typename T, typename A = std::allocator<T>>
+class DefaultInitAllocator : public A
+{
+    typedef std::allocator_traits<A> Traits;
+
+public:
+
+    template <typename U>
+    struct rebind
+    {
+        using other = DefaultInitAllocator<U, typename Traits::template rebind_alloc<U>>;
+    };
+
+    using A::A;
+
+    template <typename U>
+    void construct(U *ptr) noexcept(std::is_nothrow_default_constructible<U>::value)
+    {
+        ::new(static_cast<void*>(ptr)) U;
+    }
+
+    template <typename U, typename... Args>
+    void construct(U *ptr, Args&&... args)
+    {
+        Traits::construct(static_cast<A&>(*this), ptr, std::forward<Args>(args)...);
+    }
+};
+
+} // namespace pink
@@ -7,6 +7,8 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <random>
 #include <type_traits>
 
@@ -45,4 +47,60 @@ void fill_value(T *a, std::size_t length, T value = 0)
     }
 }
 
+/// Output number i of the SplitMix64 generator started with seed.
+/// As it depends only on seed and i, the numbers can be generated in any order.
+inline std::uint64_t splitmix64(std::uint64_t seed, std::uint64_t i)
+{
+    std::uint64_t z = seed + (i + 1) * 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+/// Fill array with random numbers in [0, 1) by the counter-based generator splitmix64.
+/// Element i gets the number offset + i, so that the result does not depend on the number of threads
+/// and a part of a larger array can be filled on its own. The threads fill contiguous ranges (static
+/// schedule), which first touches the memory like the neuron loops of the trainer.
+template <class T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
+void fill_random_uniform_parallel(T *a, std::size_t length, std::uint32_t seed = std::mt19937::default_seed,
+    std::size_t offset = 0)
+{
+    // Number of random bits which are exactly representable
+    constexpr int digits = std::numeric_limits<T>::digits < 64 ? std::numeric_limits<T>::digits : 53;
+    constexpr T scale = T(1) / static_cast<T>(std::uint64_t(1) << digits);
+
+    auto n = static_cast<std::int64_t>(length);
+    #pragma omp parallel for schedule(static)
+    for (std::int64_t i = 0; i < n; ++i) {
+        a[i] = static_cast<T>(splitmix64(seed, offset + static_cast<std::uint64_t>(i)) >> (64 - digits)) * scale;
+    }
+}
+
+/// Fill array with random numbers in [0, max] of T by the counter-based generator splitmix64,
+/// see the floating point version above
+template <class T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+void fill_random_uniform_parallel(T *a, std::size_t length, std::uint32_t seed = std::mt19937::default_seed,
+    std::size_t offset = 0)
+{
+    // Number of value bits of T without the sign
+    constexpr int digits = std::numeric_limits<T>::digits;
+
+    auto n = static_cast<std::int64_t>(length);
+    #pragma omp parallel for schedule(static)
+    for (std::int64_t i = 0; i < n; ++i) {
+        a[i] = static_cast<T>(splitmix64(seed, offset + static_cast<std::uint64_t>(i)) >> (64 - digits));
+    }
+}
+
+/// Fill array with a single value, the threads fill contiguous ranges (static schedule)
+template <class T>
+void fill_value_parallel(T *a, std::size_t length, T value = 0)
+{
+    auto n = static_cast<std::int64_t>(length);
+    #pragma omp parallel for schedule(static)
+    for (std::int64_t i = 0; i < n; ++i) {
+        a[i] = value;
+    }
+}
+
 } // namespace pink
@@ -78,7 +78,26 @@ InputData::InputData()
    m_write_rot_flip(false),
    m_euclidean_distance_type(DataType::UINT8),
    m_shuffle_data_input(true),
-   m_euclidean_distance_shape(EuclideanDistanceShape::QUADRATIC)
+   m_euclidean_distance_shape(EuclideanDistanceShape::QUADRATIC),
+   m_transformation_layout(TransformationLayout::NEURON_MAJOR),
+   m_batch_size(1),
+   m_asynchronous(false),
+   m_decay_type(DecayType::OFF),
+   m_final_sigma(1.1f),
+   m_final_damping(0.2f),
+   m_final_max_update_distance(-1.0),
+   m_resume(false),
+   m_sync_interval(10),
+   m_model_parallel(false),
+   m_early_stopping_churn(-1.0),
+   m_early_stopping_quantization_error_change(-1.0),
+   m_best_match_cache_radius(0.0),
+   m_best_match_cache_max_distance_increase(0.0),
+   m_best_rotation_cache_window(0),
+   m_two_phase_search(false),
+   m_pipelined(false),
+   m_transform_cache_size(0),
+   m_deterministic(false)
 {}
 
 InputData::InputData(int argc, char **argv)
@@ -114,6 +133,25 @@ InputData::InputData(int argc, char **argv)
         {"euclidean-distance-type",      1, nullptr, 16},
         {"input-shuffle-off",            0, nullptr, 17},
         {"euclidean-distance-shape" ,    1, nullptr, 18},
+        {"transformation-layout",        1, nullptr, 19},
+        {"batch-size",                   1, nullptr, 20},
+        {"asynchronous",                 0, nullptr, 21},
+        {"decay",                        1, nullptr, 22},
+        {"checkpoint",                   1, nullptr, 23},
+        {"resume",                       0, nullptr, 24},
+        {"sync-interval",                1, nullptr, 25},
+        {"model-parallel",               0, nullptr, 26},
+        {"early-stopping",               1, nullptr, 27},
+        {"statistics",                   1, nullptr, 28},
+        {"stages",                       1, nullptr, 29},
+        {"best-match-cache",             1, nullptr, 30},
+        {"best-rotation-cache",          1, nullptr, 31},
+        {"two-phase-search",             0, nullptr, 32},
+        {"pipelined",                    0, nullptr, 33},
+        {"sweep",                        1, nullptr, 34},
+        {"transform-cache",              1, nullptr, 35},
+        {"map-last-iteration",           1, nullptr, 36},
+        {"deterministic",                0, nullptr, 37},
         {nullptr,                        0, nullptr, 0}
     };
 
@@ -205,6 +243,9 @@ InputData::InputData(int argc, char **argv)
                 else if (str == "RANDOM_WITH_PREFERRED_DIRECTION") {
                     m_init = SOMInitialization::RANDOM_WITH_PREFERRED_DIRECTION;
                 }
+                else if (str == "PCA") {
+                    m_init = SOMInitialization::PCA;
+                }
                 else {
                     m_init = SOMInitialization::FILEINIT;
                     m_som_filename = optarg;
@@ -352,6 +393,150 @@ InputData::InputData(int argc, char **argv)
                 }
                 break;
             }
+            case 19:
+            {
+                auto str = str_to_upper(optarg);
+                if (str == "NEURON_MAJOR") {
+                    m_transformation_layout = TransformationLayout::NEURON_MAJOR;
+                }
+                else if (str == "PIXEL_MAJOR") {
+                    m_transformation_layout = TransformationLayout::PIXEL_MAJOR;
+                }
+                else {
+                    throw pink::exception("Unknown transformation layout " + str);
+                }
+                break;
+            }
+            case 20:
+            {
+                m_batch_size = str_to_uint32_t(optarg);
+                if (m_batch_size < 1) throw pink::exception("batch-size must be > 0.");
+                break;
+            }
+            case 21:
+            {
+                m_asynchronous = true;
+                break;
+            }
+            case 22:
+            {
+                auto str = str_to_upper(optarg);
+                if (str == "OFF") {
+                    m_decay_type = DecayType::OFF;
+                }
+                else if (str == "LINEAR") {
+                    m_decay_type = DecayType::LINEAR;
+                }
+                else if (str == "EXPONENTIAL") {
+                    m_decay_type = DecayType::EXPONENTIAL;
+                }
+                else {
+                    throw pink::exception("Unknown decay type " + str);
+                }
+                if (m_decay_type == DecayType::OFF) break;
+                int index = optind;
+                if (index >= argc or argv[index][0] == '-') {
+                    throw pink::exception("Missing arguments for --decay option.");
+                }
+                m_final_sigma = std::strtof(argv[index++], &end_char);
+                if (index >= argc or argv[index][0] == '-') {
+                    throw pink::exception("Missing arguments for --decay option.");
+                }
+                m_final_damping = std::strtof(argv[index++], &end_char);
+                if (index >= argc or (argv[index][0] == '-' and argv[index][1] == '-')) {
+                    throw pink::exception("Missing arguments for --decay option.");
+                }
+                m_final_max_update_distance = std::strtof(argv[index++], &end_char);
+                optind = index;
+                break;
+            }
+            case 23:
+            {
+                m_checkpoint_filename = optarg;
+                break;
+            }
+            case 24:
+            {
+                m_resume = true;
+                break;
+            }
+            case 25:
+            {
+                m_sync_interval = str_to_uint32_t(optarg);
+                if (m_sync_interval < 1) throw pink::exception("sync-interval must be > 0.");
+                break;
+            }
+            case 26:
+            {
+                m_model_parallel = true;
+                break;
+            }
+            case 27:
+            {
+                m_early_stopping_churn = std::strtof(optarg, &end_char);
+                if (optind >= argc or (argv[optind][0] == '-' and argv[optind][1] == '-')) {
+                    throw pink::exception("Missing arguments for --early-stopping option.");
+                }
+                m_early_stopping_quantization_error_change = std::strtof(argv[optind++], &end_char);
+                break;
+            }
+            case 28:
+            {
+                m_statistics_filename = optarg;
+                break;
+            }
+            case 29:
+            {
+                m_stages = parse_training_stages(optarg);
+                break;
+            }
+            case 30:
+            {
+                m_best_match_cache_radius = std::strtof(optarg, &end_char);
+                if (m_best_match_cache_radius < 1.0f) throw pink::exception("Window radius of best-match-cache must be >= 1.");
+                if (optind >= argc or (argv[optind][0] == '-' and argv[optind][1] == '-')) {
+                    throw pink::exception("Missing arguments for --best-match-cache option.");
+                }
+                m_best_match_cache_max_distance_increase = std::strtof(argv[optind++], &end_char);
+                break;
+            }
+            case 31:
+            {
+                m_best_rotation_cache_window = str_to_uint32_t(optarg);
+                if (m_best_rotation_cache_window < 1) throw pink::exception("best-rotation-cache must be > 0.");
+                break;
+            }
+            case 32:
+            {
+                m_two_phase_search = true;
+                break;
+            }
+            case 33:
+            {
+                m_pipelined = true;
+                break;
+            }
+            case 34:
+            {
+                m_sweep = parse_sweep_variants(optarg);
+                break;
+            }
+            case 35:
+            {
+                m_transform_cache_size = str_to_uint32_t(optarg);
+                if (m_transform_cache_size < 1) throw pink::exception("transform-cache must be > 0.");
+                break;
+            }
+            case 36:
+            {
+                m_last_iteration_mapping_filename = optarg;
+                break;
+            }
+            case 37:
+            {
+                m_deterministic = true;
+                break;
+            }
             case 'v':
             {
                 std::cout << "Pink version " << PROJECT_VERSION << std::endl;
@@ -423,6 +608,156 @@ InputData::InputData(int argc, char **argv)
     }
     else m_som_size = m_som_width * m_som_height * m_som_depth;
 
+    if (m_batch_size > 1 and m_use_gpu) {
+        throw pink::exception("Mini-batch training is only supported on the CPU, please use --cuda-off.");
+    }
+    if (m_asynchronous and m_use_gpu) {
+        throw pink::exception("Asynchronous training is only supported on the CPU, please use --cuda-off.");
+    }
+    if (m_asynchronous and m_batch_size > 1) {
+        throw pink::exception("Asynchronous training can not be combined with mini-batches.");
+    }
+    if (m_pipelined and m_use_gpu) {
+        throw pink::exception("Pipelined training is only supported on the CPU, please use --cuda-off.");
+    }
+    if (m_pipelined and (m_asynchronous or m_batch_size > 1)) {
+        throw pink::exception("Pipelined training can not be combined with asynchronous training or mini-batches.");
+    }
+    if (m_pipelined and m_max_update_distance <= 0.0f) {
+        throw pink::exception("Pipelined training needs --max-update-distance, as the update of the whole SOM "
+            "leaves no neurons to search in parallel.");
+    }
+
+    if (m_resume and m_checkpoint_filename.empty()) {
+        throw pink::exception("Resuming the training needs a checkpoint file, please use --checkpoint.");
+    }
+    if (m_resume and (m_best_match_cache_radius > 0.0f or m_best_rotation_cache_window > 0)) {
+        throw pink::exception("Resuming can not be combined with best match cache or best rotation cache, "
+            "their entries are not stored in the checkpoint.");
+    }
+    if (m_resume and (!m_statistics_filename.empty() or m_early_stopping_churn >= 0.0f or
+        m_early_stopping_quantization_error_change >= 0.0f)) {
+        throw pink::exception("Resuming can not be combined with statistics or early stopping, "
+            "the best matches of the previous iteration are not stored in the checkpoint.");
+    }
+
+    if (m_model_parallel and m_use_gpu) {
+        throw pink::exception("Model-parallel training is only supported on the CPU, please use --cuda-off.");
+    }
+    if (m_model_parallel and (m_asynchronous or m_pipelined or m_batch_size > 1)) {
+        throw pink::exception("Model-parallel training can not be combined with asynchronous or pipelined training or mini-batches.");
+    }
+    if (m_model_parallel and !m_checkpoint_filename.empty()) {
+        throw pink::exception("Model-parallel training does not support checkpoints.");
+    }
+
+    if (m_best_match_cache_radius > 0.0f and m_use_gpu) {
+        throw pink::exception("Best match cache is only supported on the CPU, please use --cuda-off.");
+    }
+    if (m_best_match_cache_radius > 0.0f and m_model_parallel) {
+        throw pink::exception("Best match cache can not be combined with model-parallel training.");
+    }
+    if (m_best_rotation_cache_window > 0 and m_use_gpu) {
+        throw pink::exception("Best rotation cache is only supported on the CPU, please use --cuda-off.");
+    }
+    if (m_best_rotation_cache_window > 0 and m_model_parallel) {
+        throw pink::exception("Best rotation cache can not be combined with model-parallel training.");
+    }
+    if (m_two_phase_search and m_use_gpu) {
+        throw pink::exception("Two-phase search is only supported on the CPU, please use --cuda-off.");
+    }
+    if (m_two_phase_search and m_model_parallel) {
+        throw pink::exception("Two-phase search can not be combined with model-parallel training.");
+    }
+    if (m_transform_cache_size > 0 and m_use_gpu) {
+        throw pink::exception("Transform cache is only supported on the CPU, please use --cuda-off.");
+    }
+    if (m_transform_cache_size > 0 and m_model_parallel) {
+        throw pink::exception("Transform cache can not be combined with model-parallel training.");
+    }
+    if (m_pipelined and (m_best_match_cache_radius > 0.0f or m_best_rotation_cache_window > 0 or m_two_phase_search or
+        m_transform_cache_size > 0)) {
+        throw pink::exception("Pipelined training can not be combined with best match cache, best rotation cache, "
+            "two-phase search or transform cache.");
+    }
+
+    if (m_deterministic and m_use_gpu) {
+        throw pink::exception("Deterministic mode is only supported on the CPU, please use --cuda-off.");
+    }
+    if (m_deterministic and m_asynchronous) {
+        throw pink::exception("Deterministic mode can not be combined with asynchronous training.");
+    }
+
+    if (!m_last_iteration_mapping_filename.empty()) {
+        if (m_executionPath != ExecutionPath::TRAIN) {
+            throw pink::exception("Mapping of the last iteration is only supported for training.");
+        }
+        if (m_use_gpu) {
+            throw pink::exception("Mapping of the last iteration is only supported on the CPU, please use --cuda-off.");
+        }
+        if (m_model_parallel or m_asynchronous or m_pipelined or !m_sweep.empty()) {
+            throw pink::exception("Mapping of the last iteration can not be combined with model-parallel, "
+                "asynchronous, pipelined or sweep training.");
+        }
+        if (m_best_match_cache_radius > 0.0f or m_best_rotation_cache_window > 0 or m_two_phase_search) {
+            throw pink::exception("Mapping of the last iteration needs the distances of all neurons and can not be "
+                "combined with best match cache, best rotation cache or two-phase search.");
+        }
+        if (m_resume or m_early_stopping_churn >= 0.0f or m_early_stopping_quantization_error_change >= 0.0f) {
+            throw pink::exception("Mapping of the last iteration can not be combined with resuming or early stopping.");
+        }
+    }
+
+    if (!m_stages.empty() and m_executionPath != ExecutionPath::TRAIN) {
+        throw pink::exception("Training stages are only supported for training.");
+    }
+    if (!m_stages.empty() and !m_checkpoint_filename.empty()) {
+        throw pink::exception("Training stages can not be combined with checkpoints.");
+    }
+    for (auto&& stage : m_stages) {
+        std::stringstream ss;
+        ss << stage;
+        if (stage.m_som_width < 2) throw pink::exception("som-width of training stage " + ss.str() + " must be > 1.");
+        if ((stage.m_som_height > 1) != (m_som_height > 1) or (stage.m_som_depth > 1) != (m_som_depth > 1)) {
+            throw pink::exception("Training stage " + ss.str() + " must have the same dimensionality as the SOM.");
+        }
+        if (m_layout == Layout::HEXAGONAL and (stage.m_som_width % 2 == 0 or stage.m_som_width != stage.m_som_height)) {
+            throw pink::exception("Training stage " + ss.str() + " must have equal and odd dimensions for hexagonal layout.");
+        }
+    }
+
+    if (!m_sweep.empty()) {
+        if (m_executionPath != ExecutionPath::TRAIN) throw pink::exception("Sweep is only supported for training.");
+        if (m_use_gpu) throw pink::exception("Sweep is only supported on the CPU, please use --cuda-off.");
+        if (m_model_parallel or m_asynchronous or m_pipelined or m_batch_size > 1 or !m_stages.empty()) {
+            throw pink::exception("Sweep can not be combined with model-parallel, asynchronous or pipelined training, "
+                "mini-batches or training stages.");
+        }
+        if (!m_checkpoint_filename.empty() or m_intermediate_storage != IntermediateStorageType::OFF or
+            !m_statistics_filename.empty() or m_early_stopping_churn >= 0.0f or
+            m_early_stopping_quantization_error_change >= 0.0f) {
+            throw pink::exception("Sweep can not be combined with checkpoints, intermediate SOMs, "
+                "statistics file or early stopping.");
+        }
+        if (m_best_rotation_cache_window > 0 or m_transform_cache_size > 0) {
+            throw pink::exception("Sweep can not be combined with best rotation cache or transform cache.");
+        }
+    }
+    for (auto&& variant : m_sweep) {
+        std::stringstream ss;
+        ss << variant;
+        auto width = variant.m_som_width.value_or(m_som_width);
+        auto height = variant.m_som_height.value_or(m_som_height);
+        auto depth = variant.m_som_depth.value_or(m_som_depth);
+        if (width < 2) throw pink::exception("som-width of sweep SOM " + ss.str() + " must be > 1.");
+        if ((height > 1) != (m_som_height > 1) or (depth > 1) != (m_som_depth > 1)) {
+            throw pink::exception("Sweep SOM " + ss.str() + " must have the same dimensionality as the SOM.");
+        }
+        if (m_layout == Layout::HEXAGONAL and (width % 2 == 0 or width != height)) {
+            throw pink::exception("Sweep SOM " + ss.str() + " must have equal and odd dimensions for hexagonal layout.");
+        }
+    }
+
     if (m_som_width < 2) throw pink::exception("som-width must be > 1.");
     if (m_som_height < 1) throw pink::exception("som-height must be > 0.");
     if (m_som_depth < 1) throw pink::exception("som-depth must be > 0.");
@@ -545,6 +880,7 @@ void InputData::print_parameters() const
               << "  Euclidean distance dimension = " << m_euclidean_distance_dim << "\n"
               << "  Data type for euclidean distance calculation = " << m_euclidean_distance_type << "\n"
               << "  Shape of euclidean distance region = " << m_euclidean_distance_shape << "\n"
+              << "  Layout of spatial transformations (CPU) = " << m_transformation_layout << "\n"
               << "  Maximal number of progress information prints = " << m_max_number_of_progress_prints << "\n"
               << "  Intermediate storage of SOM = " << m_intermediate_storage << "\n"
               << "  Layout = " << m_layout << "\n"
@@ -558,7 +894,8 @@ void InputData::print_parameters() const
               << "  Number of rotations = " << m_number_of_rotations << "\n"
               << "  Use mirrored image = " << m_use_flip << "\n"
               << "  Number of CPU threads = " << m_number_of_threads << "\n"
-              << "  Use CUDA = " << m_use_gpu << "\n";
+              << "  Use CUDA = " << m_use_gpu << "\n"
+              << "  Deterministic = " << m_deterministic << "\n";
 
     if (m_executionPath == ExecutionPath::TRAIN) {
         std::cout << "  Distribution function for SOM update = " << m_distribution_function << "\n"
@@ -566,7 +903,57 @@ void InputData::print_parameters() const
                   << "  Damping factor = " << m_damping << "\n"
                   << "  Maximum distance for SOM update = " << m_max_update_distance << "\n"
                   << "  Use periodic boundary conditions = " << m_use_pbc << "\n"
-                  << "  Random shuffle data input = " << m_shuffle_data_input << "\n";
+                  << "  Random shuffle data input = " << m_shuffle_data_input << "\n"
+                  << "  Batch size = " << m_batch_size << "\n"
+                  << "  Asynchronous training = " << m_asynchronous << "\n"
+                  << "  Pipelined training = " << m_pipelined << "\n"
+                  << "  Decay of sigma, damping factor and maximum update distance = " << m_decay_type << "\n";
+        if (m_decay_type != DecayType::OFF) {
+            std::cout << "  Final sigma = " << m_final_sigma << "\n"
+                      << "  Final damping factor = " << m_final_damping << "\n"
+                      << "  Final maximum distance for SOM update = " << m_final_max_update_distance << "\n";
+        }
+        if (m_early_stopping_churn >= 0.0f or m_early_stopping_quantization_error_change >= 0.0f) {
+            std::cout << "  Early stopping at best match churn = " << m_early_stopping_churn << "\n"
+                      << "  Early stopping at relative change of quantization error = "
+                      << m_early_stopping_quantization_error_change << "\n";
+        }
+        if (!m_statistics_filename.empty()) {
+            std::cout << "  Convergence statistics filename = " << m_statistics_filename << "\n";
+        }
+        if (m_best_match_cache_radius > 0.0f) {
+            std::cout << "  Window radius of best match cache = " << m_best_match_cache_radius << "\n"
+                      << "  Maximal relative distance increase of best match cache = "
+                      << m_best_match_cache_max_distance_increase << "\n";
+        }
+        if (m_best_rotation_cache_window > 0) {
+            std::cout << "  Window size of best rotation cache = " << m_best_rotation_cache_window << "\n";
+        }
+        if (m_two_phase_search) {
+            std::cout << "  Two-phase search = " << m_two_phase_search << "\n";
+        }
+        if (m_transform_cache_size > 0) {
+            std::cout << "  Transform cache size = " << m_transform_cache_size << " MB\n";
+        }
+        if (!m_last_iteration_mapping_filename.empty()) {
+            std::cout << "  Mapping of the last iteration filename = " << m_last_iteration_mapping_filename << "\n";
+        }
+        if (!m_stages.empty()) {
+            std::cout << "  Training stages (width x height x depth : iterations) =";
+            for (auto&& stage : m_stages) std::cout << " " << stage;
+            std::cout << "\n";
+        }
+        for (size_t i = 0; i < m_sweep.size(); ++i) {
+            std::cout << "  Sweep SOM " << i << " = " << m_sweep[i] << "\n";
+        }
+        if (!m_checkpoint_filename.empty()) {
+            std::cout << "  Checkpoint filename = " << m_checkpoint_filename << "\n"
+                      << "  Resume from checkpoint = " << m_resume << "\n";
+        }
+#ifdef PINK_USE_MPI
+        std::cout << "  Synchronization interval of MPI processes = " << m_sync_interval << "\n"
+                  << "  Model-parallel training = " << m_model_parallel << "\n";
+#endif
     } else if (m_executionPath == ExecutionPath::MAP) {
         std::cout << "  Store best rotation and flipping parameters = " << m_write_rot_flip << "\n";
 
@@ -591,10 +978,26 @@ void InputData::print_usage() const
                  "\n"
                  "  Options:\n"
                  "\n"
+                 "    --asynchronous                                "
+                 "Lock-free multi-threaded training (Hogwild), not reproducible, only CPU.\n"
+                 "    --batch-size <int>                            "
+                 "Number of images per SOM update, only CPU (default = 1).\n"
+                 "    --best-match-cache <float> <float>            "
+                 "Search the best match first around the one of the previous iteration, only CPU (see below).\n"
+                 "    --best-rotation-cache <int>                   "
+                 "Bound the search by the previous best match within the given angle steps, only CPU.\n"
+                 "    --checkpoint <string>                         "
+                 "Write the training state to file at each progress print and iteration end.\n"
                  "    --cuda-off                                    "
                  "Switch off CUDA acceleration.\n"
+                 "    --decay <string> <float> <float> <float>      "
+                 "Decay of sigma, damping factor and maximum update distance (see below).\n"
+                 "    --deterministic                               "
+                 "Results independent of the number of threads, rejects options which are not (see below).\n"
                  "    --dist-func, -f <string>                      "
                  "Distribution function for SOM update (see below).\n"
+                 "    --early-stopping <float> <float>              "
+                 "Stop if best match churn and relative change of quantization error are below (see below).\n"
                  "    --euclidean-distance-dimension, -e <int>      "
                  "Dimension for euclidean distance calculation (default = image-dimension * sqrt(2) / 2).\n"
                  "    --euclidean-distance-type                     "
@@ -606,7 +1009,7 @@ void InputData::print_usage() const
                  "    --help, -h                                    "
                  "Print this lines.\n"
                  "    --init, -x <string>                           "
-                 "Type of SOM initialization (zero = default, random, random_with_preferred_direction, file_init).\n"
+                 "Type of SOM initialization (zero = default, random, random_with_preferred_direction, pca, file_init).\n"
                  "    --input-shuffle-off                           "
                  "Switch off random shuffle of data input (only for training).\n"
                  "    --interpolation <string>                      "
@@ -615,8 +1018,12 @@ void InputData::print_usage() const
                  "Store intermediate SOM results at every progress step (off = default, overwrite, keep).\n"
                  "    --layout, -l <string>                         "
                  "Layout of SOM (cartesian = default, hexagonal).\n"
+                 "    --map-last-iteration <string>                 "
+                 "Write the mapping of the last training iteration to file, also --store-rot-flip (see below).\n"
                  "    --max-update-distance <float>                 "
                  "Maximum distance for SOM update (default = off).\n"
+                 "    --model-parallel                              "
+                 "Distribute the neurons instead of the images across the MPI processes (only CPU training).\n"
                  "    --neuron-dimension, -d <int>                  "
                  "Dimension for quadratic SOM neurons (default = 2 * image-dimension / sqrt(2)).\n"
                  "    --numrot, -n <int>                            "
@@ -627,10 +1034,18 @@ void InputData::print_usage() const
                  "Number of iterations (default = 1).\n"
                  "    --pbc                                         "
                  "Use periodic boundary conditions for SOM.\n"
+                 "    --pipelined                                   "
+                 "Overlap the best match search of the next image with the current update, only CPU.\n"
                  "    --progress, -p <int>                          "
                  "Maximal number of progress information prints (default = 10).\n"
+                 "    --resume                                      "
+                 "Continue the training from the checkpoint file, not with caches, statistics or early stopping.\n"
                  "    --seed, -s <unsigned int>                     "
                  "Seed for random number generator (default = 1234).\n"
+                 "    --stages <string>                             "
+                 "Train coarse SOMs first and upsample them to the next stage (see below).\n"
+                 "    --statistics <string>                         "
+                 "Write the convergence statistics of each iteration to file.\n"
                  "    --store-rot-flip <string>                     "
                  "Store the rotation and flip information of the best match of mapping.\n"
                  "    --som-width <int>                             "
@@ -639,6 +1054,16 @@ void InputData::print_usage() const
                  "Height dimension of SOM (default = 10).\n"
                  "    --som-depth <int>                             "
                  "Depth dimension of SOM (default = 1).\n"
+                 "    --sweep <string>                              "
+                 "Train several SOMs with different parameters by the same rotated images (see below).\n"
+                 "    --sync-interval <int>                         "
+                 "Number of images per MPI process between synchronizing the SOMs (default = 10).\n"
+                 "    --transform-cache <int>                       "
+                 "Keep the rotated images in memory for the next iterations up to the given MB, only CPU.\n"
+                 "    --transformation-layout <string>              "
+                 "Memory layout of rotated images for CPU distance (neuron_major = default, pixel_major).\n"
+                 "    --two-phase-search                            "
+                 "Find the best match first, then the best rotations of its neighbors only, only CPU.\n"
                  "    --verbose                                     "
                  "Print more output.\n"
                  "    --version, -v                                 "
@@ -651,18 +1076,77 @@ void InputData::print_usage() const
                  "    gaussian sigma damping-factor\n"
                  "    unitygaussian sigma damping-factor\n"
                  "    mexicanHat sigma damping-factor\n"
+                 "\n"
+                 "  Decay of the distribution function and the maximum update distance from the first\n"
+                 "  to the last iteration (a final maximum update distance <= 0 means no limit):\n"
+                 "\n"
+                 "    <string> <float> <float> <float>\n"
+                 "\n"
+                 "    off\n"
+                 "    linear final-sigma final-damping-factor final-max-update-distance\n"
+                 "    exponential final-sigma final-damping-factor final-max-update-distance\n"
+                 "\n"
+                 "  Early stopping after an iteration, if the fraction of images with a changed best matching\n"
+                 "  neuron and the relative change of the mean quantization error are not larger than\n"
+                 "  the given values (a negative value switches the criterion off):\n"
+                 "\n"
+                 "    <float> <float>\n"
+                 "\n"
+                 "    max-best-match-churn max-quantization-error-change\n"
+                 "\n"
+                 "  Best match cache: the best match is searched in the window of the given radius around\n"
+                 "  the best match of the previous iteration. The search over all neurons is used, if the\n"
+                 "  best neuron of the window lies at its border or its euclidean distance increased by more\n"
+                 "  than the given fraction. Only the neighbors of the best match within max-update-distance\n"
+                 "  are additionally calculated, therefore a limited max-update-distance is needed to benefit:\n"
+                 "\n"
+                 "    <float> <float>\n"
+                 "\n"
+                 "    window-radius max-distance-increase\n"
+                 "\n"
+                 "  Multi-resolution training with coarse SOMs, which are trained before the SOM given by\n"
+                 "  --som-width, --som-height, --som-depth and --num-iter. Each SOM is interpolated in the\n"
+                 "  SOM layout to initialize the next one. Stage results are written to <result-file>_stage_<n>:\n"
+                 "\n"
+                 "    <width>[x<height>[x<depth>]]:<iterations>[,...]\n"
+                 "\n"
+                 "    e.g. --stages 5x5:2,9x9:2 --som-width 17 --som-height 17 --num-iter 1\n"
+                 "\n"
+                 "  Hyper-parameter sweep: the rotated images of each image are generated once and train all SOMs\n"
+                 "  in parallel. The parameters sigma, damping, seed, som-width, som-height and som-depth can be\n"
+                 "  given for each SOM, all others are taken from the command line. The image order is given by\n"
+                 "  --seed. The SOMs are written to <result-file>_sweep_<n>:\n"
+                 "\n"
+                 "    <key>=<value>[,...][;...]\n"
+                 "\n"
+                 "    e.g. --sweep \"sigma=1.1;sigma=2.0,damping=0.1;som-width=20,som-height=20,seed=3\"\n"
+                 "\n"
+                 "  Mapping of the last iteration: the euclidean distances of all neurons, which are calculated\n"
+                 "  to find the best match in the last training iteration, are written in the format of --map.\n"
+                 "  A data point is mapped to the SOM before its own update and not to the final SOM, which\n"
+                 "  saves the separate mapping pass. Only CPU and the search over all neurons are supported.\n"
+                 "\n"
+                 "  Deterministic mode: the SOM, the mapping and the statistics are bit-identical for any\n"
+                 "  number of CPU threads. All CPU searches resolve equal distances to the lowest neuron and\n"
+                 "  rotation and reduce in a fixed order, also without this flag. The flag rejects the options\n"
+                 "  whose results depend on the thread scheduling, i.e. asynchronous training and CUDA.\n"
               << std::endl;
 }
 
 std::function<float(float)> InputData::get_distribution_function() const
+{
+    return get_distribution_function(m_sigma, m_damping);
+}
+
+std::function<float(float)> InputData::get_distribution_function(float sigma, float damping) const
 {
     std::function<float(float)> result;
     if (m_distribution_function == DistributionFunction::GAUSSIAN)
-        result = GaussianFunctor(m_sigma, m_damping);
+        result = GaussianFunctor(sigma, damping);
     else if (m_distribution_function == DistributionFunction::UNITYGAUSSIAN)
-        result = UnityGaussianFunctor(m_sigma, m_damping);
+        result = UnityGaussianFunctor(sigma, damping);
     else if (m_distribution_function == DistributionFunction::MEXICANHAT)
-        result = MexicanHatFunctor(m_sigma, m_damping);
+        result = MexicanHatFunctor(sigma, damping);
     else
         pink::exception("Unknown distribution function");
     return result;
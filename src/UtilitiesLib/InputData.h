@@ -14,12 +14,16 @@
 #include "IntermediateStorageType.h"
 #include "SOMInitializationType.h"
 #include "UtilitiesLib/DataType.h"
+#include "UtilitiesLib/DecayType.h"
 #include "UtilitiesLib/DistributionFunction.h"
 #include "UtilitiesLib/DistributionFunctor.h"
 #include "UtilitiesLib/EuclideanDistanceShape.h"
 #include "UtilitiesLib/ExecutionPath.h"
 #include "UtilitiesLib/Interpolation.h"
 #include "UtilitiesLib/Layout.h"
+#include "UtilitiesLib/SweepVariant.h"
+#include "UtilitiesLib/TrainingStage.h"
+#include "UtilitiesLib/TransformationLayout.h"
 #include "Version.h"
 
 namespace pink {
@@ -44,6 +48,9 @@ struct InputData
     /// Return the distribution function
     std::function<float(float)> get_distribution_function() const;
 
+    /// Return the distribution function with the given sigma and damping factor
+    std::function<float(float)> get_distribution_function(float sigma, float damping) const;
+
     std::string m_data_filename;
     std::string m_result_filename;
     std::string m_som_filename;
@@ -86,6 +93,30 @@ struct InputData
     DataType m_euclidean_distance_type;
     bool m_shuffle_data_input;
     EuclideanDistanceShape m_euclidean_distance_shape;
+    TransformationLayout m_transformation_layout;
+    uint32_t m_batch_size;
+    bool m_asynchronous;
+    DecayType m_decay_type;
+    float m_final_sigma;
+    float m_final_damping;
+    float m_final_max_update_distance;
+    std::string m_checkpoint_filename;
+    bool m_resume;
+    uint32_t m_sync_interval;
+    bool m_model_parallel;
+    float m_early_stopping_churn;
+    float m_early_stopping_quantization_error_change;
+    std::string m_statistics_filename;
+    std::vector<TrainingStage> m_stages;
+    float m_best_match_cache_radius;
+    float m_best_match_cache_max_distance_increase;
+    uint32_t m_best_rotation_cache_window;
+    bool m_two_phase_search;
+    bool m_pipelined;
+    uint32_t m_transform_cache_size;
+    std::string m_last_iteration_mapping_filename;
+    bool m_deterministic;
+    std::vector<SweepVariant> m_sweep;
 };
 
 } // namespace pink
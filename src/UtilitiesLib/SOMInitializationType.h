@@ -16,6 +16,7 @@ enum class SOMInitialization
     ZERO,
     RANDOM,
     RANDOM_WITH_PREFERRED_DIRECTION,
+    PCA,
     FILEINIT
 };
 
@@ -25,6 +26,7 @@ inline std::ostream& operator << (std::ostream& os, SOMInitialization init)
     if (init == SOMInitialization::ZERO) os << "zero";
     else if (init == SOMInitialization::RANDOM) os << "random";
     else if (init == SOMInitialization::RANDOM_WITH_PREFERRED_DIRECTION) os << "random_with_preferred_direction";
+    else if (init == SOMInitialization::PCA) os << "pca";
     else if (init == SOMInitialization::FILEINIT) os << "file_init";
     else os << "undefined";
     return os;
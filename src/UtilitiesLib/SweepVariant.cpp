@@ -0,0 +1,96 @@
+/**
+ * @file   UtilitiesLib/SweepVariant.cpp
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#include <sstream>
+
+#include "pink_exception.h"
+#include "SweepVariant.h"
+#include "TrainingStage.h"
+
+namespace pink {
+
+namespace {
+
+float parse_float(std::string const& str, std::string const& entry)
+{
+    size_t end = 0;
+    float value = 0.0f;
+    try {
+        value = std::stof(str, &end);
+    } catch (std::exception const&) {
+        end = 0;
+    }
+    if (end == 0 or end != str.size()) throw pink::exception("Invalid sweep parameter " + entry);
+    return value;
+}
+
+uint32_t parse_integer(std::string const& str, std::string const& entry, int min_value)
+{
+    size_t end = 0;
+    int value = 0;
+    try {
+        value = std::stoi(str, &end);
+    } catch (std::exception const&) {
+        end = 0;
+    }
+    if (end == 0 or end != str.size() or value < min_value) throw pink::exception("Invalid sweep parameter " + entry);
+    return static_cast<uint32_t>(value);
+}
+
+} // namespace
+
+std::ostream& operator << (std::ostream& os, SweepVariant const& variant)
+{
+    std::string separator;
+    auto&& print = [&](std::string const& key, auto const& value) {
+        if (!value) return;
+        os << separator << key << "=" << *value;
+        separator = ",";
+    };
+    print("sigma", variant.m_sigma);
+    print("damping", variant.m_damping);
+    print("seed", variant.m_seed);
+    print("som-width", variant.m_som_width);
+    print("som-height", variant.m_som_height);
+    print("som-depth", variant.m_som_depth);
+    return os;
+}
+
+std::vector<SweepVariant> parse_sweep_variants(std::string const& str)
+{
+    std::vector<SweepVariant> variants;
+    std::stringstream ss(str);
+    std::string variant_str;
+    while (std::getline(ss, variant_str, ';')) {
+        SweepVariant variant;
+        std::stringstream variant_stream(variant_str);
+        std::string entry;
+        while (std::getline(variant_stream, entry, ',')) {
+            auto equal = entry.find('=');
+            if (equal == std::string::npos) throw pink::exception("Missing value of sweep parameter " + entry);
+            auto key = entry.substr(0, equal);
+            auto value = entry.substr(equal + 1);
+
+            if (key == "sigma") variant.m_sigma = parse_float(value, entry);
+            else if (key == "damping") variant.m_damping = parse_float(value, entry);
+            else if (key == "seed") variant.m_seed = parse_integer(value, entry, 0);
+            else if (key == "som-width") variant.m_som_width = parse_integer(value, entry, 1);
+            else if (key == "som-height") variant.m_som_height = parse_integer(value, entry, 1);
+            else if (key == "som-depth") variant.m_som_depth = parse_integer(value, entry, 1);
+            else throw pink::exception("Unknown sweep parameter " + key);
+        }
+        variants.push_back(variant);
+    }
+    if (variants.empty()) throw pink::exception("No SOM of the sweep given");
+    return variants;
+}
+
+std::string get_sweep_filename(std::string const& filename, size_t index)
+{
+    return insert_filename_suffix(filename, "_sweep_" + std::to_string(index));
+}
+
+} // namespace pink
@@ -0,0 +1,38 @@
+/**
+ * @file   UtilitiesLib/SweepVariant.h
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace pink {
+
+/// SOM of a hyper-parameter sweep, all parameters which are not given are taken from the command line
+struct SweepVariant
+{
+    std::optional<float> m_sigma;
+    std::optional<float> m_damping;
+    std::optional<uint32_t> m_seed;
+    std::optional<uint32_t> m_som_width;
+    std::optional<uint32_t> m_som_height;
+    std::optional<uint32_t> m_som_depth;
+};
+
+/// Pretty printing of the given parameters of SweepVariant as key=value list
+std::ostream& operator << (std::ostream& os, SweepVariant const& variant);
+
+/// Parse a semicolon separated list of SOMs with comma separated parameters,
+/// e.g. "sigma=1.1,damping=0.2;sigma=2.0,som-width=20,som-height=20"
+std::vector<SweepVariant> parse_sweep_variants(std::string const& str);
+
+/// Insert "_sweep_<index>" before the file extension, e.g. som.bin -> som_sweep_0.bin
+std::string get_sweep_filename(std::string const& filename, size_t index);
+
+} // namespace pink
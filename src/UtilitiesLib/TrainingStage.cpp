@@ -0,0 +1,71 @@
+/**
+ * @file   UtilitiesLib/TrainingStage.cpp
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#include <sstream>
+
+#include "pink_exception.h"
+#include "TrainingStage.h"
+
+namespace pink {
+
+namespace {
+
+uint32_t parse_positive_integer(std::string const& str, std::string const& stage)
+{
+    size_t end = 0;
+    int value = 0;
+    try {
+        value = std::stoi(str, &end);
+    } catch (std::exception const&) {
+        end = 0;
+    }
+    if (end == 0 or end != str.size() or value < 1) throw pink::exception("Invalid training stage " + stage);
+    return static_cast<uint32_t>(value);
+}
+
+} // namespace
+
+std::vector<TrainingStage> parse_training_stages(std::string const& str)
+{
+    std::vector<TrainingStage> stages;
+    std::stringstream ss(str);
+    std::string entry;
+    while (std::getline(ss, entry, ',')) {
+        auto colon = entry.find(':');
+        if (colon == std::string::npos) throw pink::exception("Missing number of iterations in training stage " + entry);
+
+        TrainingStage stage;
+        stage.m_number_of_iterations = parse_positive_integer(entry.substr(colon + 1), entry);
+
+        std::vector<uint32_t> dimension;
+        std::stringstream dimension_stream(entry.substr(0, colon));
+        std::string d;
+        while (std::getline(dimension_stream, d, 'x')) dimension.push_back(parse_positive_integer(d, entry));
+        if (dimension.empty() or dimension.size() > 3) throw pink::exception("Invalid training stage " + entry);
+
+        stage.m_som_width = dimension[0];
+        if (dimension.size() > 1) stage.m_som_height = dimension[1];
+        if (dimension.size() > 2) stage.m_som_depth = dimension[2];
+        stages.push_back(stage);
+    }
+    if (stages.empty()) throw pink::exception("No training stage given");
+    return stages;
+}
+
+std::string insert_filename_suffix(std::string const& filename, std::string const& suffix)
+{
+    auto dot = filename.find_last_of('.');
+    auto slash = filename.find_last_of('/');
+    if (dot == std::string::npos or (slash != std::string::npos and dot < slash)) return filename + suffix;
+    return filename.substr(0, dot) + suffix + filename.substr(dot);
+}
+
+std::string get_stage_filename(std::string const& filename, size_t index)
+{
+    return insert_filename_suffix(filename, "_stage_" + std::to_string(index));
+}
+
+} // namespace pink
@@ -0,0 +1,41 @@
+/**
+ * @file   UtilitiesLib/TrainingStage.h
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace pink {
+
+/// Coarse SOM of a multi-resolution training, which is upsampled to initialize the next stage
+struct TrainingStage
+{
+    uint32_t m_som_width = 1;
+    uint32_t m_som_height = 1;
+    uint32_t m_som_depth = 1;
+    uint32_t m_number_of_iterations = 1;
+};
+
+/// Pretty printing of TrainingStage as width x height x depth : iterations
+inline std::ostream& operator << (std::ostream& os, TrainingStage const& stage)
+{
+    return os << stage.m_som_width << "x" << stage.m_som_height << "x" << stage.m_som_depth
+              << ":" << stage.m_number_of_iterations;
+}
+
+/// Parse a comma separated list of stages, e.g. "5x5:2,11x11:2"
+std::vector<TrainingStage> parse_training_stages(std::string const& str);
+
+/// Insert the suffix before the file extension, if there is one
+std::string insert_filename_suffix(std::string const& filename, std::string const& suffix);
+
+/// Insert "_stage_<index>" before the file extension, e.g. som.bin -> som_stage_0.bin
+std::string get_stage_filename(std::string const& filename, size_t index);
+
+} // namespace pink
@@ -0,0 +1,29 @@
+/**
+ * @file   UtilitiesLib/TransformationLayout.h
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#pragma once
+
+#include <iostream>
+
+namespace pink {
+
+/// Memory layout of the spatial transformed images used for the CPU euclidean distance
+enum class TransformationLayout
+{
+    NEURON_MAJOR,  ///< [transformation][pixel], one transformation after the other
+    PIXEL_MAJOR    ///< [block][pixel][transformation], transformations interleaved in SIMD blocks
+};
+
+/// Pretty printing of TransformationLayout
+inline std::ostream& operator << (std::ostream& os, TransformationLayout layout)
+{
+    if (layout == TransformationLayout::NEURON_MAJOR) os << "neuron_major";
+    else if (layout == TransformationLayout::PIXEL_MAJOR) os << "pixel_major";
+    else os << "undefined";
+    return os;
+}
+
+} // namespace pink
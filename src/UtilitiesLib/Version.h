@@ -0,0 +1,10 @@
+/**
+ * @file   Version.h
+ * @date   Nov 6, 2014
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#pragma once
+
+#define PROJECT_VERSION "2.5"
+#define GIT_REVISION "fdcd41d"
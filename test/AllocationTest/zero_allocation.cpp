@@ -0,0 +1,172 @@
+/**
+ * @file   AllocationTest/zero_allocation.cpp
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <new>
+#include <omp.h>
+#include <vector>
+
+#include "SelfOrganizingMapLib/CartesianLayout.h"
+#include "SelfOrganizingMapLib/Data.h"
+#include "SelfOrganizingMapLib/Mapper.h"
+#include "SelfOrganizingMapLib/SOM.h"
+#include "SelfOrganizingMapLib/Trainer.h"
+#include "UtilitiesLib/DistributionFunctor.h"
+#include "UtilitiesLib/Filler.h"
+
+namespace {
+
+/// Number of calls of the global operator new
+std::atomic<size_t> number_of_allocations(0);
+
+void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) noexcept
+{
+    ++number_of_allocations;
+    if (size == 0) size = 1;
+    if (alignment <= alignof(std::max_align_t)) return std::malloc(size);
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+void* allocate_or_throw(std::size_t size, std::size_t alignment = alignof(std::max_align_t))
+{
+    if (void *ptr = allocate(size, alignment)) return ptr;
+    throw std::bad_alloc();
+}
+
+} // namespace
+
+// Replacement of all forms of the global operator new and delete
+
+void* operator new(std::size_t size) { return allocate_or_throw(size); }
+void* operator new[](std::size_t size) { return allocate_or_throw(size); }
+void* operator new(std::size_t size, std::align_val_t al) { return allocate_or_throw(size, static_cast<std::size_t>(al)); }
+void* operator new[](std::size_t size, std::align_val_t al) { return allocate_or_throw(size, static_cast<std::size_t>(al)); }
+
+void* operator new(std::size_t size, std::nothrow_t const&) noexcept { return allocate(size); }
+void* operator new[](std::size_t size, std::nothrow_t const&) noexcept { return allocate(size); }
+void* operator new(std::size_t size, std::align_val_t al, std::nothrow_t const&) noexcept
+{ return allocate(size, static_cast<std::size_t>(al)); }
+void* operator new[](std::size_t size, std::align_val_t al, std::nothrow_t const&) noexcept
+{ return allocate(size, static_cast<std::size_t>(al)); }
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::nothrow_t const&) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::nothrow_t const&) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::align_val_t, std::nothrow_t const&) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::align_val_t, std::nothrow_t const&) noexcept { std::free(ptr); }
+
+using namespace pink;
+
+struct ZeroAllocationTestData
+{
+    ZeroAllocationTestData(uint32_t depth, TransformationLayout layout)
+      : depth(depth),
+        layout(layout)
+    {}
+
+    uint32_t depth;
+    TransformationLayout layout;
+};
+
+class ZeroAllocationTest : public ::testing::TestWithParam<ZeroAllocationTestData>
+{
+protected:
+
+    /// The OpenMP runtime may allocate memory for thread teams, which is not part of this test
+    void SetUp() override
+    {
+        m_number_of_threads = omp_get_max_threads();
+        omp_set_num_threads(1);
+    }
+
+    void TearDown() override
+    {
+        omp_set_num_threads(m_number_of_threads);
+    }
+
+    int m_number_of_threads;
+};
+
+TEST_P(ZeroAllocationTest, trainer)
+{
+    typedef Data<CartesianLayout<3>, float> DataType;
+    typedef SOM<CartesianLayout<2>, CartesianLayout<3>, float> SOMType;
+    typedef Trainer<CartesianLayout<2>, CartesianLayout<3>, float, false> TrainerType;
+
+    auto param = GetParam();
+
+    std::vector<DataType> images(3, DataType({param.depth, 10, 10}));
+    for (uint32_t i = 0; i < images.size(); ++i) {
+        fill_random_uniform(images[i].get_data_pointer(), images[i].size(), i);
+    }
+
+    SOMType som({4, 4}, {param.depth, 14, 14}, 0.0f);
+    fill_random_uniform(som.get_data_pointer(), som.size(), 42);
+
+    TrainerType trainer(som, GaussianFunctor(1.1f, 0.2f), 0, 8, true, -1.0, Interpolation::BILINEAR, 8,
+        EuclideanDistanceShape::QUADRATIC, param.layout);
+
+    // The first step may size the buffers
+    trainer(images[0]);
+
+    auto before = number_of_allocations.load();
+    for (auto&& image : images) trainer(image);
+    EXPECT_EQ(before, number_of_allocations.load());
+}
+
+TEST_P(ZeroAllocationTest, mapper)
+{
+    typedef Data<CartesianLayout<3>, float> DataType;
+    typedef SOM<CartesianLayout<2>, CartesianLayout<3>, float> SOMType;
+    typedef Mapper<CartesianLayout<2>, CartesianLayout<3>, float, false> MapperType;
+
+    auto param = GetParam();
+
+    std::vector<DataType> images(3, DataType({param.depth, 10, 10}));
+    for (uint32_t i = 0; i < images.size(); ++i) {
+        fill_random_uniform(images[i].get_data_pointer(), images[i].size(), i);
+    }
+
+    SOMType som({4, 4}, {param.depth, 14, 14}, 0.0f);
+    fill_random_uniform(som.get_data_pointer(), som.size(), 42);
+
+    MapperType mapper(som, 0, 8, true, Interpolation::BILINEAR, 8, EuclideanDistanceShape::QUADRATIC, param.layout);
+
+    std::vector<float> euclidean_distance_matrix(som.get_number_of_neurons());
+    std::vector<uint32_t> best_rotation_matrix(som.get_number_of_neurons());
+
+    // The first step may size the buffers
+    mapper(images[0], euclidean_distance_matrix.data(), best_rotation_matrix.data());
+
+    auto before = number_of_allocations.load();
+    for (auto&& image : images) mapper(image, euclidean_distance_matrix.data(), best_rotation_matrix.data());
+    EXPECT_EQ(before, number_of_allocations.load());
+
+    // Same result as the allocating interface, which is also a check of the counter
+    auto result = mapper(images.back());
+    EXPECT_LT(before, number_of_allocations.load());
+    EXPECT_EQ(std::get<0>(result), euclidean_distance_matrix);
+    EXPECT_EQ(std::get<1>(result), best_rotation_matrix);
+}
+
+INSTANTIATE_TEST_SUITE_P(ZeroAllocationTest_all, ZeroAllocationTest,
+    ::testing::Values(
+        // depth, layout
+        ZeroAllocationTestData(1, TransformationLayout::NEURON_MAJOR),
+        ZeroAllocationTestData(1, TransformationLayout::PIXEL_MAJOR),
+        ZeroAllocationTestData(3, TransformationLayout::NEURON_MAJOR),
+        ZeroAllocationTestData(3, TransformationLayout::PIXEL_MAJOR)
+));
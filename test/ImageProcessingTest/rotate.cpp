@@ -78,3 +78,32 @@ TEST(RotationTest, compare_with_crop)
 
     EXPECT_TRUE(EqualFloatArrays(dst_crop, dst, 1e-4f));
 }
+
+TEST(RotationTest, rotate_channels_compare_with_single_channel)
+{
+    uint32_t src_dim = 7;
+    uint32_t dst_dim = 9;
+    uint32_t number_of_channels = 3;
+    uint32_t src_size = src_dim * src_dim;
+    uint32_t dst_size = dst_dim * dst_dim;
+    float rad = 0.3f;
+
+    std::vector<float> src(number_of_channels * src_size);
+    for (uint32_t i = 0; i < src.size(); ++i) src[i] = static_cast<float>(std::sin(i));
+
+    std::vector<float> interleaved(src.size());
+    for (uint32_t c = 0; c < number_of_channels; ++c) {
+        for (uint32_t p = 0; p < src_size; ++p) interleaved[p * number_of_channels + c] = src[c * src_size + p];
+    }
+
+    std::vector<float> expected(number_of_channels * dst_size);
+    for (uint32_t c = 0; c < number_of_channels; ++c) {
+        rotate_bilinear(&src[c * src_size], &expected[c * dst_size], src_dim, src_dim, dst_dim, dst_dim, rad);
+    }
+
+    std::vector<float> actual(number_of_channels * dst_size);
+    rotate_bilinear_channels(&interleaved[0], &actual[0], src_dim, src_dim, dst_dim, dst_dim, rad,
+        number_of_channels);
+
+    EXPECT_EQ(expected, actual);
+}
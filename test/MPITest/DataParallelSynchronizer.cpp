@@ -0,0 +1,76 @@
+/**
+ * @file   MPITest/DataParallelSynchronizer.cpp
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <vector>
+
+#include "SelfOrganizingMapLib/CartesianLayout.h"
+#include "SelfOrganizingMapLib/ConvergenceStatistics.h"
+#include "SelfOrganizingMapLib/Data.h"
+#include "SelfOrganizingMapLib/DataParallelSynchronizer.h"
+#include "SelfOrganizingMapLib/SOM.h"
+
+using namespace pink;
+
+TEST(DataParallelSynchronizerTest, sum_of_changes)
+{
+    typedef SOM<CartesianLayout<2>, CartesianLayout<2>, float> SOMType;
+
+    int rank, number_of_ranks;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &number_of_ranks);
+
+    // Rank 0 defines the initial SOM
+    SOMType som({4, 4}, {2, 2}, rank == 0 ? 1.0f : 0.0f);
+    DataParallelSynchronizer<CartesianLayout<2>, CartesianLayout<2>, float> synchronizer(som);
+    EXPECT_EQ(rank, synchronizer.get_rank());
+    EXPECT_EQ(number_of_ranks, synchronizer.get_number_of_ranks());
+    for (size_t i = 0; i < som.size(); ++i) EXPECT_EQ(1.0f, som.get_data_pointer()[i]);
+
+    // Each process changes another element
+    som.get_data_pointer()[rank] += 2.0f;
+    synchronizer();
+
+    for (size_t i = 0; i < som.size(); ++i) {
+        EXPECT_EQ(static_cast<int>(i) < number_of_ranks ? 3.0f : 1.0f, som.get_data_pointer()[i]);
+    }
+
+    // All processes change the same element
+    som.get_data_pointer()[0] -= 0.5f;
+    synchronizer();
+    EXPECT_EQ(3.0f - 0.5f * number_of_ranks, som.get_data_pointer()[0]);
+}
+
+TEST(DataParallelSynchronizerTest, reduce_update_info)
+{
+    SOM<CartesianLayout<2>, CartesianLayout<2>, float> som({2, 2}, {2, 2}, 0.0f);
+    DataParallelSynchronizer<CartesianLayout<2>, CartesianLayout<2>, float> synchronizer(som);
+
+    Data<CartesianLayout<2>, uint32_t> update_info({2, 2}, 1);
+    synchronizer.reduce(update_info);
+
+    for (uint32_t i = 0; i < update_info.size(); ++i) {
+        EXPECT_EQ(static_cast<uint32_t>(synchronizer.get_number_of_ranks()), update_info[i]);
+    }
+}
+
+TEST(DataParallelSynchronizerTest, reduce_convergence_statistics)
+{
+    SOM<CartesianLayout<2>, CartesianLayout<2>, float> som({2, 2}, {2, 2}, 0.0f);
+    DataParallelSynchronizer<CartesianLayout<2>, CartesianLayout<2>, float> synchronizer(som);
+    auto number_of_ranks = static_cast<uint32_t>(synchronizer.get_number_of_ranks());
+
+    // Each process trains another data point
+    ConvergenceStatistics statistics(number_of_ranks, 4);
+    auto rank = static_cast<uint32_t>(synchronizer.get_rank());
+    statistics.add(rank, rank % 4, static_cast<float>(rank));
+    synchronizer.reduce(statistics);
+
+    auto&& result = statistics.finish_iteration();
+    EXPECT_EQ(number_of_ranks, result.number_of_data_points);
+    EXPECT_DOUBLE_EQ((number_of_ranks - 1) * 0.5, result.mean_quantization_error);
+}
@@ -0,0 +1,85 @@
+/**
+ * @file   MPITest/ModelParallelTrainer.cpp
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <mpi.h>
+#include <string>
+#include <vector>
+
+#include "SelfOrganizingMapLib/CartesianLayout.h"
+#include "SelfOrganizingMapLib/Data.h"
+#include "SelfOrganizingMapLib/FileIO.h"
+#include "SelfOrganizingMapLib/ModelParallelTrainer.h"
+#include "SelfOrganizingMapLib/SOM.h"
+#include "SelfOrganizingMapLib/Trainer.h"
+#include "UtilitiesLib/DistributionFunctor.h"
+#include "UtilitiesLib/Filler.h"
+
+using namespace pink;
+
+namespace {
+
+std::string read_file(std::string const& filename)
+{
+    std::ifstream is(filename, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+}
+
+} // namespace
+
+TEST(ModelParallelTrainerTest, equals_sequential_trainer)
+{
+    typedef Data<CartesianLayout<2>, float> DataType;
+    typedef SOM<CartesianLayout<2>, CartesianLayout<2>, float> SOMType;
+
+    uint32_t image_dim = 8;
+    uint32_t neuron_dim = 6;
+    SOMType som({7, 5}, {neuron_dim, neuron_dim}, 0.0f);
+    fill_random_uniform(som.get_data_pointer(), som.size(), 42);
+
+    auto&& f = GaussianFunctor(1.1f, 0.2f);
+
+    // Each process trains the complete SOM sequentially as reference
+    Trainer<CartesianLayout<2>, CartesianLayout<2>, float, false> trainer(som, f, 0, 8, true, -1.0,
+        Interpolation::BILINEAR, neuron_dim);
+    ModelParallelTrainer<CartesianLayout<2>, CartesianLayout<2>, float> model_parallel_trainer(
+        som.get_som_layout(), som.get_neuron_layout(), f, 0, 8, true, -1.0, Interpolation::BILINEAR, neuron_dim);
+    model_parallel_trainer.set_shard(som);
+
+    int number_of_ranks;
+    MPI_Comm_size(MPI_COMM_WORLD, &number_of_ranks);
+    EXPECT_EQ(number_of_ranks, model_parallel_trainer.get_number_of_ranks());
+
+    for (uint32_t n = 0; n < 20; ++n) {
+        DataType data({image_dim, image_dim});
+        fill_random_uniform(data.get_data_pointer(), data.size(), n);
+        trainer(data);
+
+        // Only the image of rank 0 is used
+        DataType received_data({image_dim, image_dim}, 0.0f);
+        if (model_parallel_trainer.get_rank() == 0) received_data = data;
+        model_parallel_trainer(received_data);
+        EXPECT_EQ(data, received_data);
+    }
+
+    auto&& reference = som.get_data();
+    auto begin = reference.begin() + model_parallel_trainer.get_begin() * som.get_neuron_size();
+    auto end = reference.begin() + model_parallel_trainer.get_end() * som.get_neuron_size();
+    EXPECT_EQ(std::vector<float>(begin, end), model_parallel_trainer.get_shard());
+    EXPECT_EQ(trainer.get_update_info(), model_parallel_trainer.get_update_info());
+
+    // The gathered SOM file is identical to the sequential one
+    model_parallel_trainer.write("ModelParallelTrainerTest.bin");
+    if (model_parallel_trainer.get_rank() == 0) {
+        write(som, "ModelParallelTrainerTest_reference.bin");
+        EXPECT_EQ(read_file("ModelParallelTrainerTest_reference.bin"), read_file("ModelParallelTrainerTest.bin"));
+        std::remove("ModelParallelTrainerTest.bin");
+        std::remove("ModelParallelTrainerTest_reference.bin");
+    }
+}
@@ -0,0 +1,28 @@
+/**
+ * @file   MPITest/main.cpp
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <omp.h>
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    omp_set_num_threads(1);
+    ::testing::InitGoogleTest(&argc, argv);
+
+    // Only the first process prints the results
+    int rank = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    if (rank != 0) {
+        auto&& listeners = ::testing::UnitTest::GetInstance()->listeners();
+        delete listeners.Release(listeners.default_result_printer());
+    }
+
+    auto result = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return result;
+}
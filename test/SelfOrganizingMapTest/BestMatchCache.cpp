@@ -0,0 +1,103 @@
+/**
+ * @file   SelfOrganizingMapTest/BestMatchCache.cpp
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "SelfOrganizingMapLib/BestMatchCache.h"
+#include "SelfOrganizingMapLib/CartesianLayout.h"
+#include "SelfOrganizingMapLib/Data.h"
+#include "SelfOrganizingMapLib/SOM.h"
+#include "SelfOrganizingMapLib/Trainer.h"
+#include "UtilitiesLib/DistributionFunctor.h"
+#include "UtilitiesLib/Filler.h"
+
+using namespace pink;
+
+TEST(BestMatchCacheTest, get_and_set)
+{
+    BestMatchCache cache(3, 2.0f, 0.1f);
+
+    uint32_t best_match = 0;
+    float distance = 0.0f;
+    EXPECT_FALSE(cache.get(1, best_match, distance));
+
+    cache.set(1, 0, 2.0f);
+    EXPECT_TRUE(cache.get(1, best_match, distance));
+    EXPECT_EQ(0U, best_match);
+    EXPECT_FLOAT_EQ(2.0f, distance);
+    EXPECT_THROW(cache.set(3, 0, 2.0f), pink::exception);
+
+    EXPECT_TRUE(cache.is_accepted(2.2f, 2.0f));
+    EXPECT_FALSE(cache.is_accepted(2.3f, 2.0f));
+
+    cache.count(true);
+    cache.count(false);
+    EXPECT_DOUBLE_EQ(0.5, cache.get_hit_rate());
+    cache.reset_counters();
+    EXPECT_DOUBLE_EQ(0.0, cache.get_hit_rate());
+
+    EXPECT_THROW(BestMatchCache(3, 0.5f, 0.1f), pink::exception);
+}
+
+class BestMatchCacheTrainerTest : public ::testing::TestWithParam<TransformationLayout>
+{};
+
+TEST_P(BestMatchCacheTrainerTest, equal_to_full_search)
+{
+    typedef Data<CartesianLayout<2>, float> DataType;
+    typedef SOM<CartesianLayout<2>, CartesianLayout<2>, float> SOMType;
+    typedef Trainer<CartesianLayout<2>, CartesianLayout<2>, float, false> MyTrainer;
+
+    uint32_t som_dim = 6;
+    uint32_t neuron_dim = 4;
+    uint32_t number_of_images = 20;
+
+    std::vector<DataType> images;
+    for (uint32_t i = 0; i < number_of_images; ++i) {
+        images.emplace_back(DataType({neuron_dim, neuron_dim}));
+        fill_random_uniform(images.back().get_data_pointer(), images.back().size(), i);
+    }
+
+    SOMType som1({som_dim, som_dim}, {neuron_dim, neuron_dim}, 0.0f);
+    fill_random_uniform(som1.get_data_pointer(), som1.size(), 42);
+    SOMType som2 = som1;
+    SOMType som3 = som1;
+
+    auto&& f = GaussianFunctor(1.1f, 0.2f);
+    float max_update_distance = 2.0f;
+
+    MyTrainer trainer1(som1, f, 0, 4, true, max_update_distance, Interpolation::BILINEAR, neuron_dim,
+        EuclideanDistanceShape::QUADRATIC, GetParam());
+    MyTrainer trainer2(som2, f, 0, 4, true, max_update_distance, Interpolation::BILINEAR, neuron_dim,
+        EuclideanDistanceShape::QUADRATIC, GetParam());
+    MyTrainer trainer3(som3, f, 0, 4, true, max_update_distance, Interpolation::BILINEAR, neuron_dim,
+        EuclideanDistanceShape::QUADRATIC, GetParam());
+
+    // A window covering the whole SOM finds always the global best match
+    trainer2.enable_best_match_cache(number_of_images, 2.0f * som_dim, 1e6f);
+
+    // A small window is only accepted with an interior best match
+    trainer3.enable_best_match_cache(number_of_images, 2.0f, 0.5f);
+
+    for (uint32_t iteration = 0; iteration < 3; ++iteration)
+    {
+        for (uint32_t i = 0; i < number_of_images; ++i) {
+            trainer1(images[i], i);
+            trainer2(images[i], i);
+            trainer3(std::vector<DataType>(1, images[i]), {i});
+        }
+
+        EXPECT_EQ(som1, som2);
+        EXPECT_DOUBLE_EQ(iteration == 0 ? 0.0 : 1.0, trainer2.get_best_match_cache().get_hit_rate());
+        EXPECT_EQ(number_of_images, trainer3.get_best_match_cache().get_number_of_searches());
+        trainer2.get_best_match_cache().reset_counters();
+        trainer3.get_best_match_cache().reset_counters();
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(BestMatchCacheTrainerTest_all, BestMatchCacheTrainerTest,
+    ::testing::Values(TransformationLayout::NEURON_MAJOR, TransformationLayout::PIXEL_MAJOR));
@@ -0,0 +1,96 @@
+/**
+ * @file   SelfOrganizingMapTest/BestRotationCache.cpp
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "SelfOrganizingMapLib/BestRotationCache.h"
+#include "SelfOrganizingMapLib/CartesianLayout.h"
+#include "SelfOrganizingMapLib/Data.h"
+#include "SelfOrganizingMapLib/SOM.h"
+#include "SelfOrganizingMapLib/Trainer.h"
+#include "UtilitiesLib/DistributionFunctor.h"
+#include "UtilitiesLib/Filler.h"
+
+using namespace pink;
+
+TEST(BestRotationCacheTest, window)
+{
+    BestRotationCache cache(2, 8, true, 1);
+
+    uint32_t best_match = 0;
+    uint32_t transformation = 0;
+    EXPECT_FALSE(cache.get(0, best_match, transformation));
+
+    // Flipped transformation of rotation 0
+    cache.set(0, 5, 8);
+    EXPECT_TRUE(cache.get(0, best_match, transformation));
+    EXPECT_EQ(5U, best_match);
+    EXPECT_EQ(8U, transformation);
+
+    std::vector<uint32_t> transformations;
+    cache.get_window(transformation, transformations);
+    EXPECT_EQ((std::vector<uint32_t>{8, 9, 15}), transformations);
+
+    // The window covers all rotations
+    BestRotationCache full_cache(2, 4, true, 2);
+    full_cache.get_window(1, transformations);
+    EXPECT_EQ((std::vector<uint32_t>{1, 2, 0, 3}), transformations);
+
+    EXPECT_THROW(cache.set(2, 0, 0), pink::exception);
+    EXPECT_THROW(BestRotationCache(2, 8, true, 0), pink::exception);
+}
+
+TEST(BestRotationCacheTest, trainer)
+{
+    typedef Data<CartesianLayout<2>, float> DataType;
+    typedef SOM<CartesianLayout<2>, CartesianLayout<2>, float> SOMType;
+    typedef Trainer<CartesianLayout<2>, CartesianLayout<2>, float, false> MyTrainer;
+
+    uint32_t som_dim = 4;
+    uint32_t neuron_dim = 6;
+    uint32_t number_of_images = 10;
+    uint32_t number_of_rotations = 16;
+
+    std::vector<DataType> images;
+    for (uint32_t i = 0; i < number_of_images; ++i) {
+        images.emplace_back(DataType({neuron_dim, neuron_dim}));
+        fill_random_uniform(images.back().get_data_pointer(), images.back().size(), i);
+    }
+
+    SOMType som1({som_dim, som_dim}, {neuron_dim, neuron_dim}, 0.0f);
+    fill_random_uniform(som1.get_data_pointer(), som1.size(), 42);
+    SOMType som2 = som1;
+    SOMType som3 = som1;
+
+    auto&& f = GaussianFunctor(1.1f, 0.2f);
+
+    MyTrainer trainer1(som1, f, 0, number_of_rotations, true, -1.0, Interpolation::BILINEAR, neuron_dim);
+    MyTrainer trainer2(som2, f, 0, number_of_rotations, true, -1.0, Interpolation::BILINEAR, neuron_dim);
+    MyTrainer trainer3(som3, f, 0, number_of_rotations, true, -1.0, Interpolation::BILINEAR, neuron_dim);
+
+    // The search bounded by the cache is exact for all window sizes
+    trainer2.enable_best_rotation_cache(number_of_images, number_of_rotations / 2);
+    trainer3.enable_best_rotation_cache(number_of_images, 1);
+
+    for (uint32_t iteration = 0; iteration < 3; ++iteration)
+    {
+        for (uint32_t i = 0; i < number_of_images; ++i) {
+            trainer1(images[i], i);
+            trainer2(images[i], i);
+            trainer3(std::vector<DataType>(1, images[i]), {i});
+        }
+
+        EXPECT_EQ(som1, som2);
+        EXPECT_EQ(som1, som3);
+        if (iteration == 0) {
+            EXPECT_DOUBLE_EQ(0.0, trainer2.get_best_rotation_cache().get_hit_rate());
+        }
+        EXPECT_EQ(number_of_images, trainer3.get_best_rotation_cache().get_number_of_searches());
+        trainer2.get_best_rotation_cache().reset_counters();
+        trainer3.get_best_rotation_cache().reset_counters();
+    }
+}
@@ -0,0 +1,131 @@
+/**
+ * @file   SelfOrganizingMapTest/Checkpoint.cpp
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+
+#include "SelfOrganizingMapLib/CartesianLayout.h"
+#include "SelfOrganizingMapLib/Checkpoint.h"
+#include "SelfOrganizingMapLib/Data.h"
+#include "SelfOrganizingMapLib/SOM.h"
+#include "SelfOrganizingMapLib/SOMIO.h"
+#include "UtilitiesLib/Filler.h"
+
+using namespace pink;
+
+TEST(CheckpointTest, write_and_read)
+{
+    typedef SOM<CartesianLayout<2>, CartesianLayout<2>, float> SOMType;
+    typedef Data<CartesianLayout<2>, uint32_t> UpdateInfoType;
+
+    SOMType som({3, 3}, {4, 4});
+    fill_random_uniform(som.get_data_pointer(), som.size(), 42);
+
+    UpdateInfoType update_info({3, 3}, 0);
+    for (uint32_t i = 0; i < update_info.size(); ++i) update_info[i] = i * i;
+
+    InputData input_data;
+    input_data.m_decay_type = DecayType::EXPONENTIAL;
+    input_data.m_final_sigma = 0.1f;
+
+    Checkpoint checkpoint(input_data);
+    checkpoint.iteration = 3;
+    checkpoint.position = 17;
+    checkpoint.intermediate_count = 5;
+
+    std::string filename = "CheckpointTest.bin";
+    write_checkpoint(filename, checkpoint, som, update_info);
+
+    SOMType som2({3, 3}, {4, 4}, 0.0f);
+    UpdateInfoType update_info2({3, 3}, 0);
+    auto checkpoint2 = read_checkpoint(filename, som2, update_info2);
+    std::remove(filename.c_str());
+
+    EXPECT_EQ(som, som2);
+    EXPECT_EQ(update_info, update_info2);
+    EXPECT_EQ(3U, checkpoint2.iteration);
+    EXPECT_EQ(17U, checkpoint2.position);
+    EXPECT_EQ(5U, checkpoint2.intermediate_count);
+    EXPECT_TRUE(checkpoint2.has_same_parameters(Checkpoint(input_data)));
+
+    input_data.m_seed += 1;
+    EXPECT_FALSE(checkpoint2.has_same_parameters(Checkpoint(input_data)));
+}
+
+TEST(CheckpointTest, parameters)
+{
+    InputData input_data;
+    input_data.m_neuron_dimension = {4, 4};
+    input_data.m_batch_size = 8;
+
+    std::string filename = "CheckpointTest_parameters.bin";
+    {
+        SOM<CartesianLayout<2>, CartesianLayout<2>, float> som({3, 3}, {4, 4}, 1.0f);
+        Data<CartesianLayout<2>, uint32_t> update_info({3, 3}, 0);
+        write_checkpoint(filename, Checkpoint(input_data), som, update_info);
+
+        auto checkpoint = read_checkpoint(filename, som, update_info);
+        std::remove(filename.c_str());
+
+        EXPECT_EQ(input_data.m_neuron_dimension, checkpoint.neuron_dimension);
+        EXPECT_EQ(8U, checkpoint.batch_size);
+        EXPECT_TRUE(checkpoint.has_same_parameters(Checkpoint(input_data)));
+    }
+
+    auto expect_differs = [&](auto change)
+    {
+        auto other = input_data;
+        change(other);
+        EXPECT_FALSE(Checkpoint(input_data).has_same_parameters(Checkpoint(other)));
+    };
+
+    expect_differs([](InputData& i){ i.m_number_of_rotations += 4; });
+    expect_differs([](InputData& i){ i.m_use_flip = !i.m_use_flip; });
+    expect_differs([](InputData& i){ i.m_interpolation = Interpolation::NEAREST_NEIGHBOR; });
+    expect_differs([](InputData& i){ i.m_distribution_function = DistributionFunction::MEXICANHAT; });
+    expect_differs([](InputData& i){ i.m_layout = Layout::HEXAGONAL; });
+    expect_differs([](InputData& i){ i.m_som_width += 1; });
+    expect_differs([](InputData& i){ i.m_neuron_dimension = {5, 5}; });
+    expect_differs([](InputData& i){ i.m_init = SOMInitialization::PCA; });
+    expect_differs([](InputData& i){ i.m_batch_size = 1; });
+    expect_differs([](InputData& i){ i.m_asynchronous = !i.m_asynchronous; });
+    expect_differs([](InputData& i){ i.m_pipelined = !i.m_pipelined; });
+}
+
+TEST(CheckpointTest, wrong_file_type)
+{
+    SOM<CartesianLayout<2>, CartesianLayout<2>, float> som({3, 3}, {4, 4}, 1.0f);
+    Data<CartesianLayout<2>, uint32_t> update_info({3, 3}, 0);
+
+    // File type 3 is the best rotation and flip file
+    std::string filename = "CheckpointTest_wrong_file_type.bin";
+    {
+        std::ofstream os(filename, std::ios::binary);
+        int header[] = {2, 3, 1, 0, 2, 3, 3};
+        os.write(reinterpret_cast<char const*>(header), sizeof(header));
+    }
+    EXPECT_THROW(read_checkpoint(filename, som, update_info), pink::exception);
+    std::remove(filename.c_str());
+}
+
+TEST(CheckpointTest, wrong_som_size)
+{
+    typedef SOM<CartesianLayout<2>, CartesianLayout<2>, float> SOMType;
+    typedef Data<CartesianLayout<2>, uint32_t> UpdateInfoType;
+
+    SOMType som({3, 3}, {4, 4}, 1.0f);
+    UpdateInfoType update_info({3, 3}, 0);
+
+    std::string filename = "CheckpointTest_wrong_som_size.bin";
+    write_checkpoint(filename, Checkpoint(), som, update_info);
+
+    SOMType som2({2, 2}, {4, 4}, 0.0f);
+    UpdateInfoType update_info2({2, 2}, 0);
+    EXPECT_THROW(read_checkpoint(filename, som2, update_info2), pink::exception);
+    std::remove(filename.c_str());
+}
@@ -0,0 +1,142 @@
+/**
+ * @file   SelfOrganizingMapTest/ConvergenceStatistics.cpp
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#include <gtest/gtest.h>
+#include <omp.h>
+#include <vector>
+
+#include "SelfOrganizingMapLib/CartesianLayout.h"
+#include "SelfOrganizingMapLib/ConvergenceStatistics.h"
+#include "SelfOrganizingMapLib/Data.h"
+#include "SelfOrganizingMapLib/SOM.h"
+#include "SelfOrganizingMapLib/Trainer.h"
+#include "UtilitiesLib/DistributionFunctor.h"
+#include "UtilitiesLib/Filler.h"
+
+using namespace pink;
+
+TEST(ConvergenceStatisticsTest, iterations)
+{
+    ConvergenceStatistics statistics(4, 4);
+
+    // All data points at different neurons, the distances are squared
+    statistics.add(0, 0, 1.0f);
+    statistics.add(1, 1, 4.0f);
+    statistics.add(2, 2, 9.0f);
+    statistics.add(3, 3, 16.0f);
+
+    auto&& first = statistics.finish_iteration();
+    EXPECT_EQ(4U, first.number_of_data_points);
+    EXPECT_DOUBLE_EQ(2.5, first.mean_quantization_error);
+    EXPECT_DOUBLE_EQ(1.0, first.best_match_churn);
+    EXPECT_DOUBLE_EQ(1.0, first.update_entropy);
+
+    // All data points at the same neuron, two of them changed
+    statistics.add(3, 0, 1.0f);
+    statistics.add(2, 0, 1.0f);
+    statistics.add(1, 0, 1.0f);
+    statistics.add(0, 0, 1.0f);
+
+    auto&& second = statistics.finish_iteration();
+    EXPECT_EQ(4U, second.number_of_data_points);
+    EXPECT_DOUBLE_EQ(1.0, second.mean_quantization_error);
+    EXPECT_DOUBLE_EQ(0.75, second.best_match_churn);
+    EXPECT_DOUBLE_EQ(0.0, second.update_entropy);
+
+    // Only a part of the data points
+    statistics.add(1, 0, 4.0f);
+    statistics.add(2, 1, 16.0f);
+
+    auto&& third = statistics.finish_iteration();
+    EXPECT_EQ(2U, third.number_of_data_points);
+    EXPECT_DOUBLE_EQ(3.0, third.mean_quantization_error);
+    EXPECT_DOUBLE_EQ(0.5, third.best_match_churn);
+    EXPECT_DOUBLE_EQ(0.5, third.update_entropy);
+
+    EXPECT_THROW(statistics.add(4, 0, 1.0f), pink::exception);
+}
+
+TEST(ConvergenceStatisticsTest, is_converged)
+{
+    IterationStatistics previous, current;
+    previous.mean_quantization_error = 10.0;
+    previous.number_of_data_points = 10;
+    current.mean_quantization_error = 9.5;
+    current.best_match_churn = 0.1;
+
+    EXPECT_FALSE(is_converged(previous, current, -1.0, -1.0));
+    EXPECT_TRUE(is_converged(previous, current, 0.1, -1.0));
+    EXPECT_FALSE(is_converged(previous, current, 0.05, -1.0));
+    EXPECT_TRUE(is_converged(previous, current, -1.0, 0.05));
+    EXPECT_FALSE(is_converged(previous, current, -1.0, 0.01));
+    EXPECT_TRUE(is_converged(previous, current, 0.2, 0.1));
+    EXPECT_FALSE(is_converged(previous, current, 0.05, 0.1));
+
+    // The quantization error criterion needs a previous iteration
+    EXPECT_FALSE(is_converged(IterationStatistics(), current, -1.0, 0.5));
+}
+
+TEST(ConvergenceStatisticsTest, trainer)
+{
+    typedef Data<CartesianLayout<2>, float> DataType;
+    typedef SOM<CartesianLayout<2>, CartesianLayout<2>, float> SOMType;
+    typedef Trainer<CartesianLayout<2>, CartesianLayout<2>, float, false> MyTrainer;
+
+    uint32_t som_dim = 3;
+    uint32_t neuron_dim = 4;
+
+    std::vector<DataType> images;
+    std::vector<uint32_t> indices;
+    for (uint32_t i = 0; i < 6; ++i) {
+        images.emplace_back(DataType({neuron_dim, neuron_dim}));
+        fill_random_uniform(images.back().get_data_pointer(), images.back().size(), i);
+        indices.push_back(i);
+    }
+
+    SOMType som1({som_dim, som_dim}, {neuron_dim, neuron_dim}, 0.0f);
+    fill_random_uniform(som1.get_data_pointer(), som1.size(), 42);
+    SOMType som2 = som1;
+    SOMType som3 = som1;
+
+    auto&& f = GaussianFunctor(1.1f, 0.2f);
+
+    MyTrainer trainer1(som1, f, 0, 4, true, -1.0, Interpolation::BILINEAR, neuron_dim);
+    MyTrainer trainer2(som2, f, 0, 4, true, -1.0, Interpolation::BILINEAR, neuron_dim);
+    MyTrainer trainer3(som3, f, 0, 4, true, -1.0, Interpolation::BILINEAR, neuron_dim);
+    trainer1.enable_statistics(6);
+    trainer2.enable_statistics(6);
+    trainer3.enable_statistics(6);
+
+    // Batch training needs the indices
+    EXPECT_THROW(trainer3(std::vector<DataType>(1, images[0])), pink::exception);
+
+    for (uint32_t iteration = 0; iteration < 2; ++iteration)
+    {
+        for (uint32_t i = 0; i < images.size(); ++i) trainer1(images[i], i);
+
+        // A single thread and a batch of one data point are equal to the sequential training
+        int number_of_threads = omp_get_max_threads();
+        omp_set_num_threads(1);
+        auto iter_cur = images.cbegin();
+        trainer2.train_asynchronous(iter_cur, images.cend());
+        omp_set_num_threads(number_of_threads);
+
+        for (uint32_t i = 0; i < images.size(); ++i) trainer3(std::vector<DataType>(1, images[i]), {i});
+
+        auto&& statistics1 = trainer1.get_statistics().finish_iteration();
+        auto&& statistics2 = trainer2.get_statistics().finish_iteration();
+        auto&& statistics3 = trainer3.get_statistics().finish_iteration();
+
+        EXPECT_EQ(6U, statistics1.number_of_data_points);
+        EXPECT_LT(0.0, statistics1.mean_quantization_error);
+        EXPECT_DOUBLE_EQ(statistics1.mean_quantization_error, statistics2.mean_quantization_error);
+        EXPECT_DOUBLE_EQ(statistics1.best_match_churn, statistics2.best_match_churn);
+        EXPECT_DOUBLE_EQ(statistics1.update_entropy, statistics2.update_entropy);
+        EXPECT_DOUBLE_EQ(statistics1.mean_quantization_error, statistics3.mean_quantization_error);
+        EXPECT_DOUBLE_EQ(statistics1.best_match_churn, statistics3.best_match_churn);
+        EXPECT_DOUBLE_EQ(statistics1.update_entropy, statistics3.update_entropy);
+    }
+}
@@ -55,3 +55,58 @@ TEST(DataIteratorShuffledTest, cartesian_2d_with_header)
     ++iter;
     EXPECT_EQ((DataIteratorShuffled<CartesianLayout<2>, float>(ss, true)), iter);
 }
+
+TEST(DataIteratorShuffledTest, skip)
+{
+    std::vector<std::vector<float>> images{{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}, {13, 14, 15, 16}};
+
+    std::stringstream ss;
+    add_binary_section(ss, images);
+
+    // Reference order of the same seed
+    std::vector<Data<CartesianLayout<2>, float>> expected;
+    for (DataIteratorShuffled<CartesianLayout<2>, float> iter(ss, 42ul), end(ss, true); iter != end; ++iter) {
+        expected.push_back(*iter);
+    }
+    ASSERT_EQ(4UL, expected.size());
+
+    DataIteratorShuffled<CartesianLayout<2>, float> iter(ss, 42ul);
+    iter += 2;
+    EXPECT_EQ(expected[2], *iter);
+    ++iter;
+    EXPECT_EQ(expected[3], *iter);
+
+    // The stream is only rewound at the end
+    ss.seekg(0, ss.beg);
+    DataIteratorShuffled<CartesianLayout<2>, float> iter2(ss, 42ul);
+    iter2 += 4;
+    EXPECT_EQ((DataIteratorShuffled<CartesianLayout<2>, float>(ss, true)), iter2);
+}
+
+TEST(DataIteratorShuffledTest, shards)
+{
+    std::vector<std::vector<float>> images;
+    for (float i = 0; i < 7; ++i) images.push_back({i, i, i, i});
+
+    std::stringstream ss;
+    add_binary_section(ss, images);
+
+    // Reference order without shards
+    std::vector<float> expected;
+    for (DataIteratorShuffled<CartesianLayout<2>, float> iter(ss, 42ul), end(ss, true); iter != end; ++iter) {
+        expected.push_back((*iter)[0]);
+    }
+
+    // The shards are dealt round-robin from the shuffled order
+    std::vector<float> actual(expected.size(), -1.0f);
+    uint32_t number_of_shards = 3;
+    for (uint32_t shard = 0; shard < number_of_shards; ++shard) {
+        size_t j = shard;
+        for (DataIteratorShuffled<CartesianLayout<2>, float> iter(ss, 42ul, true, shard, number_of_shards), end(ss, true);
+            iter != end; ++iter, j += number_of_shards) {
+            ASSERT_LT(j, actual.size());
+            actual[j] = (*iter)[0];
+        }
+    }
+    EXPECT_EQ(expected, actual);
+}
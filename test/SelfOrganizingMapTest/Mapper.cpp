@@ -4,6 +4,7 @@
  * @author Bernd Doser, HITS gGmbH
  */
 
+#include <algorithm>
 #include <cmath>
 #include <gtest/gtest.h>
 #include <limits>
@@ -16,6 +17,7 @@
 #include "SelfOrganizingMapLib/SOMIO.h"
 #include "SelfOrganizingMapLib/Mapper.h"
 #include "UtilitiesLib/DistributionFunctor.h"
+#include "UtilitiesLib/Filler.h"
 
 using namespace pink;
 
@@ -98,3 +100,47 @@ INSTANTIATE_TEST_SUITE_P(MapperTest_all, MapperTest,
         MapperTestData(2, 2, 2, 2,   1, false, 0.0, 0.5, {1.0, 1.0, 1.0, 1.0}),
         MapperTestData(2, 2, 2, 2,   1, false, 0.5, 0.0, {1.0, 1.0, 1.0, 1.0})
 ));
+
+TEST(MapperTest, batch)
+{
+    typedef Data<CartesianLayout<2>, float> DataType;
+    typedef SOM<CartesianLayout<2>, CartesianLayout<2>, float> SOMType;
+    typedef Mapper<CartesianLayout<2>, CartesianLayout<2>, float, false> MapperType;
+
+    uint32_t som_dim = 3;
+    uint32_t neuron_dim = 6;
+    uint32_t som_size = som_dim * som_dim;
+
+    SOMType som({som_dim, som_dim}, {neuron_dim, neuron_dim});
+    fill_random_uniform(som.get_data_pointer(), som.size(), 42);
+
+    std::vector<DataType> batch;
+    for (uint32_t i = 0; i < 7; ++i) {
+        batch.emplace_back(CartesianLayout<2>{9, 9});
+        fill_random_uniform(batch.back().get_data_pointer(), batch.back().size(), 43 + i);
+    }
+
+    int max_threads = omp_get_max_threads();
+    omp_set_num_threads(4);
+
+    for (auto transformation_layout : {TransformationLayout::NEURON_MAJOR, TransformationLayout::PIXEL_MAJOR})
+    {
+        MapperType mapper(som, 0, 8, true, Interpolation::BILINEAR, 4,
+            EuclideanDistanceShape::QUADRATIC, transformation_layout);
+
+        // Same results in the order of the batch as mapping the data points one after another
+        auto [euclidean_distance_matrix, best_rotation_matrix] = mapper(batch);
+        ASSERT_EQ(batch.size() * som_size, euclidean_distance_matrix.size());
+        ASSERT_EQ(batch.size() * som_size, best_rotation_matrix.size());
+
+        for (uint32_t b = 0; b < batch.size(); ++b) {
+            auto [expected_euclidean_distance_matrix, expected_best_rotation_matrix] = mapper(batch[b]);
+            EXPECT_TRUE(std::equal(expected_euclidean_distance_matrix.begin(), expected_euclidean_distance_matrix.end(),
+                euclidean_distance_matrix.begin() + b * som_size));
+            EXPECT_TRUE(std::equal(expected_best_rotation_matrix.begin(), expected_best_rotation_matrix.end(),
+                best_rotation_matrix.begin() + b * som_size));
+        }
+    }
+
+    omp_set_num_threads(max_threads);
+}
@@ -0,0 +1,65 @@
+/**
+ * @file   SelfOrganizingMapTest/MappingWriter.cpp
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "SelfOrganizingMapLib/CartesianLayout.h"
+#include "SelfOrganizingMapLib/MappingWriter.h"
+
+using namespace pink;
+
+namespace {
+
+std::vector<char> read_file(std::string const& filename)
+{
+    std::ifstream ifs(filename, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+}
+
+} // namespace
+
+TEST(MappingWriterTest, shuffled_order)
+{
+    CartesianLayout<2> som_layout{2, 3};
+    uint32_t number_of_data_entries = 4;
+    uint32_t number_of_rotations = 4;
+
+    std::vector<std::vector<float>> distances(number_of_data_entries);
+    std::vector<std::vector<uint32_t>> rotations(number_of_data_entries);
+    for (uint32_t i = 0; i < number_of_data_entries; ++i) {
+        for (uint32_t j = 0; j < som_layout.size(); ++j) {
+            distances[i].push_back(static_cast<float>(10 * i + j));
+            rotations[i].push_back((i + j) % (2 * number_of_rotations));
+        }
+    }
+
+    {
+        MappingWriter<CartesianLayout<2>> sequential("MappingWriterTest_sequential.bin",
+            "MappingWriterTest_sequential_rot_flip.bin", som_layout, number_of_data_entries, number_of_rotations);
+        for (uint32_t i : {0, 1, 2, 3}) sequential(i, distances[i].data(), rotations[i].data());
+
+        MappingWriter<CartesianLayout<2>> shuffled("MappingWriterTest_shuffled.bin",
+            "MappingWriterTest_shuffled_rot_flip.bin", som_layout, number_of_data_entries, number_of_rotations);
+        for (uint32_t i : {2, 0, 3, 1}) shuffled(i, distances[i].data(), rotations[i].data());
+    }
+
+    auto&& sequential = read_file("MappingWriterTest_sequential.bin");
+    auto&& sequential_rot_flip = read_file("MappingWriterTest_sequential_rot_flip.bin");
+
+    // Header of 8 integers and 4 * 6 floats
+    EXPECT_EQ(8 * sizeof(int) + 24 * sizeof(float), sequential.size());
+    EXPECT_EQ(7 * sizeof(int) + 24 * (sizeof(char) + sizeof(float)), sequential_rot_flip.size());
+    EXPECT_EQ(sequential, read_file("MappingWriterTest_shuffled.bin"));
+    EXPECT_EQ(sequential_rot_flip, read_file("MappingWriterTest_shuffled_rot_flip.bin"));
+
+    for (auto&& filename : {"MappingWriterTest_sequential.bin", "MappingWriterTest_sequential_rot_flip.bin",
+        "MappingWriterTest_shuffled.bin", "MappingWriterTest_shuffled_rot_flip.bin"}) std::remove(filename);
+}
@@ -0,0 +1,81 @@
+/**
+ * @file   SelfOrganizingMapTest/ModelParallelTrainer.cpp
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <vector>
+
+#include "SelfOrganizingMapLib/CartesianLayout.h"
+#include "SelfOrganizingMapLib/Data.h"
+#include "SelfOrganizingMapLib/FileIO.h"
+#include "SelfOrganizingMapLib/HexagonalLayout.h"
+#include "SelfOrganizingMapLib/ModelParallelTrainer.h"
+#include "SelfOrganizingMapLib/SOM.h"
+#include "SelfOrganizingMapLib/SOMIO.h"
+#include "SelfOrganizingMapLib/Trainer.h"
+#include "UtilitiesLib/DistributionFunctor.h"
+#include "UtilitiesLib/Filler.h"
+
+using namespace pink;
+
+TEST(ModelParallelTrainerTest, single_process_equals_trainer)
+{
+    typedef Data<CartesianLayout<2>, float> DataType;
+    typedef SOM<HexagonalLayout, CartesianLayout<2>, float> SOMType;
+
+    uint32_t image_dim = 8;
+    uint32_t neuron_dim = 6;
+    SOMType som(HexagonalLayout({5, 5}), {neuron_dim, neuron_dim}, 0.0f);
+    fill_random_uniform(som.get_data_pointer(), som.size(), 42);
+
+    auto&& f = GaussianFunctor(1.1f, 0.2f);
+
+    Trainer<HexagonalLayout, CartesianLayout<2>, float, false> trainer(som, f, 0, 8, true, -1.0,
+        Interpolation::BILINEAR, neuron_dim);
+    ModelParallelTrainer<HexagonalLayout, CartesianLayout<2>, float> model_parallel_trainer(
+        som.get_som_layout(), som.get_neuron_layout(), f, 0, 8, true, -1.0, Interpolation::BILINEAR, neuron_dim);
+    model_parallel_trainer.set_shard(som);
+
+    EXPECT_EQ(0U, model_parallel_trainer.get_begin());
+    EXPECT_EQ(som.get_number_of_neurons(), model_parallel_trainer.get_end());
+
+    for (uint32_t n = 0; n < 10; ++n) {
+        DataType data({image_dim, image_dim});
+        fill_random_uniform(data.get_data_pointer(), data.size(), n);
+        trainer(data);
+        model_parallel_trainer(data);
+    }
+
+    EXPECT_EQ(std::vector<float>(som.get_data().begin(), som.get_data().end()), model_parallel_trainer.get_shard());
+    EXPECT_EQ(trainer.get_update_info(), model_parallel_trainer.get_update_info());
+}
+
+TEST(ModelParallelTrainerTest, initialize_random)
+{
+    InputData input_data;
+    input_data.m_som_width = 4;
+    input_data.m_som_height = 3;
+    input_data.m_som_depth = 1;
+    input_data.m_som_size = 12;
+    input_data.m_neuron_dimension = {5, 5};
+    input_data.m_neuron_dim = 5;
+    input_data.m_neuron_size = 25;
+    input_data.m_seed = 7;
+
+    auto&& f = GaussianFunctor(1.1f, 0.2f);
+
+    for (auto init : {SOMInitialization::ZERO, SOMInitialization::RANDOM,
+        SOMInitialization::RANDOM_WITH_PREFERRED_DIRECTION})
+    {
+        input_data.m_init = init;
+        SOM<CartesianLayout<2>, CartesianLayout<2>, float> som(input_data);
+
+        ModelParallelTrainer<CartesianLayout<2>, CartesianLayout<2>, float> trainer(
+            som.get_som_layout(), som.get_neuron_layout(), f, 0, 1, false, -1.0, Interpolation::BILINEAR, 5);
+        trainer.initialize(input_data);
+        EXPECT_EQ(std::vector<float>(som.get_data().begin(), som.get_data().end()), trainer.get_shard());
+    }
+}
@@ -0,0 +1,145 @@
+/**
+ * @file   SelfOrganizingMapTest/NeighborhoodTable.cpp
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "SelfOrganizingMapLib/CartesianLayout.h"
+#include "SelfOrganizingMapLib/HexagonalLayout.h"
+#include "SelfOrganizingMapLib/NeighborhoodTable.h"
+#include "UtilitiesLib/DistributionFunctor.h"
+
+using namespace pink;
+
+/// Compare with the dense matrix of all neuron pairs
+template <typename SOMLayout>
+void compare_with_dense(SOMLayout const& layout, float max_update_distance)
+{
+    auto&& f = GaussianFunctor(1.1f, 0.2f);
+    NeighborhoodTable<SOMLayout> table(layout, f, max_update_distance);
+
+    auto som_size = static_cast<uint32_t>(layout.size());
+    std::vector<uint32_t> indices;
+    std::vector<float> factors;
+
+    for (uint32_t i = 0; i < som_size; ++i)
+    {
+        std::vector<float> expected(som_size, 0.0f);
+        for (uint32_t j = 0; j < som_size; ++j) {
+            float distance = layout.get_distance(i, j);
+            if (max_update_distance <= 0 or distance < max_update_distance) expected[j] = f(distance);
+            EXPECT_EQ(expected[j], table.get_factor(i, j));
+            EXPECT_EQ(expected[j], table.get_table()[table.get_table_center() + table.get_table_positions()[j]
+                - table.get_table_positions()[i]]);
+        }
+
+        table.get_neighbors(i, indices, factors);
+        std::vector<float> actual(som_size, 0.0f);
+        for (size_t n = 0; n < indices.size(); ++n) {
+            ASSERT_LT(indices[n], som_size);
+            EXPECT_EQ(0.0f, actual[indices[n]]);
+            actual[indices[n]] = factors[n];
+        }
+        EXPECT_EQ(expected, actual);
+    }
+}
+
+TEST(NeighborhoodTableTest, cartesian_1d)
+{
+    compare_with_dense(CartesianLayout<1>{{7}}, -1.0f);
+    compare_with_dense(CartesianLayout<1>{{7}}, 2.0f);
+}
+
+TEST(NeighborhoodTableTest, cartesian_2d)
+{
+    compare_with_dense(CartesianLayout<2>{{5, 5}}, -1.0f);
+    compare_with_dense(CartesianLayout<2>{{5, 5}}, 1.5f);
+    compare_with_dense(CartesianLayout<2>{{4, 6}}, -1.0f);
+}
+
+TEST(NeighborhoodTableTest, cartesian_3d)
+{
+    compare_with_dense(CartesianLayout<3>{{3, 3, 3}}, -1.0f);
+    compare_with_dense(CartesianLayout<3>{{4, 4, 2}}, 2.0f);
+}
+
+TEST(NeighborhoodTableTest, hexagonal)
+{
+    compare_with_dense(HexagonalLayout({5, 5}), -1.0f);
+    compare_with_dense(HexagonalLayout({7, 7}), 2.0f);
+}
+
+TEST(NeighborhoodTableTest, update)
+{
+    HexagonalLayout layout({7, 7});
+    NeighborhoodTable<HexagonalLayout> table(layout, GaussianFunctor(1.1f, 0.2f), -1.0f);
+    NeighborhoodTable<HexagonalLayout> expected(layout, MexicanHatFunctor(0.5f, 0.1f), 2.0f);
+    table.update(MexicanHatFunctor(0.5f, 0.1f), 2.0f);
+
+    std::vector<uint32_t> indices, expected_indices;
+    std::vector<float> factors, expected_factors;
+    for (uint32_t i = 0; i < layout.size(); ++i) {
+        for (uint32_t j = 0; j < layout.size(); ++j) {
+            EXPECT_EQ(expected.get_factor(i, j), table.get_factor(i, j));
+        }
+        table.get_neighbors(i, indices, factors);
+        expected.get_neighbors(i, expected_indices, expected_factors);
+        EXPECT_EQ(expected_indices, indices);
+        EXPECT_EQ(expected_factors, factors);
+    }
+}
+
+TEST(NeighborhoodTableTest, shrinking_distance)
+{
+    CartesianLayout<2> layout{{10, 10}};
+    NeighborhoodTable<CartesianLayout<2>> table(layout, GaussianFunctor(1.1f, 0.2f), -1.0f);
+    EXPECT_EQ(100UL, table.get_max_number_of_neighbors());
+    EXPECT_FLOAT_EQ(std::sqrt(162.0f), table.get_max_distance());
+
+    std::vector<uint32_t> indices;
+    std::vector<float> factors;
+    size_t last = layout.size();
+    for (float max_update_distance : {5.0f, 3.0f, 1.5f, 0.5f}) {
+        table.update(GaussianFunctor(1.1f, 0.2f), max_update_distance);
+        table.get_neighbors(45, indices, factors);
+        EXPECT_LT(indices.size(), last);
+        last = indices.size();
+    }
+    EXPECT_EQ(1UL, last);
+    EXPECT_EQ(45U, indices[0]);
+}
+
+/// Compare the window and the distances with the layout
+template <typename SOMLayout>
+void compare_window(SOMLayout const& layout, float radius)
+{
+    NeighborhoodTable<SOMLayout> table(layout, GaussianFunctor(1.1f, 0.2f), -1.0);
+    table.set_window(radius);
+
+    auto som_size = static_cast<uint32_t>(layout.size());
+    std::vector<uint32_t> indices;
+
+    for (uint32_t i = 0; i < som_size; ++i)
+    {
+        table.get_window(i, indices);
+        std::vector<bool> in_window(som_size, false);
+        for (auto j : indices) in_window[j] = true;
+
+        for (uint32_t j = 0; j < som_size; ++j) {
+            EXPECT_EQ(layout.get_distance(i, j), table.get_distance(i, j));
+            EXPECT_EQ(layout.get_distance(i, j) <= radius, in_window[j]);
+        }
+    }
+}
+
+TEST(NeighborhoodTableTest, window)
+{
+    compare_window(CartesianLayout<1>{{7}}, 2.0f);
+    compare_window(CartesianLayout<2>{{5, 4}}, 1.5f);
+    compare_window(CartesianLayout<3>{{3, 4, 2}}, 1.0f);
+    compare_window(HexagonalLayout({7, 7}), 2.0f);
+}
@@ -0,0 +1,67 @@
+/**
+ * @file   SelfOrganizingMapTest/SnapshotWriter.cpp
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <string>
+
+#include "SelfOrganizingMapLib/CartesianLayout.h"
+#include "SelfOrganizingMapLib/FileIO.h"
+#include "SelfOrganizingMapLib/SnapshotWriter.h"
+#include "SelfOrganizingMapLib/SOM.h"
+#include "UtilitiesLib/Filler.h"
+
+using namespace pink;
+
+namespace {
+
+std::string read_file(std::string const& filename)
+{
+    std::ifstream is(filename, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+}
+
+} // namespace
+
+TEST(SnapshotWriterTest, compare_with_write)
+{
+    typedef SOM<CartesianLayout<2>, CartesianLayout<2>, float> SOMType;
+
+    SOMType som({3, 3}, {4, 4});
+    fill_random_uniform(som.get_data_pointer(), som.size(), 42);
+    write(som, "SnapshotWriterTest_expected.bin");
+
+    {
+        SnapshotWriter<CartesianLayout<2>, CartesianLayout<2>, float> snapshot_writer;
+        snapshot_writer(som, "SnapshotWriterTest_0.bin");
+
+        // The snapshot is a copy, changes of the SOM are not written
+        SOMType som_copy = som;
+        fill_value(som.get_data_pointer(), som.size(), 1.0f);
+        snapshot_writer(som_copy, "SnapshotWriterTest_1.bin");
+        snapshot_writer.wait();
+        EXPECT_LE(0.0, snapshot_writer.get_stall_time());
+    }
+
+    auto expected = read_file("SnapshotWriterTest_expected.bin");
+    EXPECT_FALSE(expected.empty());
+    EXPECT_EQ(expected, read_file("SnapshotWriterTest_0.bin"));
+    EXPECT_EQ(expected, read_file("SnapshotWriterTest_1.bin"));
+
+    std::remove("SnapshotWriterTest_expected.bin");
+    std::remove("SnapshotWriterTest_0.bin");
+    std::remove("SnapshotWriterTest_1.bin");
+}
+
+TEST(SnapshotWriterTest, error)
+{
+    SOM<CartesianLayout<2>, CartesianLayout<2>, float> som({3, 3}, {4, 4}, 0.0f);
+    SnapshotWriter<CartesianLayout<2>, CartesianLayout<2>, float> snapshot_writer;
+    snapshot_writer(som, "not_existing_directory/SnapshotWriterTest.bin");
+    EXPECT_THROW(snapshot_writer.wait(), pink::exception);
+}
@@ -0,0 +1,95 @@
+/**
+ * @file   SelfOrganizingMapTest/SweepTrainer.cpp
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "SelfOrganizingMapLib/CartesianLayout.h"
+#include "SelfOrganizingMapLib/Data.h"
+#include "SelfOrganizingMapLib/SOM.h"
+#include "SelfOrganizingMapLib/SweepTrainer.h"
+#include "SelfOrganizingMapLib/Trainer.h"
+#include "UtilitiesLib/DistributionFunctor.h"
+#include "UtilitiesLib/Filler.h"
+#include "UtilitiesLib/pink_exception.h"
+
+using namespace pink;
+
+class SweepTrainerTest : public ::testing::TestWithParam<TransformationLayout>
+{};
+
+TEST_P(SweepTrainerTest, compare_with_single_trainers)
+{
+    typedef Data<CartesianLayout<2>, float> DataType;
+    typedef SOM<CartesianLayout<2>, CartesianLayout<2>, float> SOMType;
+    typedef Trainer<CartesianLayout<2>, CartesianLayout<2>, float, false> MyTrainer;
+
+    uint32_t neuron_dim = 8;
+    uint32_t number_of_images = 10;
+
+    std::vector<DataType> images;
+    for (uint32_t i = 0; i < number_of_images; ++i) {
+        images.emplace_back(DataType({neuron_dim, neuron_dim}));
+        fill_random_uniform(images.back().get_data_pointer(), images.back().size(), i);
+    }
+
+    std::vector<uint32_t> som_dims{4, 6, 5};
+    std::vector<GaussianFunctor> functors{GaussianFunctor(1.1f, 0.2f), GaussianFunctor(2.0f, 0.1f),
+        GaussianFunctor(0.7f, 0.3f)};
+
+    std::vector<SOMType> soms, sweep_soms;
+    for (size_t n = 0; n < som_dims.size(); ++n) {
+        soms.emplace_back(SOMType({som_dims[n], som_dims[n]}, {neuron_dim, neuron_dim}, 0.0f));
+        fill_random_uniform(soms.back().get_data_pointer(), soms.back().size(), static_cast<uint32_t>(42 + n));
+    }
+    sweep_soms = soms;
+
+    std::vector<MyTrainer> trainers, sweep_trainers;
+    trainers.reserve(soms.size());
+    sweep_trainers.reserve(soms.size());
+    std::vector<MyTrainer*> sweep_trainer_pointers;
+    for (size_t n = 0; n < soms.size(); ++n) {
+        trainers.emplace_back(soms[n], functors[n], 0, 8, true, 2.0, Interpolation::BILINEAR, 6,
+            EuclideanDistanceShape::QUADRATIC, GetParam());
+        sweep_trainers.emplace_back(sweep_soms[n], functors[n], 0, 8, true, 2.0, Interpolation::BILINEAR, 6,
+            EuclideanDistanceShape::QUADRATIC, GetParam());
+        sweep_trainer_pointers.push_back(&sweep_trainers.back());
+    }
+
+    SweepTrainer<CartesianLayout<2>, CartesianLayout<2>, float> sweep_trainer(sweep_trainer_pointers);
+    EXPECT_EQ(3UL, sweep_trainer.get_number_of_trainers());
+
+    for (uint32_t iteration = 0; iteration < 2; ++iteration) {
+        for (uint32_t i = 0; i < number_of_images; ++i) {
+            for (auto&& trainer : trainers) trainer(images[i], i);
+            sweep_trainer(images[i], i);
+        }
+    }
+
+    for (size_t n = 0; n < soms.size(); ++n) {
+        EXPECT_EQ(soms[n], sweep_soms[n]);
+        EXPECT_EQ(trainers[n].get_update_info(), sweep_trainers[n].get_update_info());
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(SweepTrainerTest_all, SweepTrainerTest,
+    ::testing::Values(TransformationLayout::NEURON_MAJOR, TransformationLayout::PIXEL_MAJOR));
+
+TEST(SweepTrainerTest, different_transformations)
+{
+    typedef SOM<CartesianLayout<2>, CartesianLayout<2>, float> SOMType;
+    typedef Trainer<CartesianLayout<2>, CartesianLayout<2>, float, false> MyTrainer;
+
+    SOMType som1({3, 3}, {8, 8}, 0.0f);
+    SOMType som2({3, 3}, {8, 8}, 0.0f);
+
+    auto&& f = GaussianFunctor(1.1f, 0.2f);
+    MyTrainer trainer1(som1, f, 0, 8, true, 2.0, Interpolation::BILINEAR, 6);
+    MyTrainer trainer2(som2, f, 0, 4, true, 2.0, Interpolation::BILINEAR, 6);
+
+    std::vector<MyTrainer*> trainers{&trainer1, &trainer2};
+    EXPECT_THROW((SweepTrainer<CartesianLayout<2>, CartesianLayout<2>, float>(trainers)), pink::exception);
+}
@@ -7,6 +7,7 @@
 #include <cmath>
 #include <gtest/gtest.h>
 #include <limits>
+#include <numeric>
 #include <omp.h>
 
 #include "SelfOrganizingMapLib/CartesianLayout.h"
@@ -16,6 +17,7 @@
 #include "SelfOrganizingMapLib/SOMIO.h"
 #include "SelfOrganizingMapLib/Trainer.h"
 #include "UtilitiesLib/DistributionFunctor.h"
+#include "UtilitiesLib/Filler.h"
 
 using namespace pink;
 
@@ -149,3 +151,197 @@ TEST(SelfOrganizingMapTest, trainer_cartesian_3d_float_244)
     auto actual = som.get_neuron({0, 1});
     EXPECT_EQ(expected, actual);
 }
+
+TEST(SelfOrganizingMapTest, trainer_batch_of_one)
+{
+    typedef Data<CartesianLayout<2>, float> DataType;
+    typedef SOM<CartesianLayout<2>, CartesianLayout<2>, float> SOMType;
+    typedef Trainer<CartesianLayout<2>, CartesianLayout<2>, float, false> MyTrainer;
+
+    uint32_t som_dim = 3;
+    uint32_t image_dim = 8;
+    uint32_t neuron_dim = 8;
+    uint32_t euclidean_distance_dim = 5;
+
+    std::vector<DataType> images;
+    for (uint32_t i = 0; i < 4; ++i) {
+        images.emplace_back(DataType({image_dim, image_dim}));
+        fill_random_uniform(images.back().get_data_pointer(), images.back().size(), i);
+    }
+
+    SOMType som1({som_dim, som_dim}, {neuron_dim, neuron_dim}, 0.0f);
+    fill_random_uniform(som1.get_data_pointer(), som1.size(), 42);
+    SOMType som2 = som1;
+
+    auto&& f = GaussianFunctor(1.1f, 0.2f);
+
+    MyTrainer trainer1(som1, f, 0, 8, true, -1.0, Interpolation::BILINEAR, euclidean_distance_dim);
+    MyTrainer trainer2(som2, f, 0, 8, true, -1.0, Interpolation::BILINEAR, euclidean_distance_dim);
+
+    for (auto&& image : images) {
+        trainer1(image);
+        trainer2(std::vector<DataType>{image});
+    }
+
+    EXPECT_EQ(std::vector<float>(som1.get_data_pointer(), som1.get_data_pointer() + som1.size()),
+              std::vector<float>(som2.get_data_pointer(), som2.get_data_pointer() + som2.size()));
+    EXPECT_EQ(trainer1.get_update_info(), trainer2.get_update_info());
+}
+
+TEST(SelfOrganizingMapTest, trainer_batch_mean)
+{
+    typedef Data<CartesianLayout<2>, float> DataType;
+    typedef SOM<CartesianLayout<2>, CartesianLayout<2>, float> SOMType;
+    typedef Trainer<CartesianLayout<2>, CartesianLayout<2>, float, false> MyTrainer;
+
+    uint32_t som_dim = 1;
+    uint32_t neuron_dim = 2;
+    uint32_t euclidean_distance_dim = 2;
+
+    std::vector<DataType> batch{
+        DataType({neuron_dim, neuron_dim}, std::vector<float>(4, 1.0f)),
+        DataType({neuron_dim, neuron_dim}, std::vector<float>(4, 2.0f)),
+        DataType({neuron_dim, neuron_dim}, std::vector<float>(4, 6.0f))};
+
+    SOMType som({som_dim, som_dim}, {neuron_dim, neuron_dim}, std::vector<float>(4, 0.0));
+
+    // The factor of all data points is one, the neuron becomes the mean of the batch
+    auto&& f = StepFunctor(10.0f);
+
+    MyTrainer trainer(som, f, 0, 1, false, 0.0, Interpolation::BILINEAR, euclidean_distance_dim);
+    trainer(batch);
+
+    DataType expected{{neuron_dim, neuron_dim}, std::vector<float>(4, 3.0f)};
+    EXPECT_EQ(expected, som.get_neuron({0, 0}));
+    EXPECT_EQ(3U, trainer.get_update_info().get_data_pointer()[0]);
+}
+
+TEST(SelfOrganizingMapTest, trainer_asynchronous_single_thread)
+{
+    typedef Data<CartesianLayout<2>, float> DataType;
+    typedef SOM<CartesianLayout<2>, CartesianLayout<2>, float> SOMType;
+    typedef Trainer<CartesianLayout<2>, CartesianLayout<2>, float, false> MyTrainer;
+
+    uint32_t som_dim = 3;
+    uint32_t image_dim = 8;
+    uint32_t neuron_dim = 8;
+    uint32_t euclidean_distance_dim = 5;
+
+    std::vector<DataType> images;
+    for (uint32_t i = 0; i < 6; ++i) {
+        images.emplace_back(DataType({image_dim, image_dim}));
+        fill_random_uniform(images.back().get_data_pointer(), images.back().size(), i);
+    }
+
+    SOMType som1({som_dim, som_dim}, {neuron_dim, neuron_dim}, 0.0f);
+    fill_random_uniform(som1.get_data_pointer(), som1.size(), 42);
+    SOMType som2 = som1;
+
+    auto&& f = GaussianFunctor(1.1f, 0.2f);
+
+    MyTrainer trainer1(som1, f, 0, 8, true, -1.0, Interpolation::BILINEAR, euclidean_distance_dim);
+    MyTrainer trainer2(som2, f, 0, 8, true, -1.0, Interpolation::BILINEAR, euclidean_distance_dim);
+
+    for (auto&& image : images) trainer1(image);
+
+    // With a single thread the asynchronous training is sequential
+    int number_of_threads = omp_get_max_threads();
+    omp_set_num_threads(1);
+    int number_of_callbacks = 0;
+    auto iter_cur = images.cbegin();
+    trainer2.train_asynchronous(iter_cur, images.cend(), [&](){ ++number_of_callbacks; });
+    omp_set_num_threads(number_of_threads);
+
+    EXPECT_EQ(6, number_of_callbacks);
+    EXPECT_EQ(std::vector<float>(som1.get_data_pointer(), som1.get_data_pointer() + som1.size()),
+              std::vector<float>(som2.get_data_pointer(), som2.get_data_pointer() + som2.size()));
+    EXPECT_EQ(trainer1.get_update_info(), trainer2.get_update_info());
+}
+
+TEST(SelfOrganizingMapTest, trainer_asynchronous_multiple_threads)
+{
+    typedef Data<CartesianLayout<2>, float> DataType;
+    typedef SOM<CartesianLayout<2>, CartesianLayout<2>, float> SOMType;
+    typedef Trainer<CartesianLayout<2>, CartesianLayout<2>, float, false> MyTrainer;
+
+    uint32_t som_dim = 4;
+    uint32_t neuron_dim = 8;
+    uint32_t euclidean_distance_dim = 8;
+
+    DataType image({neuron_dim, neuron_dim});
+    fill_random_uniform(image.get_data_pointer(), image.size(), 1);
+    std::vector<DataType> images(100, image);
+
+    SOMType som({som_dim, som_dim}, {neuron_dim, neuron_dim}, 0.0f);
+
+    // All neurons are moved completely to the image, even if updates overlap
+    auto&& f = StepFunctor(10.0f);
+
+    MyTrainer trainer(som, f, 0, 1, false, -1.0, Interpolation::BILINEAR, euclidean_distance_dim);
+
+    int number_of_threads = omp_get_max_threads();
+    omp_set_num_threads(4);
+    auto iter_cur = images.cbegin();
+    trainer.train_asynchronous(iter_cur, images.cend());
+    omp_set_num_threads(number_of_threads);
+
+    EXPECT_TRUE(iter_cur == images.cend());
+
+    auto&& update_info = trainer.get_update_info();
+    EXPECT_EQ(100U, std::accumulate(update_info.get_data_pointer(),
+        update_info.get_data_pointer() + update_info.size(), 0U));
+
+    for (uint32_t i = 0; i < som_dim * som_dim; ++i) {
+        EXPECT_EQ(image, som.get_neuron({i % som_dim, i / som_dim}));
+    }
+}
+
+TEST(SelfOrganizingMapTest, trainer_pipelined)
+{
+    typedef Data<CartesianLayout<2>, float> DataType;
+    typedef SOM<CartesianLayout<2>, CartesianLayout<2>, float> SOMType;
+    typedef Trainer<CartesianLayout<2>, CartesianLayout<2>, float, false> MyTrainer;
+
+    uint32_t som_dim = 5;
+    uint32_t neuron_dim = 8;
+    uint32_t euclidean_distance_dim = 6;
+
+    std::vector<DataType> images;
+    for (uint32_t i = 0; i < 20; ++i) {
+        images.emplace_back(DataType({neuron_dim, neuron_dim}));
+        fill_random_uniform(images.back().get_data_pointer(), images.back().size(), i);
+    }
+
+    auto&& f = GaussianFunctor(1.1f, 0.2f);
+
+    // Without maximum update distance, the whole SOM is updated and nothing is searched in parallel
+    for (auto max_update_distance : {2.0f, -1.0f})
+    for (auto layout : {TransformationLayout::NEURON_MAJOR, TransformationLayout::PIXEL_MAJOR})
+    {
+        SOMType som1({som_dim, som_dim}, {neuron_dim, neuron_dim}, 0.0f);
+        fill_random_uniform(som1.get_data_pointer(), som1.size(), 42);
+        SOMType som2 = som1;
+
+        MyTrainer trainer1(som1, f, 0, 8, true, max_update_distance, Interpolation::BILINEAR, euclidean_distance_dim,
+            EuclideanDistanceShape::QUADRATIC, layout);
+        MyTrainer trainer2(som2, f, 0, 8, true, max_update_distance, Interpolation::BILINEAR, euclidean_distance_dim,
+            EuclideanDistanceShape::QUADRATIC, layout);
+
+        for (auto&& image : images) trainer1(image);
+
+        // The updated neurons are searched after the update, so that the result is sequential
+        int number_of_threads = omp_get_max_threads();
+        int max_active_levels = omp_get_max_active_levels();
+        omp_set_num_threads(3);
+        int number_of_callbacks = 0;
+        auto iter_cur = images.cbegin();
+        trainer2.train_pipelined(iter_cur, images.cend(), [&](){ ++number_of_callbacks; });
+        omp_set_num_threads(number_of_threads);
+
+        EXPECT_EQ(max_active_levels, omp_get_max_active_levels());
+        EXPECT_TRUE(iter_cur == images.cend());
+        EXPECT_EQ(20, number_of_callbacks);
+        EXPECT_EQ(som1, som2);
+        EXPECT_EQ(trainer1.get_update_info(), trainer2.get_update_info());
+    }
+}
@@ -0,0 +1,104 @@
+/**
+ * @file   SelfOrganizingMapTest/TransformCache.cpp
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "SelfOrganizingMapLib/CartesianLayout.h"
+#include "SelfOrganizingMapLib/Data.h"
+#include "SelfOrganizingMapLib/SOM.h"
+#include "SelfOrganizingMapLib/Trainer.h"
+#include "SelfOrganizingMapLib/TransformCache.h"
+#include "UtilitiesLib/DistributionFunctor.h"
+#include "UtilitiesLib/Filler.h"
+
+using namespace pink;
+
+TEST(TransformCacheTest, get_and_set)
+{
+    // Budget for two data points
+    TransformCache<float> cache(3, 4, 2 * 4 * sizeof(float) + 1);
+    EXPECT_EQ(2 * 4 * sizeof(float), cache.get_memory_size());
+
+    std::vector<float> images;
+    EXPECT_FALSE(cache.get(1, images));
+
+    EXPECT_TRUE(cache.set(1, {1, 2, 3, 4}));
+    EXPECT_TRUE(cache.set(2, {5, 6, 7, 8}));
+    EXPECT_FALSE(cache.set(0, {9, 9, 9, 9}));
+    EXPECT_EQ(2U, cache.get_number_of_cached_data_points());
+
+    EXPECT_TRUE(cache.get(1, images));
+    EXPECT_EQ((std::vector<float>{1, 2, 3, 4}), images);
+    EXPECT_TRUE(cache.get(2, images));
+    EXPECT_EQ((std::vector<float>{5, 6, 7, 8}), images);
+    EXPECT_FALSE(cache.get(0, images));
+
+    EXPECT_THROW(cache.get(3, images), pink::exception);
+    EXPECT_THROW(cache.set(0, {1, 2}), pink::exception);
+
+    cache.count(true);
+    cache.count(false);
+    EXPECT_DOUBLE_EQ(0.5, cache.get_hit_rate());
+    cache.reset_counters();
+    EXPECT_DOUBLE_EQ(0.0, cache.get_hit_rate());
+}
+
+class TransformCacheTrainerTest : public ::testing::TestWithParam<TransformationLayout>
+{};
+
+TEST_P(TransformCacheTrainerTest, equal_to_recalculation)
+{
+    typedef Data<CartesianLayout<2>, float> DataType;
+    typedef SOM<CartesianLayout<2>, CartesianLayout<2>, float> SOMType;
+    typedef Trainer<CartesianLayout<2>, CartesianLayout<2>, float, false> MyTrainer;
+
+    uint32_t som_dim = 5;
+    uint32_t neuron_dim = 8;
+    uint32_t number_of_images = 10;
+    uint32_t number_of_rotations = 8;
+
+    std::vector<DataType> images;
+    for (uint32_t i = 0; i < number_of_images; ++i) {
+        images.emplace_back(DataType({neuron_dim, neuron_dim}));
+        fill_random_uniform(images.back().get_data_pointer(), images.back().size(), i);
+    }
+
+    SOMType som1({som_dim, som_dim}, {neuron_dim, neuron_dim}, 0.0f);
+    fill_random_uniform(som1.get_data_pointer(), som1.size(), 42);
+    SOMType som2 = som1;
+
+    auto&& f = GaussianFunctor(1.1f, 0.2f);
+    MyTrainer trainer1(som1, f, 0, number_of_rotations, true, 2.0, Interpolation::BILINEAR, 6,
+        EuclideanDistanceShape::QUADRATIC, GetParam());
+    MyTrainer trainer2(som2, f, 0, number_of_rotations, true, 2.0, Interpolation::BILINEAR, 6,
+        EuclideanDistanceShape::QUADRATIC, GetParam());
+
+    // Only half of the data points fit into the cache
+    size_t images_bytes = 2 * number_of_rotations * neuron_dim * neuron_dim * sizeof(float);
+    trainer2.enable_transform_cache(number_of_images, number_of_images / 2 * images_bytes);
+    EXPECT_TRUE(trainer2.has_transform_cache());
+
+    for (uint32_t iteration = 0; iteration < 3; ++iteration)
+    {
+        for (uint32_t i = 0; i < number_of_images; ++i) {
+            trainer1(images[i], i);
+            trainer2(images[i], i);
+        }
+        EXPECT_EQ(som1, som2);
+
+        auto&& cache = trainer2.get_transform_cache();
+        EXPECT_EQ(number_of_images / 2, cache.get_number_of_cached_data_points());
+        EXPECT_DOUBLE_EQ(iteration == 0 ? 0.0 : 0.5, cache.get_hit_rate());
+        cache.reset_counters();
+    }
+
+    // Mini-batches need the indices of the data points
+    EXPECT_THROW(trainer2(images, {}), pink::exception);
+}
+
+INSTANTIATE_TEST_SUITE_P(TransformCacheTrainerTest_all, TransformCacheTrainerTest,
+    ::testing::Values(TransformationLayout::NEURON_MAJOR, TransformationLayout::PIXEL_MAJOR));
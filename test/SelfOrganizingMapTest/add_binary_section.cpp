@@ -11,7 +11,7 @@ void add_binary_section(std::stringstream& ss, std::vector<std::vector<float>> c
     int version = 2;
     int binary_file_type = 0;
     int data_type = 0;
-    int number_of_data_entries = 2;
+    int number_of_data_entries = static_cast<int>(images.size());
     int layout = 0;
     int dimensionality = 2;
     int width = 2;
@@ -25,8 +25,8 @@ void add_binary_section(std::stringstream& ss, std::vector<std::vector<float>> c
     ss.write(reinterpret_cast<const char*>(&dimensionality), sizeof(int));
     ss.write(reinterpret_cast<const char*>(&width), sizeof(int));
     ss.write(reinterpret_cast<const char*>(&height), sizeof(int));
-    ss.write(reinterpret_cast<const char*>(&images[0][0]),
-        static_cast<std::streamsize>(static_cast<size_t>(width * height) * sizeof(float)));
-    ss.write(reinterpret_cast<const char*>(&images[1][0]),
-        static_cast<std::streamsize>(static_cast<size_t>(width * height) * sizeof(float)));
+    for (auto&& image : images) {
+        ss.write(reinterpret_cast<const char*>(&image[0]),
+            static_cast<std::streamsize>(static_cast<size_t>(width * height) * sizeof(float)));
+    }
 }
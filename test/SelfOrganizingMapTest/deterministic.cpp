@@ -0,0 +1,137 @@
+/**
+ * @file   SelfOrganizingMapTest/deterministic.cpp
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <omp.h>
+#include <tuple>
+#include <vector>
+
+#include "SelfOrganizingMapLib/CartesianLayout.h"
+#include "SelfOrganizingMapLib/Data.h"
+#include "SelfOrganizingMapLib/Mapper.h"
+#include "SelfOrganizingMapLib/SOM.h"
+#include "SelfOrganizingMapLib/Trainer.h"
+#include "UtilitiesLib/DistributionFunctor.h"
+#include "UtilitiesLib/Filler.h"
+
+using namespace pink;
+
+namespace {
+
+typedef Data<CartesianLayout<2>, float> DataType;
+typedef SOM<CartesianLayout<2>, CartesianLayout<2>, float> SOMType;
+typedef Trainer<CartesianLayout<2>, CartesianLayout<2>, float, false> TrainerType;
+typedef Mapper<CartesianLayout<2>, CartesianLayout<2>, float, false> MapperType;
+
+enum class Mode { SEQUENTIAL, MINI_BATCH, PIPELINED, TWO_PHASE_SEARCH };
+
+/// Trained SOM, update counters and mapping of all images as raw bytes
+struct Result
+{
+    std::vector<char> som;
+    std::vector<char> update_info;
+    std::vector<char> euclidean_distances;
+    std::vector<char> best_rotations;
+};
+
+template <typename V>
+std::vector<char> get_bytes(V const* ptr, size_t size)
+{
+    std::vector<char> bytes(size * sizeof(V));
+    std::memcpy(bytes.data(), ptr, bytes.size());
+    return bytes;
+}
+
+/// Random images and images with rotation symmetry, whose distances are equal for several rotations
+std::vector<DataType> get_images()
+{
+    uint32_t dim = 12;
+    std::vector<DataType> images;
+    for (uint32_t i = 0; i < 24; ++i) {
+        images.emplace_back(DataType({dim, dim}));
+        auto&& image = images.back();
+        if (i % 3 == 0) {
+            for (uint32_t y = 0; y < dim; ++y) {
+                for (uint32_t x = 0; x < dim; ++x) {
+                    auto r = std::max(std::abs(2.0f * x - dim + 1), std::abs(2.0f * y - dim + 1));
+                    image[y * dim + x] = r < static_cast<float>(i % 7 + 2) ? 1.0f : 0.0f;
+                }
+            }
+        } else {
+            fill_random_uniform(image.get_data_pointer(), image.size(), i);
+        }
+    }
+    return images;
+}
+
+Result train_and_map(Mode mode, TransformationLayout layout, int number_of_threads)
+{
+    auto images = get_images();
+    uint32_t som_dim = 4;
+    uint32_t neuron_dim = 8;
+
+    int max_threads = omp_get_max_threads();
+    omp_set_num_threads(number_of_threads);
+
+    SOMType som({som_dim, som_dim}, {neuron_dim, neuron_dim});
+    fill_random_uniform(som.get_data_pointer(), som.size(), 42);
+
+    TrainerType trainer(som, GaussianFunctor(1.1f, 0.2f), 0, 8, true, 2.0, Interpolation::BILINEAR, 6,
+        EuclideanDistanceShape::QUADRATIC, layout);
+    if (mode == Mode::TWO_PHASE_SEARCH) trainer.enable_two_phase_search();
+
+    for (uint32_t iteration = 0; iteration < 2; ++iteration) {
+        if (mode == Mode::MINI_BATCH) {
+            for (size_t b = 0; b < images.size(); b += 5) {
+                trainer(std::vector<DataType>(images.begin() + static_cast<long>(b),
+                    images.begin() + static_cast<long>(std::min(b + 5, images.size()))));
+            }
+        } else if (mode == Mode::PIPELINED) {
+            auto iter_cur = images.cbegin();
+            trainer.train_pipelined(iter_cur, images.cend());
+        } else {
+            for (auto&& image : images) trainer(image);
+        }
+    }
+
+    MapperType mapper(som, 0, 8, true, Interpolation::BILINEAR, 6, EuclideanDistanceShape::QUADRATIC, layout);
+    auto [euclidean_distance_matrix, best_rotation_matrix] = mapper(images);
+
+    omp_set_num_threads(max_threads);
+
+    auto update_info = trainer.get_update_info();
+    return Result{get_bytes(som.get_data_pointer(), som.size()),
+                  get_bytes(update_info.get_data_pointer(), update_info.size()),
+                  get_bytes(euclidean_distance_matrix.data(), euclidean_distance_matrix.size()),
+                  get_bytes(best_rotation_matrix.data(), best_rotation_matrix.size())};
+}
+
+} // end anonymous namespace
+
+class DeterministicTest : public ::testing::TestWithParam<std::tuple<Mode, TransformationLayout>>
+{};
+
+TEST_P(DeterministicTest, independent_of_number_of_threads)
+{
+    auto [mode, layout] = GetParam();
+
+    auto single = train_and_map(mode, layout, 1);
+    auto multiple = train_and_map(mode, layout, 4);
+
+    EXPECT_TRUE(single.som == multiple.som);
+    EXPECT_TRUE(single.update_info == multiple.update_info);
+    EXPECT_TRUE(single.euclidean_distances == multiple.euclidean_distances);
+    EXPECT_TRUE(single.best_rotations == multiple.best_rotations);
+}
+
+INSTANTIATE_TEST_SUITE_P(DeterministicTest_all, DeterministicTest,
+    ::testing::Combine(
+        ::testing::Values(Mode::SEQUENTIAL, Mode::MINI_BATCH, Mode::PIPELINED, Mode::TWO_PHASE_SEARCH),
+        ::testing::Values(TransformationLayout::NEURON_MAJOR, TransformationLayout::PIXEL_MAJOR)
+));
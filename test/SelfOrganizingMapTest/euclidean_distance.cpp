@@ -6,10 +6,13 @@
 
 #include <cmath>
 #include <gtest/gtest.h>
+#include <omp.h>
+#include <vector>
 
 #include "ImageProcessingLib/circular_euclidean_distance.h"
 #include "ImageProcessingLib/euclidean_distance.h"
 #include "SelfOrganizingMapLib/CartesianLayout.h"
+#include "SelfOrganizingMapLib/generate_euclidean_distance_matrix.h"
 
 using namespace pink;
 
@@ -87,3 +90,32 @@ TEST(EuclideanDistanceTest, circular_euclidean_distance_cartesian_2d)
     /// Do you know the number? Isn't it beautiful?
     EXPECT_EQ(31428, dot);
 }
+
+TEST(EuclideanDistanceTest, generate_euclidean_distance_matrix_ties)
+{
+    CartesianLayout<2> layout{2, 2};
+    uint32_t som_size = 3;
+    uint32_t num_rot = 8;
+
+    std::vector<float> som{0, 0, 0, 0,  1, 1, 1, 1,  2, 0, 0, 2};
+
+    // Rotations 2, 5 and 7 are equal, rotations 3 and 6 as well
+    std::vector<float> rotated_images(num_rot * layout.size(), 5.0f);
+    for (uint32_t j : {2, 5, 7}) std::fill_n(&rotated_images[j * layout.size()], layout.size(), 1.0f);
+    for (uint32_t j : {3, 6}) std::fill_n(&rotated_images[j * layout.size()], layout.size(), 0.5f);
+
+    int max_threads = omp_get_max_threads();
+    for (int number_of_threads : {1, 2, 3, 8})
+    {
+        omp_set_num_threads(number_of_threads);
+        std::vector<float> euclidean_distance_matrix(som_size);
+        std::vector<uint32_t> best_rotation_matrix(som_size);
+        generate_euclidean_distance_matrix(euclidean_distance_matrix, best_rotation_matrix, som_size, som.data(),
+            layout, num_rot, rotated_images, 2, EuclideanDistanceShape::QUADRATIC);
+
+        // Equal distances are resolved to the lowest rotation
+        EXPECT_EQ((std::vector<uint32_t>{3, 2, 2}), best_rotation_matrix);
+        EXPECT_EQ((std::vector<float>{1.0f, 0.0f, 4.0f}), euclidean_distance_matrix);
+    }
+    omp_set_num_threads(max_threads);
+}
@@ -0,0 +1,142 @@
+/**
+ * @file   SelfOrganizingMapTest/find_best_match_pruned.cpp
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "SelfOrganizingMapLib/CartesianLayout.h"
+#include "SelfOrganizingMapLib/Data.h"
+#include "SelfOrganizingMapLib/find_best_match.h"
+#include "SelfOrganizingMapLib/find_best_match_pruned.h"
+#include "SelfOrganizingMapLib/generate_euclidean_distance_matrix.h"
+#include "SelfOrganizingMapLib/SOM.h"
+#include "SelfOrganizingMapLib/Trainer.h"
+#include "UtilitiesLib/DistributionFunctor.h"
+#include "UtilitiesLib/Filler.h"
+
+using namespace pink;
+
+TEST(FindBestMatchPrunedTest, compare_with_full_search)
+{
+    CartesianLayout<2> neuron_layout{10, 10};
+    uint32_t neuron_size = neuron_layout.size();
+    uint32_t som_size = 25;
+    uint32_t number_of_spatial_transformations = 13;
+    uint32_t euclidean_distance_dim = 8;
+
+    std::vector<float> som(som_size * neuron_size);
+    fill_random_uniform(som.data(), som.size(), 42);
+    std::vector<float> images(number_of_spatial_transformations * neuron_size);
+    fill_random_uniform(images.data(), images.size(), 43);
+
+    for (auto shape : {EuclideanDistanceShape::QUADRATIC, EuclideanDistanceShape::CIRCULAR})
+    {
+        std::vector<float> euclidean_distance_matrix(som_size);
+        std::vector<uint32_t> best_rotation_matrix(som_size);
+        generate_euclidean_distance_matrix(euclidean_distance_matrix, best_rotation_matrix, som_size, som.data(),
+            neuron_layout, number_of_spatial_transformations, images, euclidean_distance_dim, shape);
+        auto expected = find_best_match(euclidean_distance_matrix, som_size);
+
+        auto region = get_euclidean_distance_region(neuron_layout, euclidean_distance_dim, shape);
+        std::vector<float> interleaved_images;
+        interleave_spatial_transformed_images(interleaved_images, images, number_of_spatial_transformations,
+            neuron_size, region);
+
+        float min_distance = 0.0f;
+        uint32_t best_rotation = 0;
+        EXPECT_EQ(expected, find_best_match_pruned(min_distance, best_rotation, som_size, som.data(), neuron_size,
+            number_of_spatial_transformations, images, region));
+        EXPECT_EQ(euclidean_distance_matrix[expected], min_distance);
+        EXPECT_EQ(best_rotation_matrix[expected], best_rotation);
+
+        EXPECT_EQ(expected, find_best_match_pruned_pixel_major(min_distance, best_rotation, som_size, som.data(),
+            neuron_size, number_of_spatial_transformations, interleaved_images, region));
+        EXPECT_FLOAT_EQ(euclidean_distance_matrix[expected], min_distance);
+        EXPECT_EQ(best_rotation_matrix[expected], best_rotation);
+
+        // The warm start does not change the best rotations
+        std::vector<uint32_t> neuron_indices{3, 7, 8, 24};
+        for (uint32_t start_rotation : {0U, 5U, 12U})
+        {
+            std::vector<float> distances(som_size, -1.0f);
+            std::vector<uint32_t> rotations(som_size, 99);
+            generate_best_rotations(distances, rotations, neuron_indices, som.data(), neuron_size,
+                number_of_spatial_transformations, images, region, start_rotation);
+
+            std::vector<float> distances_pixel_major(som_size, -1.0f);
+            std::vector<uint32_t> rotations_pixel_major(som_size, 99);
+            generate_best_rotations_pixel_major(distances_pixel_major, rotations_pixel_major, neuron_indices,
+                som.data(), neuron_size, number_of_spatial_transformations, interleaved_images, region, start_rotation);
+
+            for (auto i : neuron_indices) {
+                EXPECT_EQ(euclidean_distance_matrix[i], distances[i]);
+                EXPECT_EQ(best_rotation_matrix[i], rotations[i]);
+                EXPECT_FLOAT_EQ(euclidean_distance_matrix[i], distances_pixel_major[i]);
+                EXPECT_EQ(best_rotation_matrix[i], rotations_pixel_major[i]);
+            }
+            EXPECT_EQ(99U, rotations[0]);
+            EXPECT_EQ(99U, rotations_pixel_major[0]);
+        }
+    }
+}
+
+class TwoPhaseSearchTest : public ::testing::TestWithParam<TransformationLayout>
+{};
+
+TEST_P(TwoPhaseSearchTest, trainer)
+{
+    typedef Data<CartesianLayout<2>, float> DataType;
+    typedef SOM<CartesianLayout<2>, CartesianLayout<2>, float> SOMType;
+    typedef Trainer<CartesianLayout<2>, CartesianLayout<2>, float, false> MyTrainer;
+
+    uint32_t som_dim = 6;
+    uint32_t neuron_dim = 8;
+    uint32_t number_of_images = 10;
+
+    std::vector<DataType> images;
+    for (uint32_t i = 0; i < number_of_images; ++i) {
+        images.emplace_back(DataType({neuron_dim, neuron_dim}));
+        fill_random_uniform(images.back().get_data_pointer(), images.back().size(), i);
+    }
+
+    SOMType som1({som_dim, som_dim}, {neuron_dim, neuron_dim}, 0.0f);
+    fill_random_uniform(som1.get_data_pointer(), som1.size(), 42);
+    SOMType som2 = som1;
+    SOMType som3 = som1;
+    SOMType som4 = som1;
+
+    auto&& f = GaussianFunctor(1.1f, 0.2f);
+
+    MyTrainer trainer1(som1, f, 0, 8, true, 2.0, Interpolation::BILINEAR, 6,
+        EuclideanDistanceShape::QUADRATIC, GetParam());
+    MyTrainer trainer2(som2, f, 0, 8, true, 2.0, Interpolation::BILINEAR, 6,
+        EuclideanDistanceShape::QUADRATIC, GetParam());
+    MyTrainer trainer3(som3, f, 0, 8, true, 2.0, Interpolation::BILINEAR, 6,
+        EuclideanDistanceShape::QUADRATIC, GetParam());
+    MyTrainer trainer4(som4, f, 0, 8, true, 2.0, Interpolation::BILINEAR, 6,
+        EuclideanDistanceShape::QUADRATIC, GetParam());
+
+    trainer2.enable_two_phase_search();
+    trainer4.enable_two_phase_search();
+    EXPECT_TRUE(trainer2.has_two_phase_search());
+    EXPECT_FALSE(trainer1.has_two_phase_search());
+
+    for (uint32_t iteration = 0; iteration < 2; ++iteration)
+    {
+        for (uint32_t i = 0; i < number_of_images; ++i) {
+            trainer1(images[i], i);
+            trainer2(images[i], i);
+        }
+        trainer3(images, {});
+        trainer4(images, {});
+
+        EXPECT_EQ(som1, som2);
+        EXPECT_EQ(som3, som4);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(TwoPhaseSearchTest_all, TwoPhaseSearchTest,
+    ::testing::Values(TransformationLayout::NEURON_MAJOR, TransformationLayout::PIXEL_MAJOR));
@@ -39,3 +39,34 @@ TEST(SelfOrganizingMapTest, generate_rotated_images_3d)
 
     EXPECT_EQ((std::vector<int>{{1, 2, 3, 4, 5, 6, 7, 8, 3, 1, 4, 2, 7, 5, 8, 6, 4, 3, 2, 1, 8, 7, 6, 5, 2, 4, 1, 3, 6, 8, 5, 7}}), spatial_transformed_images);
 }
+
+TEST(SelfOrganizingMapTest, generate_rotated_images_3d_compare_with_2d)
+{
+    uint32_t depth = 3;
+    uint32_t image_dim = 6;
+    uint32_t image_size = image_dim * image_dim;
+    uint32_t neuron_dim = 8;
+    uint32_t neuron_size = neuron_dim * neuron_dim;
+    uint32_t number_of_rotations = 12;
+    bool use_flip = true;
+    Interpolation interpolation = Interpolation::BILINEAR;
+
+    std::vector<float> raw_data(depth * image_size);
+    for (uint32_t i = 0; i < raw_data.size(); ++i) raw_data[i] = static_cast<float>(i % 7);
+
+    Data<CartesianLayout<3>, float> data{{depth, image_dim, image_dim}, raw_data};
+    auto&& actual = SpatialTransformer<CartesianLayout<3>>()(data, number_of_rotations,
+        use_flip, interpolation, CartesianLayout<3>{depth, neuron_dim, neuron_dim});
+
+    for (uint32_t d = 0; d < depth; ++d) {
+        Data<CartesianLayout<2>, float> channel{{image_dim, image_dim}, std::vector<float>(
+            raw_data.begin() + d * image_size, raw_data.begin() + (d + 1) * image_size)};
+        auto&& expected = SpatialTransformer<CartesianLayout<2>>()(channel, number_of_rotations,
+            use_flip, interpolation, CartesianLayout<2>{neuron_dim, neuron_dim});
+
+        for (uint32_t t = 0; t < 2 * number_of_rotations; ++t) {
+            EXPECT_TRUE(std::equal(&expected[t * neuron_size], &expected[(t + 1) * neuron_size],
+                &actual[(t * depth + d) * neuron_size])) << "transformation " << t << " channel " << d;
+        }
+    }
+}
@@ -7,9 +7,21 @@
 #include <omp.h>
 #include <gtest/gtest.h>
 
+#ifdef PINK_USE_MPI
+    #include <mpi.h>
+#endif
+
 int main(int argc, char **argv)
 {
+#ifdef PINK_USE_MPI
+    // The model-parallel trainer runs as single process
+    MPI_Init(&argc, &argv);
+#endif
     omp_set_num_threads(1);
     ::testing::InitGoogleTest(&argc, argv);
-    return RUN_ALL_TESTS();
+    auto result = RUN_ALL_TESTS();
+#ifdef PINK_USE_MPI
+    MPI_Finalize();
+#endif
+    return result;
 }
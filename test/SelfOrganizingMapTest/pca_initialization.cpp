@@ -0,0 +1,139 @@
+/**
+ * @file   SelfOrganizingMapTest/pca_initialization.cpp
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "SelfOrganizingMapLib/CartesianLayout.h"
+#include "SelfOrganizingMapLib/HexagonalLayout.h"
+#include "SelfOrganizingMapLib/pca_initialization.h"
+#include "SelfOrganizingMapLib/SOM.h"
+
+using namespace pink;
+
+namespace {
+
+uint32_t dim = 4;
+uint32_t size = dim * dim;
+uint32_t number_of_data_entries = 600;
+
+/// Data points with standard deviation 3 along the first and 1 along the second axis
+/// and small noise in all other directions
+std::stringstream get_data(std::vector<double>& mean, std::vector<double>& u, std::vector<double>& v)
+{
+    mean.resize(size);
+    for (uint32_t i = 0; i < size; ++i) mean[i] = 0.1 * i;
+    u.assign(size, 0.0);
+    u[5] = 1.0;
+    v.assign(size, 0.0);
+    v[0] = v[1] = std::sqrt(0.5);
+
+    std::stringstream ss;
+    int header[] = {2, 0, 0, static_cast<int>(number_of_data_entries), 0, 2,
+        static_cast<int>(dim), static_cast<int>(dim)};
+    ss.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+    std::mt19937 rng(1234);
+    std::normal_distribution<double> dist;
+    std::vector<float> image(size);
+    for (uint32_t n = 0; n < number_of_data_entries; ++n) {
+        auto a = 3.0 * dist(rng);
+        auto b = dist(rng);
+        for (uint32_t i = 0; i < size; ++i) image[i] = static_cast<float>(mean[i] + a * u[i] + b * v[i] + 0.01 * dist(rng));
+        ss.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(size * sizeof(float)));
+    }
+    return ss;
+}
+
+double dot(double const *a, std::vector<double> const& b)
+{
+    double result = 0.0;
+    for (uint32_t i = 0; i < size; ++i) result += a[i] * b[i];
+    return result;
+}
+
+} // end anonymous namespace
+
+TEST(PCAInitializationTest, principal_components)
+{
+    std::vector<double> mean, u, v;
+    auto ss = get_data(mean, u, v);
+
+    auto pca = get_principal_components<CartesianLayout<2>, float>(ss, CartesianLayout<2>{dim, dim}, 2, 42);
+
+    ASSERT_EQ(size, pca.mean.size());
+    ASSERT_EQ(2 * size, pca.components.size());
+    ASSERT_EQ(2UL, pca.variances.size());
+
+    for (uint32_t i = 0; i < size; ++i) EXPECT_NEAR(mean[i], pca.mean[i], 0.2);
+    EXPECT_NEAR(1.0, std::abs(dot(&pca.components[0], u)), 1e-3);
+    EXPECT_NEAR(1.0, std::abs(dot(&pca.components[size], v)), 1e-3);
+    EXPECT_NEAR(0.0, dot(&pca.components[0], std::vector<double>(pca.components.begin() + size, pca.components.end())), 1e-9);
+    EXPECT_NEAR(9.0, pca.variances[0], 1.0);
+    EXPECT_NEAR(1.0, pca.variances[1], 0.15);
+
+    // The stream is rewound and the result is reproducible
+    auto pca2 = get_principal_components<CartesianLayout<2>, float>(ss, CartesianLayout<2>{dim, dim}, 2, 42);
+    EXPECT_EQ(pca.components, pca2.components);
+}
+
+TEST(PCAInitializationTest, cartesian)
+{
+    std::vector<double> mean, u, v;
+    auto ss = get_data(mean, u, v);
+    auto pca = get_principal_components<CartesianLayout<2>, float>(ss, CartesianLayout<2>{dim, dim}, 2, 42);
+
+    SOM<CartesianLayout<2>, CartesianLayout<2>, float> som({5, 3}, {dim, dim});
+    initialize_by_pca<CartesianLayout<2>>(som.get_data_pointer(), ss, som.get_som_layout(), som.get_neuron_layout(),
+        0, 15, 42);
+
+    // The center neuron is the mean, the longer axis of the positions spans the first component
+    auto neuron = [&](uint32_t x, uint32_t y) {
+        std::vector<double> result(size);
+        for (uint32_t n = 0; n < 15; ++n) {
+            auto position = som.get_som_layout().get_position(n);
+            if (position[0] != x or position[1] != y) continue;
+            for (uint32_t i = 0; i < size; ++i) result[i] = som.get_data_pointer()[n * size + i];
+        }
+        return result;
+    };
+
+    auto center = neuron(1, 2);
+    for (uint32_t i = 0; i < size; ++i) EXPECT_NEAR(pca.mean[i], center[i], 1e-5);
+
+    auto right = neuron(1, 4);
+    auto top = neuron(2, 2);
+    for (uint32_t i = 0; i < size; ++i) {
+        EXPECT_NEAR(std::sqrt(pca.variances[0]) * pca.components[i], right[i] - center[i], 1e-5);
+        EXPECT_NEAR(std::sqrt(pca.variances[1]) * pca.components[size + i], top[i] - center[i], 1e-5);
+    }
+}
+
+TEST(PCAInitializationTest, hexagonal)
+{
+    std::vector<double> mean, u, v;
+    auto ss = get_data(mean, u, v);
+    auto pca = get_principal_components<CartesianLayout<2>, float>(ss, CartesianLayout<2>{dim, dim}, 2, 42);
+
+    HexagonalLayout som_layout({5, 5});
+    std::vector<float> som(som_layout.size() * size);
+
+    // Only the neurons [4, 14) are initialized, like a shard of the model-parallel trainer
+    initialize_by_pca<CartesianLayout<2>>(som.data() + 4 * size, ss, som_layout, CartesianLayout<2>{dim, dim},
+        4, 14, 42);
+
+    // Neuron 9 is the center, neuron 11 the right end of the center row
+    EXPECT_EQ(9U, som_layout.get_index({2, 2}));
+    for (uint32_t i = 0; i < size; ++i) {
+        EXPECT_NEAR(pca.mean[i], som[9 * size + i], 1e-5);
+        EXPECT_NEAR(std::sqrt(pca.variances[0]) * pca.components[i], som[11 * size + i] - som[9 * size + i], 1e-5);
+        EXPECT_EQ(0.0f, som[i]);
+        EXPECT_EQ(0.0f, som[14 * size + i]);
+    }
+}
@@ -0,0 +1,94 @@
+/**
+ * @file   SelfOrganizingMapTest/pixel_major.cpp
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "SelfOrganizingMapLib/CartesianLayout.h"
+#include "SelfOrganizingMapLib/Data.h"
+#include "SelfOrganizingMapLib/Mapper.h"
+#include "SelfOrganizingMapLib/SOM.h"
+#include "UtilitiesLib/expect_floats_nearly_eq.h"
+#include "UtilitiesLib/Filler.h"
+
+using namespace pink;
+
+struct PixelMajorTestData
+{
+    PixelMajorTestData(uint32_t depth, uint32_t num_rot, bool flip, EuclideanDistanceShape shape)
+      : depth(depth),
+        num_rot(num_rot),
+        flip(flip),
+        shape(shape)
+    {}
+
+    uint32_t depth;
+    uint32_t num_rot;
+    bool flip;
+    EuclideanDistanceShape shape;
+};
+
+class PixelMajorTest : public ::testing::TestWithParam<PixelMajorTestData>
+{};
+
+TEST_P(PixelMajorTest, compare_with_neuron_major)
+{
+    typedef Data<CartesianLayout<3>, float> DataType;
+    typedef SOM<CartesianLayout<2>, CartesianLayout<3>, float> SOMType;
+    typedef Mapper<CartesianLayout<2>, CartesianLayout<3>, float, false> MapperType;
+
+    auto param = GetParam();
+    uint32_t som_dim = 3;
+    uint32_t image_dim = 12;
+    uint32_t neuron_dim = 17;
+    uint32_t euclidean_distance_dim = 8;
+
+    DataType image({param.depth, image_dim, image_dim});
+    fill_random_uniform(image.get_data_pointer(), image.size(), 42);
+
+    SOMType som({som_dim, som_dim}, {param.depth, neuron_dim, neuron_dim});
+    fill_random_uniform(som.get_data_pointer(), som.size(), 43);
+
+    MapperType neuron_major(som, 0, param.num_rot, param.flip, Interpolation::BILINEAR,
+        euclidean_distance_dim, param.shape, TransformationLayout::NEURON_MAJOR);
+    MapperType pixel_major(som, 0, param.num_rot, param.flip, Interpolation::BILINEAR,
+        euclidean_distance_dim, param.shape, TransformationLayout::PIXEL_MAJOR);
+
+    auto expected = neuron_major(image);
+    auto actual = pixel_major(image);
+
+    EXPECT_FLOATS_NEARLY_EQ(std::get<0>(expected), std::get<0>(actual), 1e-4);
+    EXPECT_EQ(std::get<1>(expected), std::get<1>(actual));
+}
+
+INSTANTIATE_TEST_SUITE_P(PixelMajorTest_all, PixelMajorTest,
+    ::testing::Values(
+        // depth, num_rot, flip, shape
+        PixelMajorTestData(1,  1, false, EuclideanDistanceShape::QUADRATIC),
+        PixelMajorTestData(1,  4, false, EuclideanDistanceShape::QUADRATIC),
+        PixelMajorTestData(1, 12,  true, EuclideanDistanceShape::QUADRATIC),
+        PixelMajorTestData(1, 36,  true, EuclideanDistanceShape::CIRCULAR),
+        PixelMajorTestData(3,  8, false, EuclideanDistanceShape::QUADRATIC),
+        PixelMajorTestData(3, 20,  true, EuclideanDistanceShape::CIRCULAR)
+));
+
+TEST(PixelMajorTest, interleave_spatial_transformed_images)
+{
+    // Three transformations of a 2x2 image, region covers all pixels
+    std::vector<int> images{{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12}};
+    std::vector<uint32_t> region{{0, 1, 2, 3}};
+    std::vector<int> interleaved;
+
+    interleave_spatial_transformed_images(interleaved, images, 3, 4, region);
+
+    constexpr uint32_t W = pixel_major_block_size;
+    ASSERT_EQ(4 * W, interleaved.size());
+    for (uint32_t p = 0; p < 4; ++p) {
+        for (uint32_t t = 0; t < 3; ++t) {
+            EXPECT_EQ(images[t * 4 + p], interleaved[p * W + t]);
+        }
+    }
+}
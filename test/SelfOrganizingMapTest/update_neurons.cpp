@@ -0,0 +1,52 @@
+/**
+ * @file   SelfOrganizingMapTest/update_neurons.cpp
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "SelfOrganizingMapLib/update_neurons.h"
+#include "UtilitiesLib/Filler.h"
+
+using namespace pink;
+
+TEST(SelfOrganizingMapTest, update_neurons_sparse)
+{
+    uint32_t som_size = 50;
+    uint32_t neuron_size = 1000;
+    uint32_t number_of_rotations = 4;
+
+    std::vector<float> som(som_size * neuron_size);
+    fill_random_uniform(som.data(), som.size(), 1);
+    std::vector<float> images(number_of_rotations * neuron_size);
+    fill_random_uniform(images.data(), images.size(), 2);
+
+    std::vector<uint32_t> best_rotation_matrix(som_size);
+    for (uint32_t i = 0; i < som_size; ++i) best_rotation_matrix[i] = i % number_of_rotations;
+
+    // Every third neuron will be updated
+    std::vector<float> dense_factors(som_size, 0.0f);
+    std::vector<uint32_t> indices;
+    std::vector<float> factors;
+    for (uint32_t i = 0; i < som_size; i += 3) {
+        dense_factors[i] = 0.5f / (i + 1);
+        indices.push_back(i);
+        factors.push_back(dense_factors[i]);
+    }
+
+    auto expected = som;
+    for (uint32_t i = 0; i < som_size; ++i) {
+        if (dense_factors[i] == 0.0f) continue;
+        for (uint32_t j = 0; j < neuron_size; ++j) {
+            float& n = expected[i * neuron_size + j];
+            n -= (n - images[best_rotation_matrix[i] * neuron_size + j]) * dense_factors[i];
+        }
+    }
+
+    update_neurons(som.data(), neuron_size, images.data(), best_rotation_matrix.data(),
+        indices.data(), factors.data(), static_cast<uint32_t>(indices.size()));
+
+    for (size_t i = 0; i < som.size(); ++i) EXPECT_FLOAT_EQ(expected[i], som[i]);
+}
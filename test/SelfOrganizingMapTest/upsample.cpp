@@ -0,0 +1,125 @@
+/**
+ * @file   SelfOrganizingMapTest/upsample.cpp
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "SelfOrganizingMapLib/CartesianLayout.h"
+#include "SelfOrganizingMapLib/FileIO.h"
+#include "SelfOrganizingMapLib/HexagonalLayout.h"
+#include "SelfOrganizingMapLib/read_neurons.h"
+#include "SelfOrganizingMapLib/SOM.h"
+#include "SelfOrganizingMapLib/upsample.h"
+
+using namespace pink;
+
+TEST(UpsampleTest, cartesian_identity)
+{
+    CartesianLayout<2> layout{{3, 4}};
+    std::vector<float> from(layout.size() * 2);
+    for (size_t i = 0; i < from.size(); ++i) from[i] = static_cast<float>(i * i);
+
+    std::vector<float> to(from.size());
+    upsample(layout, from.data(), layout, to.data(), 2);
+
+    EXPECT_EQ(from, to);
+}
+
+TEST(UpsampleTest, cartesian_linear_field)
+{
+    // A linear field in the SOM layout is reproduced exactly, the corner neurons are kept
+    CartesianLayout<2> from_layout{{3, 3}};
+    CartesianLayout<2> to_layout{{5, 5}};
+
+    std::vector<float> from(from_layout.size() * 2);
+    for (uint32_t i = 0; i < from_layout.size(); ++i) {
+        auto&& p = from_layout.get_position(i);
+        from[i * 2] = 2.0f * p[0] + 3.0f * p[1];
+        from[i * 2 + 1] = -1.0f;
+    }
+
+    std::vector<float> to(to_layout.size() * 2);
+    upsample(from_layout, from.data(), to_layout, to.data(), 2);
+
+    for (uint32_t i = 0; i < to_layout.size(); ++i) {
+        auto&& p = to_layout.get_position(i);
+        EXPECT_FLOAT_EQ(0.5f * (2.0f * p[0] + 3.0f * p[1]), to[i * 2]);
+        EXPECT_FLOAT_EQ(-1.0f, to[i * 2 + 1]);
+    }
+}
+
+TEST(UpsampleTest, cartesian_1d)
+{
+    CartesianLayout<1> from_layout{{2}};
+    CartesianLayout<1> to_layout{{5}};
+
+    std::vector<float> from{1.0f, 5.0f};
+    std::vector<float> to(5);
+    upsample(from_layout, from.data(), to_layout, to.data(), 1);
+
+    EXPECT_EQ((std::vector<float>{1.0f, 2.0f, 3.0f, 4.0f, 5.0f}), to);
+}
+
+TEST(UpsampleTest, hexagonal_identity)
+{
+    HexagonalLayout layout({5, 5});
+    std::vector<float> from(layout.size());
+    for (size_t i = 0; i < from.size(); ++i) from[i] = static_cast<float>(i);
+
+    std::vector<float> to(from.size());
+    upsample(layout, from.data(), layout, to.data(), 1);
+
+    EXPECT_EQ(from, to);
+}
+
+TEST(UpsampleTest, hexagonal_linear_field)
+{
+    HexagonalLayout from_layout({5, 5});
+    HexagonalLayout to_layout({9, 9});
+
+    // Linear field in axial coordinates relative to the center neuron
+    auto&& field = [](HexagonalLayout const& layout, uint32_t i) {
+        auto&& p = layout.get_position(i);
+        float q = static_cast<float>(p[0]) - layout.m_radius;
+        float r = static_cast<float>(p[1]) - layout.m_radius;
+        return (q + 2.0f * r) / layout.m_radius;
+    };
+
+    std::vector<float> from(from_layout.size());
+    for (uint32_t i = 0; i < from_layout.size(); ++i) from[i] = field(from_layout, i);
+
+    std::vector<float> to(to_layout.size());
+    upsample(from_layout, from.data(), to_layout, to.data(), 1);
+
+    for (uint32_t i = 0; i < to_layout.size(); ++i) EXPECT_NEAR(field(to_layout, i), to[i], 1e-6);
+}
+
+TEST(UpsampleTest, read_neurons)
+{
+    SOM<CartesianLayout<2>, CartesianLayout<2>, float> som({3, 3}, {2, 2});
+    for (size_t i = 0; i < som.size(); ++i) som.get_data_pointer()[i] = static_cast<float>(i);
+
+    std::string filename = "UpsampleTest_read_neurons.bin";
+    write(som, filename);
+
+    // Same layout
+    std::vector<float> data(som.size());
+    read_neurons(filename, som.get_som_layout(), 4, data.data(), 0, 9);
+    EXPECT_EQ(std::vector<float>(som.get_data().begin(), som.get_data().end()), data);
+
+    // Range of an upsampled layout
+    CartesianLayout<2> to_layout{{5, 5}};
+    std::vector<float> expected(to_layout.size() * 4);
+    upsample(som.get_som_layout(), som.get_data_pointer(), to_layout, expected.data(), 4);
+    std::vector<float> range(3 * 4);
+    read_neurons(filename, to_layout, 4, range.data(), 7, 10);
+    EXPECT_EQ(std::vector<float>(expected.begin() + 7 * 4, expected.begin() + 10 * 4), range);
+
+    EXPECT_THROW(read_neurons(filename, to_layout, 9, range.data(), 0, 1), pink::exception);
+    std::remove(filename.c_str());
+}
@@ -0,0 +1,54 @@
+/**
+ * @file   UtilitiesTest/DecayTypeTest.cpp
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#include <gtest/gtest.h>
+
+#include "UtilitiesLib/DecayType.h"
+
+using namespace pink;
+
+TEST(DecayTypeTest, off)
+{
+    EXPECT_FLOAT_EQ(2.0f, get_decayed_value(DecayType::OFF, 2.0f, 0.5f, 0, 5));
+    EXPECT_FLOAT_EQ(2.0f, get_decayed_value(DecayType::OFF, 2.0f, 0.5f, 4, 5));
+}
+
+TEST(DecayTypeTest, linear)
+{
+    EXPECT_FLOAT_EQ(2.0f, get_decayed_value(DecayType::LINEAR, 2.0f, 0.0f, 0, 5));
+    EXPECT_FLOAT_EQ(1.0f, get_decayed_value(DecayType::LINEAR, 2.0f, 0.0f, 2, 5));
+    EXPECT_FLOAT_EQ(0.0f, get_decayed_value(DecayType::LINEAR, 2.0f, 0.0f, 4, 5));
+}
+
+TEST(DecayTypeTest, exponential)
+{
+    EXPECT_FLOAT_EQ(4.0f, get_decayed_value(DecayType::EXPONENTIAL, 4.0f, 0.25f, 0, 5));
+    EXPECT_FLOAT_EQ(1.0f, get_decayed_value(DecayType::EXPONENTIAL, 4.0f, 0.25f, 2, 5));
+    EXPECT_FLOAT_EQ(0.25f, get_decayed_value(DecayType::EXPONENTIAL, 4.0f, 0.25f, 4, 5));
+
+    // Falls back to linear if the final value is zero
+    EXPECT_FLOAT_EQ(2.0f, get_decayed_value(DecayType::EXPONENTIAL, 4.0f, 0.0f, 2, 5));
+}
+
+TEST(DecayTypeTest, single_iteration)
+{
+    EXPECT_FLOAT_EQ(4.0f, get_decayed_value(DecayType::LINEAR, 4.0f, 0.25f, 0, 1));
+}
+
+TEST(DecayTypeTest, max_update_distance)
+{
+    // Without final value the limit of the user is kept, also if there is none
+    EXPECT_FLOAT_EQ(3.0f, get_decayed_max_update_distance(DecayType::LINEAR, 3.0f, 0.0f, 10.0f, 0, 5));
+    EXPECT_FLOAT_EQ(3.0f, get_decayed_max_update_distance(DecayType::LINEAR, 3.0f, 0.0f, 10.0f, 4, 5));
+    EXPECT_FLOAT_EQ(-1.0f, get_decayed_max_update_distance(DecayType::LINEAR, -1.0f, 0.0f, 10.0f, 2, 5));
+
+    // Decay from the initial limit
+    EXPECT_FLOAT_EQ(2.0f, get_decayed_max_update_distance(DecayType::LINEAR, 3.0f, 1.0f, 10.0f, 2, 5));
+
+    // Decay from beyond the whole SOM without initial limit
+    EXPECT_FLOAT_EQ(11.0f, get_decayed_max_update_distance(DecayType::LINEAR, -1.0f, 1.0f, 10.0f, 0, 5));
+    EXPECT_FLOAT_EQ(1.0f, get_decayed_max_update_distance(DecayType::LINEAR, -1.0f, 1.0f, 10.0f, 4, 5));
+}
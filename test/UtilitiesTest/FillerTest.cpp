@@ -0,0 +1,88 @@
+/**
+ * @file   UtilitiesTest/FillerTest.cpp
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <omp.h>
+#include <vector>
+
+#include "UtilitiesLib/DefaultInitAllocator.h"
+#include "UtilitiesLib/Filler.h"
+
+using namespace pink;
+
+TEST(FillerTest, random_uniform_parallel)
+{
+    size_t size = 10000;
+    int max_threads = omp_get_max_threads();
+
+    std::vector<float> a(size);
+    omp_set_num_threads(1);
+    fill_random_uniform_parallel(a.data(), size, 42);
+
+    std::vector<float> b(size);
+    omp_set_num_threads(4);
+    fill_random_uniform_parallel(b.data(), size, 42);
+    omp_set_num_threads(max_threads);
+
+    // Independent of the number of threads
+    EXPECT_EQ(a, b);
+
+    // A part is filled like the whole array
+    std::vector<float> c(size / 2);
+    fill_random_uniform_parallel(c.data(), c.size(), 42, 1234);
+    EXPECT_TRUE(std::equal(c.begin(), c.end(), a.begin() + 1234));
+
+    // Values in [0, 1) with mean 0.5
+    double sum = 0.0;
+    for (auto e : a) {
+        EXPECT_LE(0.0f, e);
+        EXPECT_GT(1.0f, e);
+        sum += e;
+    }
+    EXPECT_NEAR(0.5, sum / size, 0.01);
+
+    // Other seed, other numbers
+    fill_random_uniform_parallel(b.data(), size, 43);
+    EXPECT_NE(a, b);
+}
+
+TEST(FillerTest, random_uniform_parallel_integral)
+{
+    size_t size = 10000;
+
+    std::vector<uint8_t> a(size);
+    fill_random_uniform_parallel(a.data(), size, 42);
+
+    // A part is filled like the whole array
+    std::vector<uint8_t> b(size / 2);
+    fill_random_uniform_parallel(b.data(), b.size(), 42, 1234);
+    EXPECT_TRUE(std::equal(b.begin(), b.end(), a.begin() + 1234));
+
+    // Full range of the type with mean 127.5
+    double sum = 0.0;
+    for (auto e : a) sum += e;
+    EXPECT_NEAR(127.5, sum / size, 2.0);
+    EXPECT_EQ(0, *std::min_element(a.begin(), a.end()));
+    EXPECT_EQ(255, *std::max_element(a.begin(), a.end()));
+
+    // Signed types are not negative
+    std::vector<int32_t> c(size);
+    fill_random_uniform_parallel(c.data(), size, 42);
+    EXPECT_LE(0, *std::min_element(c.begin(), c.end()));
+}
+
+TEST(FillerTest, value_parallel)
+{
+    std::vector<double, DefaultInitAllocator<double>> a(1000);
+    fill_value_parallel(a.data(), a.size(), 2.5);
+    for (auto e : a) EXPECT_EQ(2.5, e);
+
+    // Construction by value is not changed by the allocator
+    std::vector<double, DefaultInitAllocator<double>> b(1000, 2.5);
+    EXPECT_EQ(a, b);
+}
@@ -0,0 +1,52 @@
+/**
+ * @file   UtilitiesTest/SweepVariantTest.cpp
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#include <gtest/gtest.h>
+#include <sstream>
+
+#include "UtilitiesLib/pink_exception.h"
+#include "UtilitiesLib/SweepVariant.h"
+
+using namespace pink;
+
+TEST(SweepVariantTest, parse)
+{
+    auto&& variants = parse_sweep_variants("sigma=1.5,damping=0.1;som-width=20,som-height=30,seed=7;sigma=2");
+    ASSERT_EQ(3UL, variants.size());
+
+    EXPECT_FLOAT_EQ(1.5f, variants[0].m_sigma.value());
+    EXPECT_FLOAT_EQ(0.1f, variants[0].m_damping.value());
+    EXPECT_FALSE(variants[0].m_som_width);
+
+    EXPECT_FALSE(variants[1].m_sigma);
+    EXPECT_EQ(20U, variants[1].m_som_width.value());
+    EXPECT_EQ(30U, variants[1].m_som_height.value());
+    EXPECT_EQ(7U, variants[1].m_seed.value());
+    EXPECT_FALSE(variants[1].m_som_depth);
+
+    EXPECT_FLOAT_EQ(2.0f, variants[2].m_sigma.value());
+
+    std::stringstream ss;
+    ss << variants[1];
+    EXPECT_EQ("seed=7,som-width=20,som-height=30", ss.str());
+}
+
+TEST(SweepVariantTest, invalid)
+{
+    EXPECT_THROW(parse_sweep_variants(""), pink::exception);
+    EXPECT_THROW(parse_sweep_variants("sigma"), pink::exception);
+    EXPECT_THROW(parse_sweep_variants("sigma=a"), pink::exception);
+    EXPECT_THROW(parse_sweep_variants("sigma=1.0x"), pink::exception);
+    EXPECT_THROW(parse_sweep_variants("som-width=0"), pink::exception);
+    EXPECT_THROW(parse_sweep_variants("seed=-1"), pink::exception);
+    EXPECT_THROW(parse_sweep_variants("radius=2"), pink::exception);
+}
+
+TEST(SweepVariantTest, filename)
+{
+    EXPECT_EQ("som_sweep_0.bin", get_sweep_filename("som.bin", 0));
+    EXPECT_EQ("dir.d/som_sweep_3", get_sweep_filename("dir.d/som", 3));
+}
@@ -0,0 +1,46 @@
+/**
+ * @file   UtilitiesTest/TrainingStageTest.cpp
+ * @date   Oct 16, 2026
+ * @author Bernd Doser, HITS gGmbH
+ */
+
+#include <gtest/gtest.h>
+
+#include "UtilitiesLib/pink_exception.h"
+#include "UtilitiesLib/TrainingStage.h"
+
+using namespace pink;
+
+TEST(TrainingStageTest, parse)
+{
+    auto&& stages = parse_training_stages("5x5:2,9x7x3:4,12:1");
+    ASSERT_EQ(3UL, stages.size());
+
+    EXPECT_EQ(5U, stages[0].m_som_width);
+    EXPECT_EQ(5U, stages[0].m_som_height);
+    EXPECT_EQ(1U, stages[0].m_som_depth);
+    EXPECT_EQ(2U, stages[0].m_number_of_iterations);
+
+    EXPECT_EQ(9U, stages[1].m_som_width);
+    EXPECT_EQ(7U, stages[1].m_som_height);
+    EXPECT_EQ(3U, stages[1].m_som_depth);
+    EXPECT_EQ(4U, stages[1].m_number_of_iterations);
+
+    EXPECT_EQ(12U, stages[2].m_som_width);
+    EXPECT_EQ(1U, stages[2].m_som_height);
+}
+
+TEST(TrainingStageTest, invalid)
+{
+    EXPECT_THROW(parse_training_stages(""), pink::exception);
+    EXPECT_THROW(parse_training_stages("5x5"), pink::exception);
+    EXPECT_THROW(parse_training_stages("5x5:0"), pink::exception);
+    EXPECT_THROW(parse_training_stages("5xa:2"), pink::exception);
+    EXPECT_THROW(parse_training_stages("5x5x5x5:2"), pink::exception);
+}
+
+TEST(TrainingStageTest, filename)
+{
+    EXPECT_EQ("som_stage_0.bin", get_stage_filename("som.bin", 0));
+    EXPECT_EQ("dir.d/som_stage_2", get_stage_filename("dir.d/som", 2));
+}